@@ -2,6 +2,7 @@
 #define SCUNIT_ASSERT_H
 
 #include <stdlib.h>
+#include <SCUnit/backtrace.h>
 #include <SCUnit/context.h>
 #include <SCUnit/error.h>
 
@@ -48,6 +49,20 @@
                 exit(EXIT_FAILURE);                                                               \
             }                                                                                     \
         )                                                                                         \
+        if ((result) == SCUNIT_RESULT_FAIL) {                                                     \
+            scunit_error = scunit_backtrace_append(scunit_context);                               \
+            if (scunit_error != SCUNIT_ERROR_NONE) {                                              \
+                scunit_fprintfc(                                                                  \
+                    stderr,                                                                       \
+                    SCUNIT_COLOR_DARK_RED,                                                        \
+                    SCUNIT_COLOR_DARK_DEFAULT,                                                    \
+                    "An unexpected error occurred while appending the backtrace to the test "     \
+                        "context (code %d).\n",                                                   \
+                    scunit_error                                                                  \
+                );                                                                                \
+                exit(EXIT_FAILURE);                                                               \
+            }                                                                                     \
+        }                                                                                         \
         scunit_error = scunit_context_setResult(scunit_context, result);                          \
         if (scunit_error != SCUNIT_ERROR_NONE) {                                                  \
             scunit_fprintfc(                                                                      \
@@ -184,6 +199,18 @@
                     exit(EXIT_FAILURE);                                                           \
                 }                                                                                 \
             )                                                                                     \
+            scunit_error = scunit_backtrace_append(scunit_context);                               \
+            if (scunit_error != SCUNIT_ERROR_NONE) {                                              \
+                scunit_fprintfc(                                                                  \
+                    stderr,                                                                       \
+                    SCUNIT_COLOR_DARK_RED,                                                        \
+                    SCUNIT_COLOR_DARK_DEFAULT,                                                    \
+                    "An unexpected error occurred while appending the backtrace to the test "     \
+                        "context (code %d).\n",                                                   \
+                    scunit_error                                                                  \
+                );                                                                                \
+                exit(EXIT_FAILURE);                                                               \
+            }                                                                                     \
             scunit_context_setResult(scunit_context, SCUNIT_RESULT_FAIL);                         \
             return;                                                                               \
         }                                                                                         \
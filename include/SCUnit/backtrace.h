@@ -0,0 +1,48 @@
+#ifndef SCUNIT_BACKTRACE_H
+#define SCUNIT_BACKTRACE_H
+
+#include <stdint.h>
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+
+/**
+ * @brief Captures a backtrace of the caller and appends it to a given `SCUnitContext`.
+ *
+ * @note This function is called automatically by failing assertions (see `<SCUnit/assert.h>`), so
+ * that the call path through helper functions leading to the failure is visible. The backtrace is
+ * trimmed at the frame executing the test. If the failure occurred directly in the test function,
+ * nothing is appended, since the file context of the assertion already shows where it failed.
+ *
+ * Frames are symbolized lazily using the symbol table and the line table (`.debug_line`) of the
+ * module they belong to. Both tables are parsed on first use and cached for the lifetime of the
+ * process, so that repeated failures do not parse them again. Line information is only available
+ * if the module is built with debug information (e. g. using `-g`) that is neither compressed nor
+ * split into a separate file. Otherwise, frames are shown as a symbol and an offset.
+ *
+ * @param[in, out] context `SCUnitContext` to append the backtrace to.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_backtrace_append(SCUnitContext* context);
+
+/**
+ * @brief Symbolizes a given backtrace and appends one line for each of its frames to a given
+ * `SCUnitContext`.
+ *
+ * @note The backtrace is trimmed at the frame executing the test and consecutive frames with the
+ * same address (e. g. of a runaway recursion) are collapsed into a single one. The frames are
+ * expected to be return addresses as obtained from `backtrace()`.
+ *
+ * @param[in, out] context    `SCUnitContext` to append the frames to.
+ * @param[in]      frames     Frames of the backtrace, starting with the innermost one.
+ * @param[in]      frameCount Number of frames of the backtrace.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_backtrace_appendFrames(
+    SCUnitContext* context,
+    void* const* frames,
+    int32_t frameCount
+);
+
+#endif
\ No newline at end of file
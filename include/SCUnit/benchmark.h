@@ -0,0 +1,507 @@
+#ifndef SCUNIT_BENCHMARK_H
+#define SCUNIT_BENCHMARK_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+#include <SCUnit/print.h>
+#include <SCUnit/suite.h>
+
+/** @brief Represents the state of a benchmark, passed to its body. */
+typedef struct SCUnitBenchmark SCUnitBenchmark;
+
+/** @brief Represents an enumeration of the complexity classes a benchmark can be fitted to. */
+typedef enum SCUnitComplexity {
+
+    /** @brief Indicates a constant complexity, O(1). */
+    SCUNIT_COMPLEXITY_CONSTANT,
+
+    /** @brief Indicates a logarithmic complexity, O(log n). */
+    SCUNIT_COMPLEXITY_LOGARITHMIC,
+
+    /** @brief Indicates a linear complexity, O(n). */
+    SCUNIT_COMPLEXITY_LINEAR,
+
+    /** @brief Indicates a linearithmic complexity, O(n log n). */
+    SCUNIT_COMPLEXITY_LINEARITHMIC,
+
+    /** @brief Indicates a quadratic complexity, O(n^2). */
+    SCUNIT_COMPLEXITY_QUADRATIC
+
+} SCUnitComplexity;
+
+/** @brief Represents an enumeration of the states of the caches a benchmark is executed with. */
+typedef enum SCUnitCacheState {
+
+    /** @brief Indicates that the caches are left alone, so they are warm after one iteration. */
+    SCUNIT_CACHE_STATE_WARM,
+
+    /** @brief Indicates that the data caches are evicted before every iteration. */
+    SCUNIT_CACHE_STATE_COLD,
+
+    /**
+     * @brief Indicates that the entries of the TLB (translation lookaside buffer) are evicted
+     * before every iteration.
+     */
+    SCUNIT_CACHE_STATE_COLD_TLB
+
+} SCUnitCacheState;
+
+/** @brief Represents an enumeration of the formats the results of benchmarks can be reported in. */
+typedef enum SCUnitBenchmarkFormat {
+
+    /** @brief Indicates that results are only reported as part of the messages of benchmarks. */
+    SCUNIT_BENCHMARK_FORMAT_TEXT,
+
+    /**
+     * @brief Indicates that results are additionally reported as a single JSON document in the
+     * format of Google Benchmark (`--benchmark_format=json`).
+     */
+    SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON
+
+} SCUnitBenchmarkFormat;
+
+/** @brief Represents the options of a benchmark. */
+typedef struct SCUnitBenchmarkOptions {
+
+    /** @brief First input size the benchmark is executed for. */
+    int64_t firstSize;
+
+    /**
+     * @brief Last input size the benchmark is executed for.
+     *
+     * @note If it is greater than `firstSize`, the benchmark is executed for `firstSize` multiplied
+     * by `multiplier` repeatedly, followed by `lastSize` itself.
+     */
+    int64_t lastSize;
+
+    /** @brief Factor between two consecutive input sizes (at least two if sizes are swept). */
+    int64_t multiplier;
+
+    /** @brief Whether the benchmark fails if its fitted complexity exceeds `expectedComplexity`. */
+    bool isComplexityChecked;
+
+    /** @brief Worst complexity the benchmark may be fitted to if `isComplexityChecked` is set. */
+    SCUnitComplexity expectedComplexity;
+
+    /**
+     * @brief First number of threads the benchmark is executed on or zero if the benchmark is
+     * executed on the calling thread only.
+     */
+    int64_t firstThreads;
+
+    /**
+     * @brief Last number of threads the benchmark is executed on.
+     *
+     * @note If it is greater than `firstThreads`, the benchmark is executed for `firstThreads`
+     * doubled repeatedly, followed by `lastThreads` itself. Numbers of threads above the number of
+     * CPUs available to the process are skipped, since the threads could not run simultaneously.
+     */
+    int64_t lastThreads;
+
+    /**
+     * @brief Greatest serial fraction (between zero and one) the benchmark may be fitted to by
+     * Amdahl's law or zero if the serial fraction is not checked.
+     */
+    double maxSerialFraction;
+
+    /**
+     * @brief Rate the operations of the benchmark are started at (per second) or zero if the
+     * benchmark is not executed at a target rate.
+     */
+    double targetRate;
+
+    /** @brief State of the caches every iteration of the timed loop starts with. */
+    SCUnitCacheState cacheState;
+
+} SCUnitBenchmarkOptions;
+
+/**
+ * @brief Represents the body of a benchmark.
+ *
+ * @param[in, out] scunit_context   `SCUnitContext` storing important information about the test.
+ * @param[in, out] scunit_benchmark `SCUnitBenchmark` storing the state of the benchmark.
+ */
+typedef void (*SCUnitBenchmarkFunction)(
+    [[maybe_unused]] SCUnitContext* scunit_context,
+    [[maybe_unused]] SCUnitBenchmark* scunit_benchmark
+);
+
+/**
+ * @brief Defines and registers a benchmark with given options to be executed as part of an
+ * `SCUnitSuite` with a given name.
+ *
+ * @note This macro is intended to be used at file scope and after defining an `SCUnitSuite` with
+ * `SCUNIT_SUITE()` or `SCUNIT_PARTIAL_SUITE()`. The benchmark is registered as a regular test, so
+ * it is selected, executed and reported like any other test.
+ *
+ * The body of the benchmark is executed repeatedly and must contain exactly one timed loop
+ * (`while (scunit_benchmark_keepRunning(scunit_benchmark)) { ... }`). Code before and after the
+ * loop is not measured. See `scunit_benchmark_execute()` for more information.
+ *
+ * @attention If an unexpected error occurs while defining, registering or executing the benchmark,
+ * an error message is written to `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] suite Name of the `SCUnitSuite` to define and register the benchmark for.
+ * @param[in] name  Name of the benchmark itself.
+ * @param[in] ...   Designated initializers for the members of an `SCUnitBenchmarkOptions`.
+ */
+#define SCUNIT_BENCHMARK_OPTIONS(suite, name, ...)                                              \
+    static void scunit_suite##suite##Benchmark##name(                                           \
+        [[maybe_unused]] SCUnitContext* scunit_context,                                         \
+        [[maybe_unused]] SCUnitBenchmark* scunit_benchmark                                      \
+    );                                                                                          \
+    SCUNIT_TEST(suite, name) {                                                                  \
+        SCUnitError scunit_error = scunit_benchmark_execute(                                    \
+            scunit_context,                                                                     \
+            #suite "." #name,                                                                   \
+            &(SCUnitBenchmarkOptions) { __VA_ARGS__ },                                          \
+            scunit_suite##suite##Benchmark##name                                                \
+        );                                                                                      \
+        if (scunit_error != SCUNIT_ERROR_NONE) {                                                \
+            scunit_fprintfc(                                                                    \
+                stderr,                                                                         \
+                SCUNIT_COLOR_DARK_RED,                                                          \
+                SCUNIT_COLOR_DARK_DEFAULT,                                                      \
+                "An unexpected error occurred while executing the benchmark %s (code %d).\n",   \
+                #name,                                                                          \
+                scunit_error                                                                    \
+            );                                                                                  \
+            exit(EXIT_FAILURE);                                                                 \
+        }                                                                                       \
+    }                                                                                           \
+    static void scunit_suite##suite##Benchmark##name(                                           \
+        [[maybe_unused]] SCUnitContext* scunit_context,                                         \
+        [[maybe_unused]] SCUnitBenchmark* scunit_benchmark                                      \
+    )
+
+/**
+ * @brief Defines and registers a benchmark to be executed as part of an `SCUnitSuite` with a given
+ * name.
+ *
+ * @note See `SCUNIT_BENCHMARK_OPTIONS()` for more information. The input size of the benchmark is
+ * zero.
+ *
+ * @param[in] suite Name of the `SCUnitSuite` to define and register the benchmark for.
+ * @param[in] name  Name of the benchmark itself.
+ */
+#define SCUNIT_BENCHMARK(suite, name) SCUNIT_BENCHMARK_OPTIONS(suite, name, .multiplier = 1)
+
+/**
+ * @brief Defines and registers a benchmark that is executed for a range of input sizes and fitted
+ * to a complexity class.
+ *
+ * @note See `SCUNIT_BENCHMARK_OPTIONS()` for more information. The body of the benchmark gets the
+ * current input size by calling `scunit_benchmark_getSize()`.
+ *
+ * @param[in] suite  Name of the `SCUnitSuite` to define and register the benchmark for.
+ * @param[in] name   Name of the benchmark itself.
+ * @param[in] first  First input size.
+ * @param[in] last   Last input size.
+ * @param[in] factor Factor between two consecutive input sizes.
+ */
+#define SCUNIT_BENCHMARK_RANGE(suite, name, first, last, factor) \
+    SCUNIT_BENCHMARK_OPTIONS(                                    \
+        suite,                                                   \
+        name,                                                    \
+        .firstSize = (first),                                    \
+        .lastSize = (last),                                      \
+        .multiplier = (factor)                                   \
+    )
+
+/**
+ * @brief Defines and registers a benchmark like `SCUNIT_BENCHMARK_RANGE()`, which fails if its
+ * fitted complexity class is worse than an expected one.
+ *
+ * @note Use this to catch complexity regressions, e. g. a container degrading from O(n log n) to
+ * O(n^2). A benchmark fitted to a better complexity class than expected still passes.
+ *
+ * @param[in] suite      Name of the `SCUnitSuite` to define and register the benchmark for.
+ * @param[in] name       Name of the benchmark itself.
+ * @param[in] first      First input size.
+ * @param[in] last       Last input size.
+ * @param[in] factor     Factor between two consecutive input sizes.
+ * @param[in] complexity Worst `SCUnitComplexity` the benchmark may be fitted to.
+ */
+#define SCUNIT_BENCHMARK_COMPLEXITY(suite, name, first, last, factor, complexity) \
+    SCUNIT_BENCHMARK_OPTIONS(                                                     \
+        suite,                                                                    \
+        name,                                                                     \
+        .firstSize = (first),                                                     \
+        .lastSize = (last),                                                       \
+        .multiplier = (factor),                                                   \
+        .isComplexityChecked = true,                                              \
+        .expectedComplexity = (complexity)                                        \
+    )
+
+/**
+ * @brief Defines and registers a benchmark that is executed on a range of numbers of threads.
+ *
+ * @note See `SCUNIT_BENCHMARK_OPTIONS()` for more information. The body of the benchmark is
+ * executed on every thread simultaneously, so it must only share state with other threads that is
+ * meant to be contended. It gets the index of its thread by calling
+ * `scunit_benchmark_getThreadIndex()`.
+ *
+ * @param[in] suite Name of the `SCUnitSuite` to define and register the benchmark for.
+ * @param[in] name  Name of the benchmark itself.
+ * @param[in] first First number of threads.
+ * @param[in] last  Last number of threads.
+ */
+#define SCUNIT_BENCHMARK_THREADS(suite, name, first, last) \
+    SCUNIT_BENCHMARK_OPTIONS(                              \
+        suite,                                             \
+        name,                                              \
+        .multiplier = 1,                                   \
+        .firstThreads = (first),                           \
+        .lastThreads = (last)                              \
+    )
+
+/**
+ * @brief Defines and registers a benchmark that measures the latency of operations started at a
+ * target rate.
+ *
+ * @note See `SCUNIT_BENCHMARK_OPTIONS()` for more information. Every iteration of the timed loop
+ * is a single operation, which is started at its intended time on a fixed schedule (open loop)
+ * rather than as soon as the previous one finished.
+ *
+ * @param[in] suite Name of the `SCUnitSuite` to define and register the benchmark for.
+ * @param[in] name  Name of the benchmark itself.
+ * @param[in] rate  Number of operations started per second.
+ */
+#define SCUNIT_BENCHMARK_LATENCY(suite, name, rate)                              \
+    SCUNIT_BENCHMARK_OPTIONS(suite, name, .multiplier = 1, .targetRate = (rate))
+
+/**
+ * @brief Defines and registers a benchmark that is executed with a given state of the caches.
+ *
+ * @note See `SCUNIT_BENCHMARK_OPTIONS()` for more information. Defining the same body once with
+ * `SCUNIT_CACHE_STATE_WARM` and once with `SCUNIT_CACHE_STATE_COLD` measures both regimes in a
+ * single run.
+ *
+ * @param[in] suite Name of the `SCUnitSuite` to define and register the benchmark for.
+ * @param[in] name  Name of the benchmark itself.
+ * @param[in] state `SCUnitCacheState` every iteration starts with.
+ */
+#define SCUNIT_BENCHMARK_CACHE(suite, name, state)                               \
+    SCUNIT_BENCHMARK_OPTIONS(suite, name, .multiplier = 1, .cacheState = (state))
+
+/**
+ * @brief Executes a benchmark with given options and reports its results to a given
+ * `SCUnitContext`.
+ *
+ * @note This function is intended for internal use by `SCUNIT_BENCHMARK_OPTIONS()`. For every
+ * input size, the body is executed with an increasing number of iterations until the timed loop
+ * runs for at least the minimum time set by calling `scunit_setBenchmarkMinTime()`. The wall and
+ * CPU time per iteration are then reported for every input size.
+ *
+ * If more than one input size is measured, the times are fitted to each `SCUnitComplexity` by
+ * least squares (`t(n) = c * f(n)`), and the class with the lowest root mean square error
+ * (relative to the mean time) is reported as the best fit.
+ *
+ * If numbers of threads are given, the input size is not swept. Instead, for every number of
+ * threads, the body is executed on that many threads, each pinned to a different CPU. Their timed
+ * loops are released simultaneously by a spin barrier, and the aggregate throughput, the latency
+ * per iteration of a single thread, the speedup and the parallel efficiency (relative to the first
+ * number of threads) are reported. The speedups are fitted to Amdahl's law
+ * (`S(T) = 1 / (s + (1 - s) / T)`) by least squares to estimate the serial fraction `s`.
+ *
+ * If a target rate is given, the body is executed once, with as many operations as the target rate
+ * allows for within the minimum time. Every operation waits for its intended start time, and its
+ * latency is measured from that time rather than from its actual start, so that a stalling
+ * operation also shows up in the latencies of the operations delayed by it (correcting coordinated
+ * omission). The latencies are recorded in a histogram with a precision of three significant
+ * digits, and the 50th, 90th, 99th and 99.9th percentile and the greatest latency are reported
+ * along with the rate actually achieved.
+ *
+ * If a cold `SCUnitCacheState` is given, timing is paused before every iteration to evict the
+ * caches, either by streaming over a buffer twice the size of the largest cache (as read from
+ * `/sys/devices/system/cpu/cpu0/cache`) or by touching one byte each of many pages. The time an
+ * empty timed loop takes with the same eviction is measured up front and subtracted from the
+ * results, so that only the body itself is reported.
+ *
+ * If two libraries are compared by calling `scunit_setBenchmarkLibraries()`, the number of
+ * iterations is calibrated with the first library for every input size, so that a single sample
+ * runs for a twentieth of the minimum time. A hundred pairs of samples, one with each library in a
+ * random order, are then measured alternately, so that drift of the machine (e. g. thermal
+ * throttling or other load) cancels out within each pair. The mean paired difference is reported
+ * relative to the first library with its 95 % confidence interval (Student's t-distribution).
+ * Comparisons are not supported on multiple threads or at a target rate, and such benchmarks are
+ * skipped. Compared results are not recorded for `scunit_benchmark_writeReport()`.
+ *
+ * If the body fails or is skipped (e. g. due to a failed assertion), the benchmark is stopped and
+ * no results are reported. On multiple threads, every thread has an `SCUnitContext` of its own,
+ * and the worst result of any thread is reported along with its message.
+ *
+ * If the benchmark format set by calling `scunit_setBenchmarkFormat()` is
+ * `SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON`, the results are also recorded under the given name for
+ * `scunit_benchmark_writeReport()`.
+ *
+ * @param[in, out] context  `SCUnitContext` of the benchmark.
+ * @param[in]      name     Name the results are recorded under (`<suite>.<benchmark>`).
+ * @param[in]      options  Options of the benchmark.
+ * @param[in]      function Body of the benchmark.
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if the options are invalid,
+ *         `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_CREATING_THREAD_FAILED` if creating a thread failed,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the benchmark failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+SCUnitError scunit_benchmark_execute(
+    SCUnitContext* context,
+    const char* name,
+    const SCUnitBenchmarkOptions* options,
+    SCUnitBenchmarkFunction function
+);
+
+/**
+ * @brief Calls the body of a benchmark.
+ *
+ * @note This function is intended for internal use by `scunit_benchmark_execute()`, which calls
+ * the body once per measurement (and once per thread). Like `scunit_suite_callTest()`, it marks
+ * the frame at which backtraces of failures are trimmed.
+ *
+ * @param[in]      function  Body of the benchmark.
+ * @param[in, out] context   `SCUnitContext` to pass to the body.
+ * @param[in, out] benchmark `SCUnitBenchmark` to pass to the body.
+ */
+void scunit_benchmark_callBody(
+    SCUnitBenchmarkFunction function,
+    SCUnitContext* context,
+    SCUnitBenchmark* benchmark
+);
+
+/**
+ * @brief Writes the results of all benchmarks recorded so far to a given stream as a single JSON
+ * document in the format of Google Benchmark.
+ *
+ * @note This function is intended for internal use by `scunit_executeSuites()`. The document
+ * consists of a `context` object describing the host (the date, host name, executable, number of
+ * CPUs, their frequency and caches and the load average) and a `benchmarks` array with one run per
+ * input size or number of threads (named `<name>/<size>` and `<name>/threads:<count>`), so that
+ * tools written for Google Benchmark (e. g. `compare.py`) can consume it. Times are reported in
+ * nanoseconds per iteration. Fitted complexities are reported as `<name>_BigO` and `<name>_RMS`
+ * aggregates, and latency percentiles as the counters `p50`, `p90`, `p99`, `p99.9` and `max`.
+ *
+ * The recorded results are discarded afterwards.
+ *
+ * @param[in, out] stream Stream to write the document to.
+ * @return `SCUNIT_ERROR_WRITING_STREAM_FAILED` if writing to the stream failed, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_benchmark_writeReport(FILE* stream);
+
+/**
+ * @brief Determines whether the timed loop of a benchmark should run another iteration.
+ *
+ * @note The first call starts measuring and the call ending the loop stops measuring, so only the
+ * loop itself is timed. The overhead of a single call is a decrement and a comparison. On multiple
+ * threads, the first call also waits for all other threads to reach their timed loop.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` of the benchmark.
+ * @return `true` if another iteration should run, otherwise `false`.
+ */
+bool scunit_benchmark_keepRunning(SCUnitBenchmark* benchmark);
+
+/**
+ * @brief Determines the size of the next batch of iterations of the timed loop of a benchmark.
+ *
+ * @note This is an alternative to `scunit_benchmark_keepRunning()` for bodies that need fresh
+ * input for every iteration, which is prepared for a whole batch of iterations up front:
+ *
+ * ```c
+ * int64_t batch;
+ * while ((batch = scunit_benchmark_nextBatch(scunit_benchmark, 64)) > 0) {
+ *     shuffleArrays(arrays, batch);
+ *     scunit_benchmark_resumeTiming(scunit_benchmark);
+ *     for (int64_t i = 0; i < batch; i++) {
+ *         sortArray(arrays[i]);
+ *     }
+ *     scunit_benchmark_pauseTiming(scunit_benchmark);
+ * }
+ * ```
+ *
+ * Timing is paused whenever a batch begins, so only the code between resuming and pausing is
+ * timed. Since timing is paused once per batch instead of once per iteration, the overhead of
+ * pausing is spread over the whole batch, and the remaining overhead is calibrated out.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` of the benchmark.
+ * @param[in]      batchSize Greatest number of iterations of a batch.
+ * @return The number of iterations of the next batch (at most `batchSize`) or zero if the timed
+ *         loop is finished.
+ */
+int64_t scunit_benchmark_nextBatch(SCUnitBenchmark* benchmark, int64_t batchSize);
+
+/**
+ * @brief Pauses timing the timed loop of a benchmark, e. g. to prepare the input of the next
+ * iteration.
+ *
+ * @note Pausing and resuming read a tick counter instead of a clock (the time stamp counter on
+ * x86-64 and the virtual counter on AArch64), so neither enters the kernel. The time spent paused
+ * and the calibrated overhead of pausing are subtracted from the wall and the CPU time, assuming
+ * that the paused code runs on the CPU. Pausing outside of the timed loop or while already paused
+ * has no effect.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` of the benchmark.
+ */
+void scunit_benchmark_pauseTiming(SCUnitBenchmark* benchmark);
+
+/**
+ * @brief Resumes timing the timed loop of a benchmark after pausing it using
+ * `scunit_benchmark_pauseTiming()`.
+ *
+ * @note Resuming while not paused has no effect.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` of the benchmark.
+ */
+void scunit_benchmark_resumeTiming(SCUnitBenchmark* benchmark);
+
+/**
+ * @brief Gets the input size a benchmark is currently executed for.
+ *
+ * @param[in] benchmark `SCUnitBenchmark` of the benchmark.
+ * @return The current input size.
+ */
+int64_t scunit_benchmark_getSize(const SCUnitBenchmark* benchmark);
+
+/**
+ * @brief Gets the number of iterations the timed loop of a benchmark currently runs.
+ *
+ * @param[in] benchmark `SCUnitBenchmark` of the benchmark.
+ * @return The number of iterations of the timed loop.
+ */
+int64_t scunit_benchmark_getIterations(const SCUnitBenchmark* benchmark);
+
+/**
+ * @brief Gets the index of the thread a benchmark is currently executed on.
+ *
+ * @param[in] benchmark `SCUnitBenchmark` of the benchmark.
+ * @return The index of the thread (starting at zero) or zero if the benchmark is executed on the
+ *         calling thread only.
+ */
+int64_t scunit_benchmark_getThreadIndex(const SCUnitBenchmark* benchmark);
+
+/**
+ * @brief Gets the number of threads a benchmark is currently executed on.
+ *
+ * @param[in] benchmark `SCUnitBenchmark` of the benchmark.
+ * @return The number of threads.
+ */
+int64_t scunit_benchmark_getThreadCount(const SCUnitBenchmark* benchmark);
+
+/**
+ * @brief Resolves a symbol of the library under test for a benchmark.
+ *
+ * @note If two libraries are compared (see `scunit_setBenchmarkLibraries()`), the symbol is
+ * resolved from the library the body is currently executed with, otherwise from the global scope
+ * of the process (i. e. a library the benchmark is linked against). Symbols should be resolved
+ * before the timed loop, since resolving is not free.
+ *
+ * @param[in] benchmark `SCUnitBenchmark` of the benchmark.
+ * @param[in] name      A null-terminated string for the name of the symbol.
+ * @return The address of the symbol or a `nullptr` if it could not be resolved.
+ */
+void* scunit_benchmark_getSymbol(const SCUnitBenchmark* benchmark, const char* name);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef SCUNIT_CLOCK_H
+#define SCUNIT_CLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Returns whether the virtual clock is currently enabled.
+ *
+ * @return `true` if the virtual clock is enabled, otherwise `false`.
+ */
+bool scunit_clock_isVirtual();
+
+/**
+ * @brief Enables or disables the virtual clock for the current test.
+ *
+ * @note While the virtual clock is enabled, the functions defined by `SCUNIT_CLOCK_INTERPOSE()`
+ * report the virtual time instead of the real one, and sleeping returns immediately after
+ * advancing the virtual time by the requested duration. The virtual clock is disabled and its
+ * time is reset to zero automatically after every test, so it never leaks into the next one.
+ *
+ * Enabling the virtual clock in the test setup function of a suite makes it apply to all tests of
+ * that suite.
+ *
+ * @param[in] isVirtual Whether the virtual clock should be enabled.
+ */
+void scunit_clock_setVirtual(bool isVirtual);
+
+/**
+ * @brief Returns the current virtual time in nanoseconds.
+ *
+ * @note The virtual time starts at zero for every test and only moves forward if it is advanced
+ * explicitly using `scunit_clock_advance()` or if the code under test sleeps while the virtual
+ * clock is enabled.
+ *
+ * @return The current virtual time in nanoseconds.
+ */
+int64_t scunit_clock_now();
+
+/**
+ * @brief Advances the virtual time by a given number of nanoseconds.
+ *
+ * @note Negative values are ignored, as the virtual time never goes backwards.
+ *
+ * @param[in] nanoseconds Number of nanoseconds to advance the virtual time by.
+ */
+void scunit_clock_advance(int64_t nanoseconds);
+
+/**
+ * @brief Disables the virtual clock and resets the virtual time to zero.
+ *
+ * @note This function is called automatically after every test.
+ */
+void scunit_clock_reset();
+
+/**
+ * @brief Retrieves the time of a given clock, reporting the virtual time if the virtual clock is
+ * enabled.
+ *
+ * @note Only the wall clocks (e. g. `CLOCK_REALTIME` and `CLOCK_MONOTONIC`) are virtualized. CPU
+ * time clocks like `CLOCK_PROCESS_CPUTIME_ID` always report the real time.
+ *
+ * This function implements `clock_gettime()` for `SCUNIT_CLOCK_INTERPOSE()` and follows its
+ * semantics, including the return value and `errno`.
+ *
+ * @param[in]  clockId  Identifier of the clock to retrieve the time of.
+ * @param[out] timespec Time of the given clock.
+ * @return `0` on success, otherwise `-1` (with `errno` set to indicate the error).
+ */
+int scunit_clock_getTime(clockid_t clockId, struct timespec* timespec);
+
+/**
+ * @brief Retrieves the real time of a given clock, bypassing the virtual clock and any
+ * interposed `clock_gettime()`.
+ *
+ * @note This function is used by an `SCUnitTimer`, so that the measured durations of suites and
+ * tests stay truthful even if the virtual clock is enabled.
+ *
+ * @param[in]  clockId  Identifier of the clock to retrieve the time of.
+ * @param[out] timespec Real time of the given clock.
+ * @return `0` on success, otherwise `-1` (with `errno` set to indicate the error).
+ */
+int scunit_clock_getRealTime(clockid_t clockId, struct timespec* timespec);
+
+/**
+ * @brief Sleeps for a given duration, advancing the virtual time instantly if the virtual clock is
+ * enabled.
+ *
+ * @note This function implements `nanosleep()` for `SCUNIT_CLOCK_INTERPOSE()` and follows its
+ * semantics, including the return value and `errno`.
+ *
+ * @param[in]  duration  Duration to sleep for.
+ * @param[out] remaining Remaining duration if the sleep was interrupted (may be a `nullptr`).
+ * @return `0` on success, otherwise `-1` (with `errno` set to indicate the error).
+ */
+int scunit_clock_sleep(const struct timespec* duration, struct timespec* remaining);
+
+/**
+ * @brief Defines `clock_gettime()`, `nanosleep()`, `usleep()` and `sleep()` in the test executable
+ * to route them through the virtual clock.
+ *
+ * @note This header is not included by `<SCUnit/scunit.h>`, since it depends on POSIX types like
+ * `clockid_t`. Include it explicitly (with a feature-test macro like `_POSIX_C_SOURCE` defined if
+ * compiling with a strict `-std`) in the source file using this macro.
+ *
+ * This macro must be used exactly once at file scope of a test executable. Its definitions
+ * interpose the ones of the C library for the executable and all shared objects it loads, so that
+ * sleep-heavy code under test finishes instantly once the virtual clock is enabled using
+ * `scunit_clock_setVirtual()`. As long as the virtual clock is disabled, all calls are forwarded
+ * to the real functions.
+ *
+ * Example:
+ *
+ * ```c
+ * #define _POSIX_C_SOURCE 200809L
+ *
+ * #include <SCUnit/clock.h>
+ * #include <SCUnit/scunit.h>
+ *
+ * SCUNIT_CLOCK_INTERPOSE();
+ *
+ * SCUNIT_TEST(RetrySuite, GivesUpAfterTimeout) {
+ *     scunit_clock_setVirtual(true);
+ *     SCUNIT_ASSERT_FALSE(retry_connect(server, 30));
+ *     SCUNIT_ASSERT_GREATER_OR_EQUAL(scunit_clock_now(), 30 * 1'000'000'000LL);
+ * }
+ * ```
+ *
+ * @warning Calls made internally by the C library (e. g. the timeouts of
+ * `pthread_cond_timedwait()`) are not interposed and keep using the real time.
+ */
+#define SCUNIT_CLOCK_INTERPOSE()                                                        \
+    int clock_gettime(clockid_t clockId, struct timespec* timespec) {                   \
+        return scunit_clock_getTime(clockId, timespec);                                 \
+    }                                                                                   \
+    int nanosleep(const struct timespec* duration, struct timespec* remaining) {        \
+        return scunit_clock_sleep(duration, remaining);                                 \
+    }                                                                                   \
+    int usleep(unsigned int microseconds) {                                             \
+        struct timespec duration = {                                                    \
+            .tv_sec = microseconds / 1'000'000,                                         \
+            .tv_nsec = (microseconds % 1'000'000) * 1000L                               \
+        };                                                                              \
+        return scunit_clock_sleep(&duration, nullptr);                                  \
+    }                                                                                   \
+    unsigned int sleep(unsigned int seconds) {                                          \
+        struct timespec duration = { .tv_sec = seconds };                               \
+        struct timespec remaining = { };                                                \
+        if (scunit_clock_sleep(&duration, &remaining) < 0) {                            \
+            return (unsigned int) remaining.tv_sec + ((remaining.tv_nsec > 0) ? 1 : 0); \
+        }                                                                               \
+        return 0;                                                                       \
+    }                                                                                   \
+    [[maybe_unused]]                                                                    \
+    static constexpr bool scunit_clockInterposed = true
+
+#endif
\ No newline at end of file
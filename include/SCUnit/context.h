@@ -182,6 +182,95 @@ SCUnitError scunit_context_appendFileContext(
     int64_t line
 );
 
+/**
+ * @brief Gets the temporary directory of the test a given `SCUnitContext` belongs to, creating it
+ * on first use.
+ *
+ * @note Every test gets its own uniquely named directory below the root directory set by calling
+ * `scunit_setTemporaryDirectoryRoot()`, so tests running in parallel (e. g. in separate processes)
+ * never interfere with each other. Using a root directory on a tmpfs (such as `/dev/shm`) keeps
+ * I/O-heavy tests off the real disk.
+ *
+ * The directory is removed recursively after the test teardown function, unless the test failed
+ * and temporary directories are kept on failure (see `scunit_setKeepTemporaryOnFailure()`).
+ *
+ * @warning The path returned is owned by the `SCUnitContext`. It must not be modified nor
+ * deallocated manually and is only valid until the end of the current test.
+ *
+ * @param[in, out] context `SCUnitContext` to get the temporary directory of.
+ * @return A null-terminated string for the path of the temporary directory on success, otherwise
+ *         a `nullptr`.
+ */
+const char* scunit_context_getTemporaryDirectory(SCUnitContext* context);
+
+/**
+ * @brief Removes the temporary directory of a given `SCUnitContext` (if any) recursively.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`. If the
+ * `SCUnitContext` failed and temporary directories are kept on failure, the directory is kept and
+ * its path is appended to the message of the `SCUnitContext` instead.
+ *
+ * @param[in, out] context `SCUnitContext` to remove the temporary directory of.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCUNIT_ERROR_REMOVING_DIRECTORY_FAILED` if removing the directory failed and
+ * `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_context_removeTemporaryDirectory(SCUnitContext* context);
+
+/**
+ * @brief Begins a section of the test a given `SCUnitContext` belongs to.
+ *
+ * @note This function is intended for internal use by `SCUNIT_SECTION()`. Sections are counted in
+ * the order they are encountered while passing through the test. A section that was already
+ * executed during an earlier pass is skipped. A section encountered while another one is executed
+ * is not reported separately, but executed as part of the outer one.
+ *
+ * @warning The `name` is not copied, so it must remain valid until the section ends (which is the
+ * case for string literals).
+ *
+ * @param[in, out] context `SCUnitContext` of the test.
+ * @param[in]      name    A null-terminated string for the name of the section.
+ * @return `true` if the section is to be executed, otherwise `false`.
+ */
+bool scunit_context_beginSection(SCUnitContext* context, const char* name);
+
+/**
+ * @brief Ends the section currently executed by the test a given `SCUnitContext` belongs to and
+ * reports its result and timing.
+ *
+ * @note This function is intended for internal use by `SCUNIT_SECTION()`. The result of the test
+ * becomes `SCUNIT_RESULT_FAIL` if the section failed and is left as it was otherwise. Errors that
+ * occur while reporting the section are returned by `scunit_context_closeSections()`.
+ *
+ * @param[in, out] context `SCUnitContext` of the test.
+ */
+void scunit_context_endSection(SCUnitContext* context);
+
+/**
+ * @brief Prepares a given `SCUnitContext` for a new pass through its test.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`, which calls it
+ * before every pass.
+ *
+ * @param[in, out] context `SCUnitContext` of the test.
+ */
+void scunit_context_rewindSections(SCUnitContext* context);
+
+/**
+ * @brief Closes the sections of a given `SCUnitContext` after a pass through its test.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`, which calls it
+ * after every pass. If a section was left by returning from the test early (e. g. due to a failed
+ * assertion), it is ended and the test has to be passed through again to execute the sections
+ * after it.
+ *
+ * @param[in, out] context            `SCUnitContext` of the test.
+ * @param[out]     hasPendingSections Whether the test has to be passed through again.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCUNIT_ERROR_TIMER_FAILED` if measuring a section failed and `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_context_closeSections(SCUnitContext* context, bool* hasPendingSections);
+
 /**
  * @brief Deallocates a given `SCUnitContext`.
  *
@@ -0,0 +1,54 @@
+#ifndef SCUNIT_CRASH_H
+#define SCUNIT_CRASH_H
+
+#include <setjmp.h>
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+
+/**
+ * @brief Installs the signal handlers recovering from crashing tests.
+ *
+ * @note The handlers run on an alternate signal stack (so that even a stack overflow can be
+ * caught) and handle `SIGSEGV`, `SIGBUS`, `SIGFPE`, `SIGABRT` and `SIGXCPU` (raised if a test
+ * exceeds its CPU time limit, see `<SCUnit/limit.h>`). If one of these signals is raised while a
+ * recovery point is set, the handler records a backtrace and jumps back to the recovery point
+ * using `siglongjmp()`. Otherwise, the default action of the signal is taken.
+ *
+ * Installing the handlers more than once has no effect. This function is called automatically by
+ * `scunit_suite_execute()` if signals are caught (see `scunit_setCatchSignals()`).
+ *
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_INSTALLING_SIGNAL_HANDLERS_FAILED` if installing the alternate signal stack
+ *         or the handlers failed and `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_crash_install();
+
+/**
+ * @brief Sets the recovery point a crashing test jumps back to.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`, which sets the
+ * recovery point right before executing a test and clears it right afterwards. Only crashes on the
+ * calling thread jump back to it, while a crash on any other thread terminates the process.
+ *
+ * This header is not included by `<SCUnit/scunit.h>`, since `sigjmp_buf` is only available with
+ * POSIX (e. g. if `_POSIX_C_SOURCE` is defined when compiling with a strict `-std`).
+ *
+ * @param[in] recoveryPoint Recovery point initialized using `sigsetjmp()` or a `nullptr` to clear
+ *                          the recovery point.
+ */
+void scunit_crash_setRecoveryPoint(sigjmp_buf* recoveryPoint);
+
+/**
+ * @brief Appends the signal caught last and its backtrace to a given `SCUnitContext` and sets its
+ * result to `SCUNIT_RESULT_FAIL`.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()` after jumping back
+ * to a recovery point.
+ *
+ * @param[in, out] context `SCUnitContext` of the crashed test.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_crash_appendReport(SCUnitContext* context);
+
+#endif
\ No newline at end of file
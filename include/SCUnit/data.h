@@ -0,0 +1,42 @@
+#ifndef SCUNIT_DATA_H
+#define SCUNIT_DATA_H
+
+#include <stdint.h>
+#include <SCUnit/error.h>
+
+/** @brief Represents a read-only view of the contents of a test data file. */
+typedef struct SCUnitData {
+
+    /** @brief Pointer to the first byte of the contents. */
+    const void* bytes;
+
+    /** @brief Size of the contents (in bytes). */
+    int64_t size;
+
+} SCUnitData;
+
+/**
+ * @brief Maps a test data file into memory and returns a read-only view of its contents.
+ *
+ * @note Relative paths are resolved against the data directory set by calling
+ * `scunit_setDataDirectory()` (or passing `--data-dir`). Every file is only mapped once per
+ * process, with its pages populated up front, and the mapping is kept until the process exits. All
+ * tests (and all threads) requesting the same file share the same view, so even a large corpus is
+ * only read once instead of by every test using it. Since the mapping is backed by the file itself,
+ * its pages are also shared with other processes (e. g. the workers of `scunit-run`) through the
+ * page cache.
+ *
+ * @warning The contents must not be modified. Modifying the file while it is mapped results in
+ * undefined behavior.
+ *
+ * @param[in]  path  A null-terminated string for the path of the file to map.
+ * @param[out] error `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *                   `SCUNIT_ERROR_OPENING_STREAM_FAILED` if opening the file failed,
+ *                   `SCUNIT_ERROR_MAPPING_FILE_FAILED` if mapping the file failed and
+ *                   `SCUNIT_ERROR_NONE` otherwise.
+ * @return A read-only view of the contents of the file on success, otherwise a view with a
+ *         `nullptr` and a size of zero.
+ */
+SCUnitData scunit_data_map(const char* path, SCUnitError* error);
+
+#endif
\ No newline at end of file
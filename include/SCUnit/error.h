@@ -59,7 +59,80 @@ typedef enum SCUnitError {
      * @note See the documentation in `<SCUnit/timer.h>` to find out why this error may have
      * occurred. It is usually a sign of a serious programming error.
      */
-    SCUNIT_ERROR_TIMER_NOT_RUNNING
+    SCUNIT_ERROR_TIMER_NOT_RUNNING,
+
+    /**
+     * @brief Indicates that loading an `SCUnitModule` failed.
+     *
+     * @note See the documentation in `<SCUnit/module.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_LOADING_MODULE_FAILED,
+
+    /**
+     * @brief Indicates that unloading an `SCUnitModule` failed.
+     *
+     * @note See the documentation in `<SCUnit/module.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_UNLOADING_MODULE_FAILED,
+
+    /**
+     * @brief Indicates that creating a thread of an `SCUnitSchedule` failed.
+     *
+     * @note See the documentation in `<SCUnit/schedule.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_CREATING_THREAD_FAILED,
+
+    /**
+     * @brief Indicates that all remaining threads of an `SCUnitSchedule` were blocked.
+     *
+     * @note See the documentation in `<SCUnit/schedule.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_DEADLOCK_DETECTED,
+
+    /**
+     * @brief Indicates that installing the signal handlers for catching crashing tests failed.
+     *
+     * @note See the documentation in `<SCUnit/crash.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_INSTALLING_SIGNAL_HANDLERS_FAILED,
+
+    /**
+     * @brief Indicates that applying or lifting a resource limit of a test failed.
+     *
+     * @note See the documentation in `<SCUnit/limit.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_SETTING_RESOURCE_LIMIT_FAILED,
+
+    /**
+     * @brief Indicates that removing the temporary directory of a test failed.
+     *
+     * @note See the documentation of `scunit_context_removeTemporaryDirectory()` in
+     * `<SCUnit/context.h>` to find out why this error may have occurred.
+     */
+    SCUNIT_ERROR_REMOVING_DIRECTORY_FAILED,
+
+    /**
+     * @brief Indicates that mapping a test data file into memory failed.
+     *
+     * @note See the documentation in `<SCUnit/data.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_MAPPING_FILE_FAILED,
+
+    /**
+     * @brief Indicates that initializing the mutex or condition variable of an `SCUnitSchedule`
+     * failed.
+     *
+     * @note See the documentation in `<SCUnit/schedule.h>` to find out why this error may have
+     * occurred.
+     */
+    SCUNIT_ERROR_INITIALIZING_SCHEDULE_FAILED
 
 } SCUnitError;
 
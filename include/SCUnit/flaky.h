@@ -0,0 +1,84 @@
+#ifndef SCUNIT_FLAKY_H
+#define SCUNIT_FLAKY_H
+
+#include <stdint.h>
+#include <SCUnit/error.h>
+
+/**
+ * @brief Loads the quarantine file and the flaky history file set by calling
+ * `scunit_setQuarantineFile()` and `scunit_setFlakyHistoryFile()`.
+ *
+ * @note This function is intended for internal use by `scunit_executeSuites()`.
+ *
+ * Each line of the quarantine file contains a pattern of the form `<suite>[.<test>]` (like the
+ * option `--filter`), while empty lines and lines starting with `#` are ignored. Each line of the
+ * history file consists of the name of a test (`<suite>.<test>`), the number of its recorded runs,
+ * the number of those runs in which its outcome flipped and its last outcome (`pass` or `fail`),
+ * separated by tabs. A missing history file is treated like an empty one.
+ *
+ * @return `SCUNIT_ERROR_OPENING_STREAM_FAILED` if the quarantine file could not be opened,
+ *         `SCUNIT_ERROR_READING_STREAM_FAILED` if reading a file failed,
+ *         `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_flaky_load();
+
+/**
+ * @brief Determines if a test is quarantined, i. e. executed as usual, but not failing the run.
+ *
+ * @param[in] suiteName Name of the `SCUnitSuite` the test is registered in.
+ * @param[in] testName  Name of the test itself.
+ * @return `true` if the test matches a pattern of the quarantine file, otherwise `false`.
+ */
+bool scunit_flaky_isQuarantined(const char* suiteName, const char* testName);
+
+/**
+ * @brief Records the final outcome of a test in the flaky history.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()` and does nothing
+ * (except for returning the statistics of the current run) if no history file is set. The outcome
+ * of a run is considered flipped if the test passed on a retry after failing, or if it passed in
+ * this run but failed in the last recorded one (or vice versa).
+ *
+ * @param[in]  suiteName Name of the `SCUnitSuite` the test is registered in.
+ * @param[in]  testName  Name of the test itself.
+ * @param[in]  hasFailed Whether the test finally failed (after all retries).
+ * @param[in]  isFlaky   Whether the test failed at first, but passed on a retry.
+ * @param[out] runs      Number of recorded runs of the test, including this one.
+ * @param[out] flips     Number of recorded runs in which the outcome of the test flipped.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_flaky_record(
+    const char* suiteName,
+    const char* testName,
+    bool hasFailed,
+    bool isFlaky,
+    int64_t* runs,
+    int64_t* flips
+);
+
+/**
+ * @brief Saves the runs recorded by calling `scunit_flaky_record()` to the flaky history file.
+ *
+ * @note This function is intended for internal use by `scunit_executeSuites()`. The file is locked
+ * and read again before it is rewritten, so that test executables running in parallel (e. g.
+ * started by `scunit-run`) do not lose each other's runs.
+ *
+ * @return `SCUNIT_ERROR_OPENING_STREAM_FAILED` if the history file could not be opened or locked,
+ *         `SCUNIT_ERROR_READING_STREAM_FAILED` if reading it failed,
+ *         `SCUNIT_ERROR_WRITING_STREAM_FAILED` if writing it failed,
+ *         `SCUNIT_ERROR_CLOSING_STREAM_FAILED` if closing it failed,
+ *         `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_flaky_save();
+
+/**
+ * @brief Releases the quarantine patterns and the flaky history loaded by `scunit_flaky_load()`.
+ *
+ * @note This function is intended for internal use by SCUnit when it is deinitialized.
+ */
+void scunit_flaky_unload();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef SCUNIT_LEAK_H
+#define SCUNIT_LEAK_H
+
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+
+/**
+ * @brief Takes a snapshot of the file descriptors and threads of the process before a test.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`, which calls it
+ * before the test setup function if leaks are detected (see `scunit_setDetectLeaks()`). The
+ * snapshot is read from `/proc/self/fd` and `/proc/self/task` and kept as sorted arrays of
+ * integers, so that taking and comparing snapshots only costs a few microseconds.
+ *
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_READING_STREAM_FAILED` if reading the snapshot failed and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_leak_snapshot();
+
+/**
+ * @brief Compares the file descriptors and threads of the process after a test to the snapshot
+ * taken before it and reports any leaks to a given `SCUnitContext`.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`, which calls it
+ * after the test teardown function. Every file descriptor (along with what it refers to) and every
+ * thread (along with its name) that was not present before the test is reported and sets the
+ * result of the `SCUnitContext` to `SCUNIT_RESULT_FAIL`. File descriptors closed and threads
+ * finished by the test are not considered leaks.
+ *
+ * @param[in, out] context `SCUnitContext` of the test just executed.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_READING_STREAM_FAILED` if reading the snapshot failed and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_leak_check(SCUnitContext* context);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef SCUNIT_LIMIT_H
+#define SCUNIT_LIMIT_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+#include <SCUnit/print.h>
+
+/** @brief Represents an enumeration of the resources a test can be limited in. */
+typedef enum SCUnitLimit {
+
+    /**
+     * @brief Indicates the address space of the process (in bytes).
+     *
+     * @note Enforced using `RLIMIT_AS`, so that allocations exceeding the limit fail (e. g.
+     * `malloc()` returns a `nullptr`) instead of exhausting the memory of the host.
+     */
+    SCUNIT_LIMIT_ADDRESS_SPACE,
+
+    /**
+     * @brief Indicates the CPU time consumed by a test (in nanoseconds).
+     *
+     * @note Enforced using `RLIMIT_CPU`, which raises `SIGXCPU` once the limit (rounded up to
+     * whole seconds) is exceeded. The signal terminates the process unless signals are caught (see
+     * `scunit_setCatchSignals()`), in which case only the test fails.
+     */
+    SCUNIT_LIMIT_CPU_TIME,
+
+    /**
+     * @brief Indicates the number of file descriptors open in the process.
+     *
+     * @note Enforced using `RLIMIT_NOFILE`, so that opening more file descriptors fails with
+     * `EMFILE`.
+     */
+    SCUNIT_LIMIT_FILE_DESCRIPTORS
+
+} SCUnitLimit;
+
+/**
+ * @brief Gets the global value of a given `SCUnitLimit`, which applies to every test.
+ *
+ * @param[in] limit `SCUnitLimit` to get the global value of.
+ * @return The global value of the `SCUnitLimit` or zero if the resource is unlimited.
+ */
+int64_t scunit_limit_get(SCUnitLimit limit);
+
+/**
+ * @brief Sets the global value of a given `SCUnitLimit`, which applies to every test.
+ *
+ * @note The limit is applied right before each test and lifted right after it, so setup and
+ * teardown functions are not affected. It can also be set using the command line options
+ * `--limit-as`, `--limit-cpu` and `--limit-fds`.
+ *
+ * @param[in] limit `SCUnitLimit` to set the global value of.
+ * @param[in] value Value of the `SCUnitLimit` (see `SCUnitLimit` for its unit) or zero if the
+ *                  resource should be unlimited.
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if `limit` is not a valid `SCUnitLimit` or `value`
+ *         is negative, otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_limit_set(SCUnitLimit limit, int64_t value);
+
+/**
+ * @brief Overrides the value of a given `SCUnitLimit` for the current test only.
+ *
+ * @note This function is usually called using the `SCUNIT_LIMIT()` macro at the beginning of a
+ * test. The override takes effect immediately and is dropped automatically after the test.
+ *
+ * @param[in] limit `SCUnitLimit` to override.
+ * @param[in] value Value of the `SCUnitLimit` (see `SCUnitLimit` for its unit) or zero if the
+ *                  resource should be unlimited.
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if `limit` is not a valid `SCUnitLimit` or `value`
+ *         is negative, `SCUNIT_ERROR_SETTING_RESOURCE_LIMIT_FAILED` if applying the limit failed
+ *         (e. g. because it exceeds the hard limit of the process) and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+SCUnitError scunit_limit_setForTest(SCUnitLimit limit, int64_t value);
+
+/**
+ * @brief Applies the limits to the test about to be executed and records the usage of the limited
+ * resources before it.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`.
+ *
+ * @return `SCUNIT_ERROR_SETTING_RESOURCE_LIMIT_FAILED` if applying a limit failed, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_limit_begin();
+
+/**
+ * @brief Lifts the limits of the test just executed and reports any violations of them to a given
+ * `SCUnitContext`.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`. A violation sets
+ * the result of the `SCUnitContext` to `SCUNIT_RESULT_FAIL` and appends the observed usage along
+ * with the limit to its message.
+ *
+ * @param[in, out] context `SCUnitContext` of the test just executed.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_SETTING_RESOURCE_LIMIT_FAILED` if lifting a limit failed and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_limit_end(SCUnitContext* context);
+
+/**
+ * @brief Overrides the value of a given `SCUnitLimit` for the current test only.
+ *
+ * @attention If an unexpected error occurs while overriding the limit, an error message is written
+ * to `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] limit `SCUnitLimit` to override.
+ * @param[in] value Value of the `SCUnitLimit` (see `SCUnitLimit` for its unit) or zero if the
+ *                  resource should be unlimited.
+ */
+#define SCUNIT_LIMIT(limit, value)                                                          \
+    do {                                                                                    \
+        SCUnitError scunit_error = scunit_limit_setForTest(limit, value);                   \
+        if (scunit_error != SCUNIT_ERROR_NONE) {                                            \
+            scunit_fprintfc(                                                                \
+                stderr,                                                                     \
+                SCUNIT_COLOR_DARK_RED,                                                      \
+                SCUNIT_COLOR_DARK_DEFAULT,                                                  \
+                "An unexpected error occurred while overriding a limit (code %d).\n",       \
+                scunit_error                                                                \
+            );                                                                              \
+            exit(EXIT_FAILURE);                                                             \
+        }                                                                                   \
+    }                                                                                       \
+    while (false)
+
+#endif
\ No newline at end of file
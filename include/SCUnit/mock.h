@@ -0,0 +1,410 @@
+#ifndef SCUNIT_MOCK_H
+#define SCUNIT_MOCK_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/print.h>
+
+/**
+ * @brief Represents the common state of a mock defined using `SCUNIT_MOCK()` or
+ * `SCUNIT_MOCK_VOID()`.
+ *
+ * @note A mock is inactive by default, in which case every call is forwarded to the real function
+ * through a single indirect call. It becomes active for the current test as soon as it is
+ * configured (e. g. using `SCUNIT_MOCK_RETURN()` or `SCUNIT_EXPECT_CALLS()`) and is reset
+ * automatically after the test, once its expectations have been verified.
+ *
+ * You should not access the members of this structure directly, they are intended for internal use
+ * by the macros below.
+ */
+typedef struct SCUnitMock {
+
+    /** @brief Name of the mocked function. */
+    const char* name;
+
+    /** @brief Number of calls of the mocked function while the mock was active. */
+    int64_t calls;
+
+    /** @brief Expected number of calls or a negative value if no expectation was set. */
+    int64_t expectedCalls;
+
+    /** @brief Source file the expectation was set in (only valid if `expectedCalls` is set). */
+    const char* file;
+
+    /** @brief Line the expectation was set at (only valid if `expectedCalls` is set). */
+    int64_t line;
+
+    /** @brief Whether the mock is currently active. */
+    bool active;
+
+    /** @brief Function resetting the mock (including its type-specific state) to be inactive. */
+    void (*reset)(struct SCUnitMock* mock);
+
+    /** @brief Next active mock or a `nullptr` if this is the last one. */
+    struct SCUnitMock* next;
+
+} SCUnitMock;
+
+/**
+ * @brief Expands to the members of a structure for a given parameter list.
+ *
+ * @note This macro is intended for internal use only. Up to eight parameters are supported.
+ */
+#define SCUNIT_MOCK_MEMBERS(...) \
+    __VA_OPT__(SCUNIT_MOCK_MEMBERS_N(SCUNIT_MOCK_COUNT(__VA_ARGS__), __VA_ARGS__))
+#define SCUNIT_MOCK_COUNT(...) SCUNIT_MOCK_COUNT_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define SCUNIT_MOCK_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, count, ...) count
+#define SCUNIT_MOCK_MEMBERS_N(count, ...) SCUNIT_MOCK_MEMBERS_N_(count, __VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_N_(count, ...) SCUNIT_MOCK_MEMBERS_##count(__VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_1(first) first;
+#define SCUNIT_MOCK_MEMBERS_2(first, ...) first; SCUNIT_MOCK_MEMBERS_1(__VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_3(first, ...) first; SCUNIT_MOCK_MEMBERS_2(__VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_4(first, ...) first; SCUNIT_MOCK_MEMBERS_3(__VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_5(first, ...) first; SCUNIT_MOCK_MEMBERS_4(__VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_6(first, ...) first; SCUNIT_MOCK_MEMBERS_5(__VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_7(first, ...) first; SCUNIT_MOCK_MEMBERS_6(__VA_ARGS__)
+#define SCUNIT_MOCK_MEMBERS_8(first, ...) first; SCUNIT_MOCK_MEMBERS_7(__VA_ARGS__)
+
+/**
+ * @brief Removes the parentheses around a given list.
+ *
+ * @note This macro is intended for internal use only.
+ */
+#define SCUNIT_MOCK_UNWRAP(...) __VA_ARGS__
+
+/**
+ * @brief Defines the parts common to all mocks of a function.
+ *
+ * @note This macro is intended for internal use only. It factors out the common implementation of
+ * `SCUNIT_MOCK()` and `SCUNIT_MOCK_VOID()`. Use these macros directly instead.
+ *
+ * @param[in] returnType   Return type of the function.
+ * @param[in] function     Name of the function.
+ * @param[in] parameters   Parenthesized parameter list of the function.
+ * @param[in] arguments    Parenthesized list of the names of the parameters.
+ * @param[in] extraMembers Additional members of the state of the mock.
+ * @param[in] extraReset   Additional statements executed when the mock is reset.
+ */
+#define SCUNIT_MOCK_COMMON(returnType, function, parameters, arguments, extraMembers, extraReset) \
+    returnType __real_##function parameters;                                                      \
+    typedef struct scunit_mockCall##function {                                                    \
+        char scunit_unused;                                                                       \
+        SCUNIT_MOCK_MEMBERS parameters                                                            \
+    } scunit_mockCall##function;                                                                  \
+    static returnType scunit_mockFake##function parameters;                                       \
+    static void scunit_mockReset##function(SCUnitMock* mock);                                     \
+    typedef struct scunit_mockState##function {                                                   \
+        SCUnitMock mock;                                                                          \
+        returnType (*dispatch) parameters;                                                        \
+        returnType (*fake) parameters;                                                            \
+        scunit_mockCall##function* calls;                                                         \
+        int64_t callCapacity;                                                                     \
+        extraMembers                                                                              \
+    } scunit_mockState##function;                                                                 \
+    static scunit_mockState##function scunit_mock##function = {                                   \
+        .mock = {                                                                                 \
+            .name = #function,                                                                    \
+            .expectedCalls = -1,                                                                  \
+            .reset = scunit_mockReset##function                                                   \
+        },                                                                                        \
+        .dispatch = __real_##function                                                             \
+    };                                                                                            \
+    static void scunit_mockReset##function([[maybe_unused]] SCUnitMock* mock) {                   \
+        SCUNIT_FREE(scunit_mock##function.calls);                                                 \
+        extraReset                                                                                \
+        SCUnitMock base = scunit_mock##function.mock;                                             \
+        scunit_mock##function = (scunit_mockState##function) {                                    \
+            .mock = {                                                                             \
+                .name = base.name,                                                                \
+                .expectedCalls = -1,                                                              \
+                .reset = base.reset                                                               \
+            },                                                                                    \
+            .dispatch = __real_##function                                                         \
+        };                                                                                        \
+    }                                                                                             \
+    static void scunit_mockRecord##function(scunit_mockCall##function call) {                     \
+        if (scunit_mock##function.mock.calls >= scunit_mock##function.callCapacity) {             \
+            int64_t newCapacity = (scunit_mock##function.callCapacity == 0)                       \
+                ? 1                                                                               \
+                : scunit_mock##function.callCapacity * 2;                                         \
+            scunit_mockCall##function* newCalls = SCUNIT_REALLOC(                                 \
+                scunit_mock##function.calls,                                                      \
+                newCapacity * sizeof(scunit_mockCall##function)                                   \
+            );                                                                                    \
+            if (newCalls == nullptr) {                                                            \
+                scunit_fprintfc(                                                                  \
+                    stderr,                                                                       \
+                    SCUNIT_COLOR_DARK_RED,                                                        \
+                    SCUNIT_COLOR_DARK_DEFAULT,                                                    \
+                    "An unexpected error occurred while recording a call of %s (code %d).\n",     \
+                    #function,                                                                    \
+                    SCUNIT_ERROR_OUT_OF_MEMORY                                                    \
+                );                                                                                \
+                exit(EXIT_FAILURE);                                                               \
+            }                                                                                     \
+            scunit_mock##function.calls = newCalls;                                               \
+            scunit_mock##function.callCapacity = newCapacity;                                     \
+        }                                                                                         \
+        scunit_mock##function.calls[scunit_mock##function.mock.calls++] = call;                   \
+    }
+
+/**
+ * @brief Defines a mock for a function returning a value.
+ *
+ * @note This macro is intended to be used at file scope, exactly once per mocked function and test
+ * executable. The mock relies on the `--wrap` option of the linker, which redirects all calls of
+ * `function` to the mock, so the test executable must be linked using `-Wl,--wrap=<function>`.
+ * Note that `--wrap` only affects calls across object files, not calls inside the object file
+ * defining `function`.
+ *
+ * While the mock is inactive, calls are forwarded to the real function through a single indirect
+ * call. While it is active, every call is counted and its arguments are captured. The returned
+ * value is then determined by the fake set using `SCUNIT_MOCK_FAKE()` (if any), otherwise by the
+ * sequence of values set using `SCUNIT_MOCK_RETURN()`, where the last value is repeated once the
+ * sequence is exhausted. If neither is set, a zero-initialized value is returned.
+ *
+ * Each parameter must be declarable as a member of a structure (use pointers instead of arrays).
+ * Up to eight parameters are supported. A function without parameters is mocked using `()` for both
+ * `parameters` and `arguments`.
+ *
+ * @attention If an unexpected error occurs while recording a call, an error message is written to
+ * `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] returnType Return type of the function.
+ * @param[in] function   Name of the function.
+ * @param[in] parameters Parenthesized parameter list of the function (e. g.
+ *                       `(int fd, void* buffer, size_t count)`).
+ * @param[in] arguments  Parenthesized list of the names of the parameters (e. g.
+ *                       `(fd, buffer, count)`).
+ */
+#define SCUNIT_MOCK(returnType, function, parameters, arguments)                         \
+    SCUNIT_MOCK_COMMON(                                                                  \
+        returnType,                                                                      \
+        function,                                                                        \
+        parameters,                                                                      \
+        arguments,                                                                       \
+        returnType* returns; int64_t returnCount; int64_t returnCapacity;,               \
+        SCUNIT_FREE(scunit_mock##function.returns);                                      \
+    )                                                                                    \
+    returnType __wrap_##function parameters {                                            \
+        return scunit_mock##function.dispatch arguments;                                 \
+    }                                                                                    \
+    [[maybe_unused]]                                                                     \
+    static void scunit_mockAppendReturn##function(returnType value) {                    \
+        if (scunit_mock##function.returnCount >= scunit_mock##function.returnCapacity) { \
+            int64_t newCapacity = (scunit_mock##function.returnCapacity == 0)            \
+                ? 1                                                                      \
+                : scunit_mock##function.returnCapacity * 2;                              \
+            returnType* newReturns = SCUNIT_REALLOC(                                     \
+                scunit_mock##function.returns,                                           \
+                newCapacity * sizeof(returnType)                                         \
+            );                                                                           \
+            if (newReturns == nullptr) {                                                 \
+                scunit_fprintfc(                                                         \
+                    stderr,                                                              \
+                    SCUNIT_COLOR_DARK_RED,                                               \
+                    SCUNIT_COLOR_DARK_DEFAULT,                                           \
+                    "An unexpected error occurred while setting a return value of %s "   \
+                        "(code %d).\n",                                                  \
+                    #function,                                                           \
+                    SCUNIT_ERROR_OUT_OF_MEMORY                                           \
+                );                                                                       \
+                exit(EXIT_FAILURE);                                                      \
+            }                                                                            \
+            scunit_mock##function.returns = newReturns;                                  \
+            scunit_mock##function.returnCapacity = newCapacity;                          \
+        }                                                                                \
+        scunit_mock##function.returns[scunit_mock##function.returnCount++] = value;      \
+    }                                                                                    \
+    static returnType scunit_mockFake##function parameters {                             \
+        scunit_mockRecord##function(                                                     \
+            (scunit_mockCall##function) { 0, SCUNIT_MOCK_UNWRAP arguments }              \
+        );                                                                               \
+        if (scunit_mock##function.fake != nullptr) {                                     \
+            return scunit_mock##function.fake arguments;                                 \
+        }                                                                                \
+        if (scunit_mock##function.returnCount > 0) {                                     \
+            int64_t index = scunit_mock##function.mock.calls - 1;                        \
+            return scunit_mock##function.returns[                                        \
+                (index < scunit_mock##function.returnCount)                              \
+                    ? index                                                              \
+                    : scunit_mock##function.returnCount - 1                              \
+            ];                                                                           \
+        }                                                                                \
+        static returnType zero;                                                          \
+        return zero;                                                                     \
+    }                                                                                    \
+    [[maybe_unused]]                                                                     \
+    static constexpr bool scunit_mock##function##Defined = true
+
+/**
+ * @brief Defines a mock for a function returning `void`.
+ *
+ * @note This macro behaves exactly like `SCUNIT_MOCK()`, except that no return values can be set.
+ * See `SCUNIT_MOCK()` for more information.
+ *
+ * @param[in] function   Name of the function.
+ * @param[in] parameters Parenthesized parameter list of the function.
+ * @param[in] arguments  Parenthesized list of the names of the parameters.
+ */
+#define SCUNIT_MOCK_VOID(function, parameters, arguments)                   \
+    SCUNIT_MOCK_COMMON(void, function, parameters, arguments, , )           \
+    void __wrap_##function parameters {                                     \
+        scunit_mock##function.dispatch arguments;                           \
+    }                                                                       \
+    static void scunit_mockFake##function parameters {                      \
+        scunit_mockRecord##function(                                        \
+            (scunit_mockCall##function) { 0, SCUNIT_MOCK_UNWRAP arguments } \
+        );                                                                  \
+        if (scunit_mock##function.fake != nullptr) {                        \
+            scunit_mock##function.fake arguments;                           \
+        }                                                                   \
+    }                                                                       \
+    [[maybe_unused]]                                                        \
+    static constexpr bool scunit_mock##function##Defined = true
+
+/**
+ * @brief Activates the mock of a given function for the current test.
+ *
+ * @note This macro is intended for internal use only. All macros configuring a mock activate it
+ * automatically.
+ *
+ * @param[in] function Name of the mocked function.
+ */
+#define SCUNIT_MOCK_ACTIVATE(function)                              \
+    do {                                                            \
+        scunit_mock##function.dispatch = scunit_mockFake##function; \
+        scunit_mock_activate(&scunit_mock##function.mock);          \
+    }                                                               \
+    while (false)
+
+/**
+ * @brief Activates the mock of a given function for the current test without configuring it.
+ *
+ * @note Calls are counted and their arguments captured, while a zero-initialized value is
+ * returned (for functions returning a value).
+ *
+ * @param[in] function Name of the mocked function.
+ */
+#define SCUNIT_MOCK_ENABLE(function) SCUNIT_MOCK_ACTIVATE(function)
+
+/**
+ * @brief Appends a value to the sequence of values returned by the mock of a given function and
+ * activates it for the current test.
+ *
+ * @attention If an unexpected error occurs while appending the value, an error message is written
+ * to `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] function Name of the mocked function (defined using `SCUNIT_MOCK()`).
+ * @param[in] value    Value to append.
+ */
+#define SCUNIT_MOCK_RETURN(function, value)       \
+    do {                                          \
+        scunit_mockAppendReturn##function(value); \
+        SCUNIT_MOCK_ACTIVATE(function);           \
+    }                                             \
+    while (false)
+
+/**
+ * @brief Sets a fake implementation for the mock of a given function and activates it for the
+ * current test.
+ *
+ * @note The fake is called with the same arguments as the mocked function and takes precedence
+ * over any values set using `SCUNIT_MOCK_RETURN()`. It may call the real function using
+ * `SCUNIT_MOCK_REAL()`.
+ *
+ * @param[in] function       Name of the mocked function.
+ * @param[in] implementation Function with the same signature as the mocked function.
+ */
+#define SCUNIT_MOCK_FAKE(function, implementation)     \
+    do {                                               \
+        scunit_mock##function.fake = (implementation); \
+        SCUNIT_MOCK_ACTIVATE(function);                \
+    }                                                  \
+    while (false)
+
+/**
+ * @brief Expects the mocked function to be called an exact number of times during the current test
+ * and activates its mock.
+ *
+ * @note The expectation is verified automatically after the test function returned. If it is not
+ * met, the test fails with a message pointing to this expectation.
+ *
+ * @param[in] function Name of the mocked function.
+ * @param[in] count    Expected number of calls.
+ */
+#define SCUNIT_EXPECT_CALLS(function, count)                \
+    do {                                                    \
+        scunit_mock##function.mock.expectedCalls = (count); \
+        scunit_mock##function.mock.file = __FILE__;         \
+        scunit_mock##function.mock.line = __LINE__;         \
+        SCUNIT_MOCK_ACTIVATE(function);                     \
+    }                                                       \
+    while (false)
+
+/**
+ * @brief Gets the number of calls of a mocked function during the current test.
+ *
+ * @param[in] function Name of the mocked function.
+ * @return The number of calls of the mocked function since its mock was activated.
+ */
+#define SCUNIT_MOCK_CALLS(function) (scunit_mock##function.mock.calls)
+
+/**
+ * @brief Gets the captured arguments of a call of a mocked function during the current test.
+ *
+ * @note The arguments are captured in a structure whose members are named like the parameters of
+ * the mocked function (e. g. `SCUNIT_MOCK_ARGUMENTS(read, 0).count`).
+ *
+ * @warning `index` must be between zero (inclusive) and `SCUNIT_MOCK_CALLS()` (exclusive),
+ * otherwise the behavior is undefined.
+ *
+ * @param[in] function Name of the mocked function.
+ * @param[in] index    Index of the call, starting at zero for the first call.
+ * @return The captured arguments of the call at the given index.
+ */
+#define SCUNIT_MOCK_ARGUMENTS(function, index) (scunit_mock##function.calls[(index)])
+
+/**
+ * @brief Expands to the real function of a mocked function, bypassing its mock.
+ *
+ * @param[in] function Name of the mocked function.
+ */
+#define SCUNIT_MOCK_REAL(function) __real_##function
+
+/**
+ * @brief Activates a given `SCUnitMock` for the current test.
+ *
+ * @note This function is used by the macros above and is generally intended for internal use.
+ * Activating an already active `SCUnitMock` has no effect.
+ *
+ * @param[in, out] mock `SCUnitMock` to activate.
+ */
+void scunit_mock_activate(SCUnitMock* mock);
+
+/**
+ * @brief Verifies the expectations of all active mocks.
+ *
+ * @note This function is called automatically by an `SCUnitSuite` after each test. If an
+ * expectation is not met, the result of the `SCUnitContext` is set to `SCUNIT_RESULT_FAIL` and a
+ * message describing the expectation is appended.
+ *
+ * @param[in, out] context `SCUnitContext` of the current test.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCUNIT_ERROR_WRITING_BUFFER_FAILED` if appending a message failed and `SCUNIT_ERROR_NONE`
+ * otherwise.
+ */
+SCUnitError scunit_mock_verify(SCUnitContext* context);
+
+/**
+ * @brief Resets all active mocks, which forwards all calls to the real functions again.
+ *
+ * @note This function is called automatically by an `SCUnitSuite` after each test.
+ */
+void scunit_mock_reset();
+
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef SCUNIT_MODULE_H
+#define SCUNIT_MODULE_H
+
+#include <stdint.h>
+#include <SCUnit/error.h>
+#include <SCUnit/suite.h>
+
+/**
+ * @brief Represents a shared object containing suites and tests that is loaded into the running
+ * process at runtime.
+ *
+ * @note Suites and tests defined in a module using the macros from `<SCUnit/suite.h>` are
+ * registered automatically while the module is loaded, exactly as if they had been linked into the
+ * test executable directly. This allows large test trees to be built and linked incrementally as
+ * separate modules instead of relinking a single test executable.
+ *
+ * A module must be built as a position-independent shared object (e. g. using `-shared -fPIC`)
+ * and must not link SCUnit itself. All symbols of SCUnit are resolved from the loading process,
+ * which therefore needs to export them (e. g. by linking SCUnit statically using `-rdynamic`, as
+ * the `scunit-run` executable does).
+ */
+typedef struct SCUnitModule SCUnitModule;
+
+/**
+ * @brief Loads a module from a given path and registers all of its suites.
+ *
+ * @note If loading the module fails, `dlerror()` may be consulted for a more detailed description
+ * of the error.
+ *
+ * @warning An `SCUnitModule` returned by this function is dynamically allocated and must be passed
+ * to `scunit_module_unload()` to avoid a resource leak.
+ *
+ * @param[in]  path  A null-terminated string for the path of the shared object to load.
+ * @param[out] error `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *                   `SCUNIT_ERROR_LOADING_MODULE_FAILED` if loading the shared object failed and
+ *                   `SCUNIT_ERROR_NONE` otherwise.
+ * @return A pointer to a new loaded `SCUnitModule` on success, otherwise a `nullptr`.
+ */
+SCUnitModule* scunit_module_load(const char* path, SCUnitError* error);
+
+/**
+ * @brief Gets the path of a given `SCUnitModule`.
+ *
+ * @warning The returned path is a direct reference to the internal path of the `SCUnitModule`.
+ * It must not be modified nor deallocated manually.
+ *
+ * @param[in] module `SCUnitModule` to get the path of.
+ * @return The path the given `SCUnitModule` was loaded from.
+ */
+const char* scunit_module_getPath(const SCUnitModule* module);
+
+/**
+ * @brief Gets the number of suites registered by a given `SCUnitModule`.
+ *
+ * @param[in] module `SCUnitModule` to examine.
+ * @return The number of suites registered while loading the given `SCUnitModule`.
+ */
+int64_t scunit_module_getSuiteCount(const SCUnitModule* module);
+
+/**
+ * @brief Gets a suite registered by a given `SCUnitModule` by its index.
+ *
+ * @warning The returned `SCUnitSuite` is owned by SCUnit and only valid as long as the
+ * `SCUnitModule` is loaded. You must not deallocate it manually.
+ *
+ * @param[in] module `SCUnitModule` to get the suite of.
+ * @param[in] index  Index of the `SCUnitSuite` to get, which must be between zero (inclusive) and
+ *                   `scunit_module_getSuiteCount()` (exclusive).
+ * @return The `SCUnitSuite` at the given index or a `nullptr` if `index` is out of range.
+ */
+SCUnitSuite* scunit_module_getSuite(const SCUnitModule* module, int64_t index);
+
+/**
+ * @brief Unregisters and deallocates all suites of a given `SCUnitModule` and unloads it.
+ *
+ * @note For convenience, `module` is allowed to be `nullptr`.
+ *
+ * Modules are independent of each other and may be unloaded in any order.
+ *
+ * @warning Any use of the `SCUnitModule` (or any of its suites) after it has been unloaded results
+ * in undefined behavior, even if unloading the shared object itself failed.
+ *
+ * @param[in, out] module `SCUnitModule` to unload.
+ * @return `SCUNIT_ERROR_UNLOADING_MODULE_FAILED` if unloading the shared object failed,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_module_unload(SCUnitModule* module);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef SCUNIT_OPTIMIZE_H
+#define SCUNIT_OPTIMIZE_H
+
+#include <stdatomic.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__aarch64__))
+
+/**
+ * @brief Forces a given value to be computed, without letting the compiler know what it is used
+ * for.
+ *
+ * @note This is a function-like macro, so it accepts a value of any scalar, pointer or structure
+ * type (but not an array). Its semantics are guaranteed as follows:
+ *
+ * - The value is fully computed before this point, so the code producing it cannot be removed as
+ *   dead code or sunk out of the loop it is in.
+ * - The compiler must assume that the value is read and that any memory reachable by the program
+ *   may have been read or written, so stores before this point are not eliminated either.
+ * - No instruction is emitted for the barrier itself. The value is kept in a register if it fits
+ *   into one, so, unlike storing it into a `volatile` variable, no extra memory traffic is added to
+ *   the measured loop.
+ *
+ * It does not prevent the compiler from optimizing how the value is computed, e. g. if its inputs
+ * are constants known at compile time. Since the value is copied, passing a variable does not
+ * hide its value either. To hide the value of an input, or to make the contents of an array
+ * observable, pass a pointer to it instead, so that the compiler must assume it was changed.
+ *
+ * @param[in] value Value to force to be computed.
+ */
+#define scunit_doNotOptimize(value)                                       \
+    do {                                                                  \
+        typeof(value) scunit_optimizedValue = (value);                    \
+        __asm__ volatile("" : "+rm"(scunit_optimizedValue) : : "memory"); \
+    } while (false)
+
+/**
+ * @brief Forces all pending writes to memory to be completed, as if every memory location could be
+ * read by code the compiler cannot see.
+ *
+ * @note The compiler must assume that any memory reachable by the program is read and written at
+ * this point, so writes before it cannot be eliminated or deferred past it, and values cached in
+ * registers are reloaded after it. Like `scunit_doNotOptimize()`, it emits no instruction, and it
+ * is not a hardware memory fence, so it has no effect on the order in which other threads observe
+ * the writes.
+ */
+static inline void scunit_clobberMemory() {
+    __asm__ volatile("" : : : "memory");
+}
+
+#else
+
+// Other compilers and architectures fall back to a `volatile` copy and a compiler fence, which are
+// portable, but add a store to the measured loop and may not prevent every optimization.
+#define scunit_doNotOptimize(value)                             \
+    do {                                                        \
+        volatile typeof(value) scunit_optimizedValue = (value); \
+        (void) scunit_optimizedValue;                           \
+        atomic_signal_fence(memory_order_seq_cst);              \
+    } while (false)
+
+static inline void scunit_clobberMemory() {
+    atomic_signal_fence(memory_order_seq_cst);
+}
+
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef SCUNIT_SANITIZER_H
+#define SCUNIT_SANITIZER_H
+
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+
+/**
+ * @brief Returns whether the reports of a sanitizer runtime are attributed to individual tests.
+ *
+ * @note Attribution is enabled automatically if the test executable is built with a sanitizer
+ * (e. g. using `-fsanitize=address`, `-fsanitize=undefined` or `-fsanitize=thread`). Reports are
+ * then redirected to a temporary file using `__sanitizer_set_report_path()` and attached to the
+ * `SCUnitContext` of the test that caused them, which fails the test.
+ *
+ * To get a complete list of offending tests from a single run, reports must not be fatal. This is
+ * the default for ThreadSanitizer and most checks of UndefinedBehaviorSanitizer. AddressSanitizer
+ * requires building with `-fsanitize-recover=address` and running with
+ * `ASAN_OPTIONS=halt_on_error=0`. If a fatal report terminates the process nevertheless, the
+ * report and the test that caused it are written to `stderr` before it dies.
+ *
+ * @return `true` if sanitizer reports are attributed to tests, otherwise `false`.
+ */
+bool scunit_sanitizer_isEnabled();
+
+/**
+ * @brief Sets the test currently being executed, which is reported if a sanitizer terminates the
+ * process.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`.
+ *
+ * @param[in] suiteName A null-terminated string for the name of the current suite.
+ * @param[in] testName  A null-terminated string for the name of the current test or a `nullptr`
+ *                      if no test is currently being executed.
+ */
+void scunit_sanitizer_setCurrentTest(const char* suiteName, const char* testName);
+
+/**
+ * @brief Attaches all sanitizer reports produced since the last call to a given `SCUnitContext`.
+ *
+ * @note If there are any new reports, the result of the `SCUnitContext` is set to
+ * `SCUNIT_RESULT_FAIL`. This function is called automatically after every test and does nothing
+ * if sanitizer reports are not attributed to tests.
+ *
+ * @param[in, out] context `SCUnitContext` to attach the reports to.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_READING_STREAM_FAILED` if reading the reports failed and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_sanitizer_attachReports(SCUnitContext* context);
+
+#endif
\ No newline at end of file
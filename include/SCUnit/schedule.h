@@ -0,0 +1,244 @@
+#ifndef SCUNIT_SCHEDULE_H
+#define SCUNIT_SCHEDULE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+
+/**
+ * @brief Represents a seeded scheduler that executes a set of threads one at a time, switching
+ * between them only at explicit scheduling points.
+ *
+ * @note Serializing threads under a pseudorandom scheduler makes every interleaving of a
+ * concurrent test a pure function of its seed. Instead of hoping that the operating system
+ * produces a rare interleaving once in ten thousand runs, a test can explore thousands of
+ * different interleavings in a few seconds and replay a failing one exactly by reusing its seed.
+ *
+ * Threads switch at the scheduling points `scunit_yield()`, `scunit_mutex_lock()` and
+ * `scunit_mutex_unlock()`. The code under test is expected to call `scunit_yield()` around its
+ * interesting atomic operations (e. g. through a macro that expands to nothing in production
+ * builds). Outside of a schedule, all scheduling points behave like their ordinary counterparts.
+ *
+ * Example:
+ *
+ * ```c
+ * for (uint64_t seed = 0; seed < 10'000; seed++) {
+ *     SCUnitError error;
+ *     SCUnitSchedule* schedule = scunit_schedule_new(SCUNIT_SCHEDULE_STRATEGY_PCT, seed, &error);
+ *     SCUNIT_ASSERT_EQUAL(error, SCUNIT_ERROR_NONE);
+ *     Queue* queue = queue_new();
+ *     scunit_schedule_addThread(schedule, produce, queue);
+ *     scunit_schedule_addThread(schedule, consume, queue);
+ *     error = scunit_schedule_run(schedule, scunit_context);
+ *     scunit_schedule_free(schedule);
+ *     queue_free(queue);
+ *     SCUNIT_ASSERT_EQUAL(error, SCUNIT_ERROR_NONE);
+ *     if (scunit_context_getResult(scunit_context) == SCUNIT_RESULT_FAIL) {
+ *         return;
+ *     }
+ * }
+ * ```
+ */
+typedef struct SCUnitSchedule SCUnitSchedule;
+
+/** @brief Represents an enumeration of the strategies used to choose the next thread to run. */
+typedef enum SCUnitScheduleStrategy {
+
+    /** @brief Indicates that a uniformly random runnable thread is chosen at every point. */
+    SCUNIT_SCHEDULE_STRATEGY_RANDOM,
+
+    /**
+     * @brief Indicates that probabilistic concurrency testing (PCT) is used.
+     *
+     * @note Every thread is assigned a random priority and the runnable thread with the highest
+     * priority is always chosen. At a number of random steps (one less than the depth), the
+     * priority of the running thread is lowered below all others. This finds bugs requiring a
+     * certain number of ordering constraints (the depth) with a guaranteed probability, which is
+     * usually a lot more effective than choosing threads uniformly at random.
+     */
+    SCUNIT_SCHEDULE_STRATEGY_PCT
+
+} SCUnitScheduleStrategy;
+
+/**
+ * @brief Represents a function executed as a thread of an `SCUnitSchedule`.
+ *
+ * @note The `SCUnitContext` of the test is passed to every thread, so assertions can be used
+ * within them. A failed assertion terminates the current thread (but not the others).
+ *
+ * @param[in, out] scunit_context `SCUnitContext` storing important information about the test.
+ * @param[in, out] argument       Argument passed to `scunit_schedule_addThread()`.
+ */
+typedef void (*SCUnitThreadFunction)(
+    [[maybe_unused]] SCUnitContext* scunit_context,
+    [[maybe_unused]] void* argument
+);
+
+/**
+ * @brief Represents a mutex that acts as a scheduling point when used by the threads of an
+ * `SCUnitSchedule`.
+ *
+ * @note A thread blocked on an `SCUnitMutex` is never chosen to run until the mutex is unlocked,
+ * which allows an `SCUnitSchedule` to detect deadlocks. Outside of a schedule, it behaves like an
+ * ordinary spinlock. An `SCUnitMutex` is unlocked if it is zero-initialized (e. g. using `{ }`).
+ *
+ * You should not access the members of this structure directly.
+ */
+typedef struct SCUnitMutex {
+
+    /** @brief Whether the `SCUnitMutex` is currently locked. */
+    atomic_bool isLocked;
+
+} SCUnitMutex;
+
+/**
+ * @brief Allocates and initializes a new `SCUnitSchedule` using a given strategy and seed.
+ *
+ * @note The depth of the PCT strategy defaults to `3` and the estimated number of steps to `1000`.
+ *
+ * @warning An `SCUnitSchedule` returned by this function is dynamically allocated and must be
+ * passed to `scunit_schedule_free()` to avoid a memory leak.
+ *
+ * @param[in]  strategy `SCUnitScheduleStrategy` used to choose the next thread to run.
+ * @param[in]  seed     Seed to initialize the `SCUnitRandom` of the scheduler with.
+ * @param[out] error    `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *                      `SCUNIT_ERROR_INITIALIZING_SCHEDULE_FAILED` if initializing the mutex or
+ *                      condition variable of the scheduler failed and `SCUNIT_ERROR_NONE`
+ *                      otherwise.
+ * @return A pointer to a new initialized `SCUnitSchedule` on success, otherwise a `nullptr`.
+ */
+SCUnitSchedule* scunit_schedule_new(
+    SCUnitScheduleStrategy strategy,
+    uint64_t seed,
+    SCUnitError* error
+);
+
+/**
+ * @brief Gets the seed of a given `SCUnitSchedule`.
+ *
+ * @note Running the same threads with the same strategy and seed again replays the exact same
+ * interleaving, as long as the threads themselves are deterministic.
+ *
+ * @param[in] schedule `SCUnitSchedule` to get the seed of.
+ * @return The seed of the given `SCUnitSchedule`.
+ */
+uint64_t scunit_schedule_getSeed(const SCUnitSchedule* schedule);
+
+/**
+ * @brief Sets the depth of the PCT strategy for a given `SCUnitSchedule`.
+ *
+ * @note The depth is the number of ordering constraints a bug requires to show up (e. g. `2` for a
+ * simple atomicity violation). Larger depths find more complex bugs, but each of them with a lower
+ * probability. It has no effect for other strategies.
+ *
+ * @param[in, out] schedule `SCUnitSchedule` to set the depth of.
+ * @param[in]      depth    Depth of the PCT strategy (must be at least `1`).
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if the depth is out of range, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_schedule_setDepth(SCUnitSchedule* schedule, int64_t depth);
+
+/**
+ * @brief Sets the estimated number of steps (scheduling points) for a given `SCUnitSchedule`.
+ *
+ * @note The PCT strategy lowers the priorities of threads at random steps within this estimate,
+ * so it should roughly match the number of scheduling points of a run. It has no effect for other
+ * strategies.
+ *
+ * @param[in, out] schedule `SCUnitSchedule` to set the estimated number of steps of.
+ * @param[in]      steps    Estimated number of steps (must be at least `1`).
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if the number of steps is out of range, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_schedule_setSteps(SCUnitSchedule* schedule, int64_t steps);
+
+/**
+ * @brief Adds a thread to a given `SCUnitSchedule`.
+ *
+ * @note Threads are only created once the `SCUnitSchedule` is run.
+ *
+ * @attention Threads must not be added while the `SCUnitSchedule` is running.
+ *
+ * @param[in, out] schedule `SCUnitSchedule` to add the thread to.
+ * @param[in]      function `SCUnitThreadFunction` to execute as the thread.
+ * @param[in, out] argument Argument to pass to the function (may be a `nullptr`).
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_schedule_addThread(
+    SCUnitSchedule* schedule,
+    SCUnitThreadFunction function,
+    void* argument
+);
+
+/**
+ * @brief Runs all threads of a given `SCUnitSchedule` to completion, one at a time.
+ *
+ * @note If the test fails while the `SCUnitSchedule` is running or a deadlock is detected, the
+ * seed of the `SCUnitSchedule` is appended to the message of the `SCUnitContext`, so that the
+ * failing interleaving can be replayed.
+ *
+ * If all remaining threads are blocked on an `SCUnitMutex`, they are terminated using
+ * `pthread_exit()` and the test fails.
+ *
+ * @param[in, out] schedule `SCUnitSchedule` to run.
+ * @param[in, out] context  `SCUnitContext` to pass to the threads.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_CREATING_THREAD_FAILED` if creating a thread failed,
+ *         `SCUNIT_ERROR_DEADLOCK_DETECTED` if a deadlock was detected and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+SCUnitError scunit_schedule_run(SCUnitSchedule* schedule, SCUnitContext* context);
+
+/**
+ * @brief Calls the function of a thread of an `SCUnitSchedule`.
+ *
+ * @note This function is intended for internal use by `scunit_schedule_run()`. Like
+ * `scunit_suite_callTest()`, it marks the frame at which backtraces of failures are trimmed.
+ *
+ * @param[in]      function Function of the thread to call.
+ * @param[in, out] context  `SCUnitContext` to pass to the function.
+ * @param[in, out] argument Argument to pass to the function.
+ */
+void scunit_schedule_callThread(
+    SCUnitThreadFunction function,
+    SCUnitContext* context,
+    void* argument
+);
+
+/**
+ * @brief Deallocates a given `SCUnitSchedule`.
+ *
+ * @note For convenience, `schedule` is allowed to be `nullptr`.
+ *
+ * @warning Any use of the `SCUnitSchedule` after it has been deallocated results in undefined
+ * behavior.
+ *
+ * @param[in, out] schedule `SCUnitSchedule` to deallocate.
+ */
+void scunit_schedule_free(SCUnitSchedule* schedule);
+
+/**
+ * @brief Marks a scheduling point, at which the `SCUnitSchedule` of the current thread may switch
+ * to a different thread.
+ *
+ * @note Outside of a schedule, this function does nothing.
+ */
+void scunit_yield();
+
+/**
+ * @brief Locks a given `SCUnitMutex`, blocking the current thread until it is available.
+ *
+ * @param[in, out] mutex `SCUnitMutex` to lock.
+ */
+void scunit_mutex_lock(SCUnitMutex* mutex);
+
+/**
+ * @brief Unlocks a given `SCUnitMutex`, allowing the threads blocked on it to run again.
+ *
+ * @param[in, out] mutex `SCUnitMutex` to unlock.
+ */
+void scunit_mutex_unlock(SCUnitMutex* mutex);
+
+#endif
\ No newline at end of file
@@ -3,12 +3,24 @@
 
 #include <stdint.h>
 #include <SCUnit/assert.h>
+#include <SCUnit/backtrace.h>
+#include <SCUnit/benchmark.h>
 #include <SCUnit/context.h>
+#include <SCUnit/data.h>
 #include <SCUnit/error.h>
+#include <SCUnit/flaky.h>
+#include <SCUnit/leak.h>
+#include <SCUnit/limit.h>
 #include <SCUnit/memory.h>
+#include <SCUnit/mock.h>
+#include <SCUnit/module.h>
+#include <SCUnit/optimize.h>
 #include <SCUnit/print.h>
 #include <SCUnit/random.h>
+#include <SCUnit/sanitizer.h>
+#include <SCUnit/schedule.h>
 #include <SCUnit/suite.h>
+#include <SCUnit/table.h>
 #include <SCUnit/timer.h>
 
 /** @brief Represents the version information of SCUnit. */
@@ -77,6 +89,49 @@ SCUnitColoredOutput scunit_getColoredOutput();
  */
 SCUnitError scunit_setColoredOutput(SCUnitColoredOutput coloredOutput);
 
+/**
+ * @brief Gets whether crashing tests are caught and recovered from.
+ *
+ * @note Signals are not caught by default.
+ *
+ * @return `true` if crashing tests are caught and recovered from, otherwise `false`.
+ */
+bool scunit_getCatchSignals();
+
+/**
+ * @brief Sets whether crashing tests are caught and recovered from.
+ *
+ * @note If enabled, a test raising `SIGSEGV`, `SIGBUS`, `SIGFPE` or `SIGABRT` is marked as failed
+ * along with a backtrace of the crash, and execution continues with the next test (see
+ * `<SCUnit/crash.h>`). This avoids the cost of isolating every test in its own process, but the
+ * state left behind by a crashing test (e. g. leaked memory or held locks) is not cleaned up.
+ * Only the test function itself is protected, not its setup or teardown functions.
+ *
+ * @param[in] catchSignals Whether crashing tests should be caught and recovered from.
+ */
+void scunit_setCatchSignals(bool catchSignals);
+
+/**
+ * @brief Gets whether file descriptors and threads leaked by tests are detected.
+ *
+ * @note Leaks are not detected by default.
+ *
+ * @return `true` if leaks are detected, otherwise `false`.
+ */
+bool scunit_getDetectLeaks();
+
+/**
+ * @brief Sets whether file descriptors and threads leaked by tests are detected.
+ *
+ * @note If enabled, a test leaving behind a file descriptor it opened or a thread it started
+ * (including its setup and teardown functions) is marked as failed along with the leaked
+ * resources (see `<SCUnit/leak.h>`). This catches the culprit right away, rather than a later
+ * test failing with `EMFILE`.
+ *
+ * @param[in] detectLeaks Whether leaks should be detected.
+ */
+void scunit_setDetectLeaks(bool detectLeaks);
+
 /**
  * @brief Gets the current order in which suites and tests are executed.
  *
@@ -96,6 +151,272 @@ SCUnitOrder scunit_getOrder();
  */
 SCUnitError scunit_setOrder(SCUnitOrder order);
 
+/**
+ * @brief Gets the current filter used to select the tests to execute.
+ *
+ * @note All tests are selected by default (the filter is set to `*`).
+ *
+ * @warning The returned filter is a direct reference to the internal filter. It must not be
+ * modified nor deallocated manually.
+ *
+ * @return The current filter used to select the tests to execute.
+ */
+const char* scunit_getFilter();
+
+/**
+ * @brief Sets the filter used to select the tests to execute.
+ *
+ * @note A filter has the form `<suite>[.<test>]`, where both parts are shell wildcard patterns
+ * (see `fnmatch()`) matched against the names of suites and tests. If the test part is omitted,
+ * all tests of the matching suites are selected (e. g. `Parser` selects the same tests as
+ * `Parser.*`).
+ *
+ * @warning The `filter` is copied internally for reasons of safety. If you pass a dynamically
+ * allocated string, you are responsible for deallocating it yourself.
+ *
+ * @param[in] filter A null-terminated string for the filter to set.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setFilter(const char* filter);
+
+/**
+ * @brief Gets the root directory the temporary directories of tests are created in.
+ *
+ * @note The root directory defaults to `$TMPDIR` or `/tmp` if it is not set.
+ *
+ * @warning The returned root directory is a direct reference to the internal one. It must not be
+ * modified nor deallocated manually.
+ *
+ * @return The root directory the temporary directories of tests are created in.
+ */
+const char* scunit_getTemporaryDirectoryRoot();
+
+/**
+ * @brief Sets the root directory the temporary directories of tests are created in.
+ *
+ * @note See `scunit_context_getTemporaryDirectory()` for more information. A root directory on a
+ * tmpfs (e. g. `/dev/shm`) avoids hitting the real disk in I/O-heavy tests.
+ *
+ * @warning The `root` is copied internally for reasons of safety. If you pass a dynamically
+ * allocated string, you are responsible for deallocating it yourself.
+ *
+ * @param[in] root A null-terminated string for the path of the root directory to set.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setTemporaryDirectoryRoot(const char* root);
+
+/**
+ * @brief Gets whether the temporary directories of failed tests are kept for debugging.
+ *
+ * @note Temporary directories are always removed by default.
+ *
+ * @return `true` if the temporary directories of failed tests are kept, otherwise `false`.
+ */
+bool scunit_getKeepTemporaryOnFailure();
+
+/**
+ * @brief Sets whether the temporary directories of failed tests are kept for debugging.
+ *
+ * @note If enabled, the path of a kept directory is included in the message of the failed test.
+ *
+ * @param[in] keepTemporaryOnFailure Whether the temporary directories of failed tests should be
+ *                                   kept.
+ */
+void scunit_setKeepTemporaryOnFailure(bool keepTemporaryOnFailure);
+
+/**
+ * @brief Gets the minimum time the timed loop of a benchmark runs for per input size.
+ *
+ * @note The minimum time defaults to 0.1 seconds.
+ *
+ * @return The minimum time of a benchmark (in nanoseconds).
+ */
+int64_t scunit_getBenchmarkMinTime();
+
+/**
+ * @brief Sets the minimum time the timed loop of a benchmark runs for per input size.
+ *
+ * @note Longer minimum times give more stable results, while shorter ones make benchmarks usable as
+ * quick smoke tests. See `scunit_benchmark_execute()` in `<SCUnit/benchmark.h>` for more
+ * information.
+ *
+ * @param[in] minTime Minimum time of a benchmark (in nanoseconds).
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if `minTime` is not positive, otherwise
+ * `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setBenchmarkMinTime(int64_t minTime);
+
+/**
+ * @brief Gets the format the results of benchmarks are reported in.
+ *
+ * @note The benchmark format defaults to `SCUNIT_BENCHMARK_FORMAT_TEXT`.
+ *
+ * @return The current `SCUnitBenchmarkFormat`.
+ */
+SCUnitBenchmarkFormat scunit_getBenchmarkFormat();
+
+/**
+ * @brief Sets the format the results of benchmarks are reported in.
+ *
+ * @note If set to `SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON`, `scunit_executeSuites()` writes the
+ * results as a JSON document to `stdout` after executing the suites, while all other output is
+ * written to `stderr` instead, so that `stdout` can be piped into tools written for Google
+ * Benchmark. See `scunit_benchmark_writeReport()` in `<SCUnit/benchmark.h>` for more information.
+ *
+ * @param[in] format `SCUnitBenchmarkFormat` to set.
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if `format` is not a valid `SCUnitBenchmarkFormat`,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setBenchmarkFormat(SCUnitBenchmarkFormat format);
+
+/**
+ * @brief Gets the path of one of the two builds of a library compared by benchmarks.
+ *
+ * @note No libraries are compared by default.
+ *
+ * @warning The returned path is a direct reference to the internal one. It must not be modified
+ * nor deallocated manually.
+ *
+ * @param[in] index Index of the library (zero for the first and one for the second one).
+ * @return The path of the library or a `nullptr` if no libraries are compared or if `index` is out
+ *         of range.
+ */
+const char* scunit_getBenchmarkLibrary(int64_t index);
+
+/**
+ * @brief Sets the two builds of a library compared by benchmarks (A/B comparison).
+ *
+ * @note If set, every benchmark executes its body with each library in turn instead of measuring it
+ * once, resolving the symbols of the library under test by calling `scunit_benchmark_getSymbol()`.
+ * See `scunit_benchmark_execute()` in `<SCUnit/benchmark.h>` for more information. Passing two
+ * `nullptr`s disables the comparison again.
+ *
+ * @param[in] first  A null-terminated string for the path of the first (baseline) library or a
+ *                   `nullptr`.
+ * @param[in] second A null-terminated string for the path of the second library or a `nullptr`.
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if exactly one of the paths is a `nullptr`,
+ *         `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+SCUnitError scunit_setBenchmarkLibraries(const char* first, const char* second);
+
+/**
+ * @brief Gets the directory relative paths of test data files are resolved against.
+ *
+ * @note The data directory defaults to the current working directory (`.`).
+ *
+ * @warning The returned data directory is a direct reference to the internal one. It must not be
+ * modified nor deallocated manually.
+ *
+ * @return The directory relative paths of test data files are resolved against.
+ */
+const char* scunit_getDataDirectory();
+
+/**
+ * @brief Sets the directory relative paths of test data files are resolved against.
+ *
+ * @note See `scunit_data_map()` in `<SCUnit/data.h>` for more information.
+ *
+ * @warning The `directory` is copied internally for reasons of safety. If you pass a dynamically
+ * allocated string, you are responsible for deallocating it yourself.
+ *
+ * @param[in] directory A null-terminated string for the path of the data directory to set.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setDataDirectory(const char* directory);
+
+/**
+ * @brief Gets the number of times a failed test is executed again before it is considered failed.
+ *
+ * @note Failed tests are not retried by default.
+ *
+ * @return The number of retries of a failed test.
+ */
+int64_t scunit_getRetries();
+
+/**
+ * @brief Sets the number of times a failed test is executed again before it is considered failed.
+ *
+ * @note Each retry executes the test setup function, the test itself and the test teardown
+ * function again. A test that passes on a retry is reported as flaky instead of passed, together
+ * with the message of its first failure, and does not fail the run.
+ *
+ * @param[in] retries Number of retries of a failed test.
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if `retries` is negative, otherwise
+ * `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setRetries(int64_t retries);
+
+/**
+ * @brief Gets the path of the file the outcomes of tests are recorded in to track their flip rates.
+ *
+ * @note No history is recorded by default.
+ *
+ * @warning The returned path is a direct reference to the internal one. It must not be modified
+ * nor deallocated manually.
+ *
+ * @return The path of the flaky history file or a `nullptr` if no history is recorded.
+ */
+const char* scunit_getFlakyHistoryFile();
+
+/**
+ * @brief Sets the path of the file the outcomes of tests are recorded in to track their flip rates.
+ *
+ * @note The flip rate of a test is the fraction of its recorded runs in which its outcome flipped
+ * (see `scunit_flaky_record()` in `<SCUnit/flaky.h>`) and is reported for every flaky test. The
+ * file is created if it does not exist yet and updated after executing the suites.
+ *
+ * @warning The `path` is copied internally for reasons of safety. If you pass a dynamically
+ * allocated string, you are responsible for deallocating it yourself.
+ *
+ * @param[in] path A null-terminated string for the path of the history file or a `nullptr` to stop
+ *                 recording.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setFlakyHistoryFile(const char* path);
+
+/**
+ * @brief Gets the path of the file listing the quarantined tests.
+ *
+ * @note No tests are quarantined by default.
+ *
+ * @warning The returned path is a direct reference to the internal one. It must not be modified
+ * nor deallocated manually.
+ *
+ * @return The path of the quarantine file or a `nullptr` if no tests are quarantined.
+ */
+const char* scunit_getQuarantineFile();
+
+/**
+ * @brief Sets the path of the file listing the quarantined tests.
+ *
+ * @note Quarantined tests are executed (and retried) as usual, but are reported as quarantined
+ * instead of failed if they fail, so that known flaky tests do not fail the run. See
+ * `scunit_flaky_load()` in `<SCUnit/flaky.h>` for the format of the file.
+ *
+ * @warning The `path` is copied internally for reasons of safety. If you pass a dynamically
+ * allocated string, you are responsible for deallocating it yourself.
+ *
+ * @param[in] path A null-terminated string for the path of the quarantine file or a `nullptr` to
+ *                 quarantine no tests.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_setQuarantineFile(const char* path);
+
+/**
+ * @brief Determines if a test is selected by the current filter.
+ *
+ * @param[in] suiteName Name of the `SCUnitSuite` the test is registered in.
+ * @param[in] testName  Name of the test itself.
+ * @return `true` if the test is selected by the current filter, otherwise `false`.
+ */
+bool scunit_isTestSelected(const char* suiteName, const char* testName);
+
 /**
  * @brief Registers an `SCUnitSuite` to be executed automatically by SCUnit.
  *
@@ -111,6 +432,43 @@ SCUnitError scunit_setOrder(SCUnitOrder order);
  */
 SCUnitError scunit_registerSuite(SCUnitSuite* suite);
 
+/**
+ * @brief Unregisters an `SCUnitSuite` previously registered by calling `scunit_registerSuite()`.
+ *
+ * @note The relative order of the remaining registered suites is preserved.
+ *
+ * @warning Ownership of the given `SCUnitSuite` is transferred back to the caller, who is now
+ * responsible for deallocating it using `scunit_suite_free()`.
+ *
+ * @param[in] suite `SCUnitSuite` to unregister.
+ * @return `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if `suite` is not registered,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_unregisterSuite(const SCUnitSuite* suite);
+
+/**
+ * @brief Gets the number of registered suites.
+ *
+ * @return The number of suites registered by calling `scunit_registerSuite()` (directly or using
+ * the `SCUNIT_SUITE()` and `SCUNIT_PARTIAL_SUITE()` macros).
+ */
+int64_t scunit_getSuiteCount();
+
+/**
+ * @brief Gets a registered `SCUnitSuite` by its index.
+ *
+ * @note Suites are indexed in the order they were registered, starting at zero.
+ *
+ * @warning The returned `SCUnitSuite` is still owned by SCUnit. You must not deallocate it
+ * manually.
+ *
+ * @param[in] index Index of the `SCUnitSuite` to get, which must be between zero (inclusive) and
+ *                  `scunit_getSuiteCount()` (exclusive).
+ * @return The registered `SCUnitSuite` at the given index or a `nullptr` if `index` is out of
+ * range.
+ */
+SCUnitSuite* scunit_getSuite(int64_t index);
+
 /**
  * @brief Parses the command line arguments passed to the test executable.
  *
@@ -120,9 +478,9 @@ SCUnitError scunit_registerSuite(SCUnitSuite* suite);
  * It respects the current colored output state set by calling `scunit_setColoredOutput()`.
  * If currently set to `SCUNIT_COLORED_OUTPUT_NEVER`, the default color is used instead.
  *
- * Note that the program immediately exits with `EXIT_SUCCESS` if the help (`-h` or `--help`) or
- * version (`-v` or `--version`) option is present in `argv` or with `EXIT_FAILURE` if any
- * unexpected error occurs while parsing the command line arguments.
+ * Note that the program immediately exits with `EXIT_SUCCESS` if the help (`-h` or `--help`),
+ * version (`-v` or `--version`) or list (`--list-tests`) option is present in `argv` or with
+ * `EXIT_FAILURE` if any unexpected error occurs while parsing the command line arguments.
  *
  * @param[in] argc Number of command line arguments passed to the test executable.
  * @param[in] argv Command line arguments passed to the test executable.
@@ -55,6 +55,24 @@ typedef struct SCUnitSummary {
     /** @brief Number of tests that failed while executing an `SCUnitSuite`. */
     int64_t failedTests;
 
+    /**
+     * @brief Number of tests that failed at first, but passed on a retry while executing an
+     * `SCUnitSuite`.
+     *
+     * @note Flaky tests are neither counted as passed nor as failed and do not fail the run. See
+     * `scunit_setRetries()` in `<SCUnit/scunit.h>` for more information.
+     */
+    int64_t flakyTests;
+
+    /**
+     * @brief Number of quarantined tests that failed (even after all retries) while executing an
+     * `SCUnitSuite`.
+     *
+     * @note Quarantined tests are not counted as failed and do not fail the run. See
+     * `scunit_setQuarantineFile()` in `<SCUnit/scunit.h>` for more information.
+     */
+    int64_t quarantinedTests;
+
 } SCUnitSummary;
 
 /**
@@ -256,10 +274,12 @@ typedef struct SCUnitSummary {
     static void scunit_suite##suite##Test##name([[maybe_unused]] SCUnitContext* scunit_context); \
     [[gnu::constructor(103)]]                                                                    \
     static void scunit_registerSuite##suite##Test##name() {                                      \
-        SCUnitError error = scunit_suite_registerTest(                                           \
+        SCUnitError error = scunit_suite_registerTestAt(                                         \
             scunit_suite##suite,                                                                 \
             #name,                                                                               \
-            scunit_suite##suite##Test##name                                                      \
+            scunit_suite##suite##Test##name,                                                     \
+            __FILE__,                                                                            \
+            __LINE__                                                                             \
         );                                                                                       \
         if (error != SCUNIT_ERROR_NONE) {                                                        \
             scunit_fprintfc(                                                                     \
@@ -275,6 +295,26 @@ typedef struct SCUnitSummary {
     }                                                                                            \
     static void scunit_suite##suite##Test##name([[maybe_unused]] SCUnitContext* scunit_context)
 
+/**
+ * @brief Defines a section inside a test, which is reported separately with its own result and
+ * timing.
+ *
+ * @note This macro is intended to be used inside the body of a test, followed by a block
+ * (`SCUNIT_SECTION("name") { ... }`).
+ *
+ * Sections share the test setup and teardown functions, which are only called once per test. If a
+ * section fails (or is terminated early in any other way), the test is executed again from the
+ * beginning, skipping the sections already executed, so every section is executed exactly once.
+ * Code outside of any section is therefore executed again for every section left early and should
+ * be kept cheap. The test fails if any section failed.
+ *
+ * @param[in] name A null-terminated string for the name of the section.
+ */
+#define SCUNIT_SECTION(name)                                                        \
+    for (bool scunit_section = scunit_context_beginSection(scunit_context, (name)); \
+            scunit_section;                                                         \
+            scunit_section = false, scunit_context_endSection(scunit_context))
+
 /**
  * @brief Allocates and initializes a new `SCUnitSuite` with a given name.
  *
@@ -297,6 +337,54 @@ SCUnitSuite* scunit_suite_new(const char* name);
  */
 const char* scunit_suite_getName(const SCUnitSuite* suite);
 
+/**
+ * @brief Gets the number of tests registered in a given `SCUnitSuite`.
+ *
+ * @param[in] suite `SCUnitSuite` to examine.
+ * @return The number of tests registered in the given `SCUnitSuite`.
+ */
+int64_t scunit_suite_getTestCount(const SCUnitSuite* suite);
+
+/**
+ * @brief Gets the name of a test registered in a given `SCUnitSuite` by its index.
+ *
+ * @note Tests are indexed in the order they were registered, starting at zero.
+ *
+ * @warning The returned name is a direct reference to the internal name of the test. It must not
+ * be modified nor deallocated manually.
+ *
+ * @param[in] suite `SCUnitSuite` to examine.
+ * @param[in] index Index of the test, which must be between zero (inclusive) and
+ *                  `scunit_suite_getTestCount()` (exclusive).
+ * @return The name of the test at the given index or a `nullptr` if `index` is out of range.
+ */
+const char* scunit_suite_getTestName(const SCUnitSuite* suite, int64_t index);
+
+/**
+ * @brief Gets the source file a test registered in a given `SCUnitSuite` was defined in.
+ *
+ * @warning The returned file is the string passed to `scunit_suite_registerTestAt()`. It must not
+ * be modified nor deallocated manually.
+ *
+ * @param[in] suite `SCUnitSuite` to examine.
+ * @param[in] index Index of the test, which must be between zero (inclusive) and
+ *                  `scunit_suite_getTestCount()` (exclusive).
+ * @return The source file of the test at the given index or a `nullptr` if `index` is out of range
+ * or the source file is unknown.
+ */
+const char* scunit_suite_getTestFile(const SCUnitSuite* suite, int64_t index);
+
+/**
+ * @brief Gets the line a test registered in a given `SCUnitSuite` was defined at.
+ *
+ * @param[in] suite `SCUnitSuite` to examine.
+ * @param[in] index Index of the test, which must be between zero (inclusive) and
+ *                  `scunit_suite_getTestCount()` (exclusive).
+ * @return The line of the test at the given index or zero if `index` is out of range or the line
+ * is unknown.
+ */
+int64_t scunit_suite_getTestLine(const SCUnitSuite* suite, int64_t index);
+
 /**
  * @brief Sets a suite setup function for a given `SCUnitSuite`.
  *
@@ -365,6 +453,35 @@ SCUnitError scunit_suite_registerTest(
     SCUnitTestFunction testFunction
 );
 
+/**
+ * @brief Registers a test function defined at a given source location to be executed as part of a
+ * given `SCUnitSuite`.
+ *
+ * @note This function behaves exactly like `scunit_suite_registerTest()`, but additionally records
+ * where the test was defined (e. g. for listing tests using `--list-tests`). It is used by the
+ * `SCUNIT_TEST()` macro, which passes `__FILE__` and `__LINE__`.
+ *
+ * @warning The `name` is copied internally for reasons of safety. The `file`, on the other hand,
+ * is only referenced and must therefore remain valid as long as the test is registered (which is
+ * the case for string literals like `__FILE__`).
+ *
+ * @param[in, out] suite        `SCUnitSuite` to register the `SCUnitTestFunction` for.
+ * @param[in]      name         A null-terminated string for the name of the test.
+ * @param[in]      testFunction `SCUnitTestFunction` to register.
+ * @param[in]      file         A null-terminated string for the source file the test is defined
+ *                              in or a `nullptr` if unknown.
+ * @param[in]      line         Line the test is defined at or zero if unknown.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_suite_registerTestAt(
+    SCUnitSuite* suite,
+    const char* name,
+    SCUnitTestFunction testFunction,
+    const char* file,
+    int64_t line
+);
+
 /**
  * @brief Executes a given `SCUnitSuite`.
  *
@@ -376,6 +493,8 @@ SCUnitError scunit_suite_registerTest(
  * If currently set to `SCUNIT_COLORED_OUTPUT_NEVER`, the default color is used instead.
  * See `<SCUnit/scunit.h>` for more information.
  *
+ * Only tests selected by the current filter (see `scunit_setFilter()`) are executed.
+ *
  * @param[in]  suite   `SCUnitSuite` to execute.
  * @param[out] summary An `SCUnitSummary` produced as the result.
  * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
@@ -387,6 +506,17 @@ SCUnitError scunit_suite_registerTest(
  */
 SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summary);
 
+/**
+ * @brief Calls the function of a test.
+ *
+ * @note This function is intended for internal use by `scunit_suite_execute()`. It is never
+ * inlined, since backtraces of failures are trimmed at its frame (see `<SCUnit/backtrace.h>`).
+ *
+ * @param[in]      testFunction Function of the test to call.
+ * @param[in, out] context      `SCUnitContext` to pass to the function.
+ */
+void scunit_suite_callTest(SCUnitTestFunction testFunction, SCUnitContext* context);
+
 /**
  * @brief Deallocates a given `SCUnitSuite`.
  *
@@ -0,0 +1,189 @@
+#ifndef SCUNIT_TABLE_H
+#define SCUNIT_TABLE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <SCUnit/context.h>
+#include <SCUnit/error.h>
+#include <SCUnit/print.h>
+#include <SCUnit/suite.h>
+
+/**
+ * @brief Represents a read-only view of a single field of a row.
+ *
+ * @note The text is not null-terminated. It points directly into the mapped test data file, so
+ * quotes are stripped, but escape sequences (`""` in CSV, `\` in JSON strings) are kept as they
+ * appear in the file. Use `%.*s` to print a field.
+ */
+typedef struct SCUnitField {
+
+    /** @brief Pointer to the first character of the field or `nullptr` if the field is missing. */
+    const char* text;
+
+    /** @brief Length of the field (in characters). */
+    int64_t length;
+
+} SCUnitField;
+
+/** @brief Represents a single row of a test data file executed as a sub-case of a test. */
+typedef struct SCUnitRow SCUnitRow;
+
+/**
+ * @brief Represents a function executed once per row of a test data file.
+ *
+ * @param[in, out] scunit_context `SCUnitContext` storing important information about the test.
+ * @param[in]      scunit_row     `SCUnitRow` to execute the function for.
+ */
+typedef void (*SCUnitRowFunction)(
+    [[maybe_unused]] SCUnitContext* scunit_context,
+    [[maybe_unused]] const SCUnitRow* scunit_row
+);
+
+/**
+ * @brief Defines and registers a table-driven test to be executed as part of an `SCUnitSuite` with
+ * a given name.
+ *
+ * @note This macro is intended to be used at file scope and after defining an `SCUnitSuite` with
+ * `SCUNIT_SUITE()` or `SCUNIT_PARTIAL_SUITE()`.
+ *
+ * The body of the test is executed once for every row of the test data file, which can access the
+ * row through `scunit_row`. See `scunit_table_execute()` for how the file is read.
+ *
+ * @attention If an unexpected error occurs while defining, registering or executing the test, an
+ * error message is written to `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] suite Name of the `SCUnitSuite` to define and register the test for.
+ * @param[in] name  Name of the test itself.
+ * @param[in] path  A null-terminated string for the path of the test data file (`.csv` or
+ *                  `.jsonl`).
+ */
+#define SCUNIT_TEST_TABLE(suite, name, path)                                                     \
+    static void scunit_suite##suite##Test##name##Row(                                            \
+        [[maybe_unused]] SCUnitContext* scunit_context,                                          \
+        [[maybe_unused]] const SCUnitRow* scunit_row                                             \
+    );                                                                                           \
+    SCUNIT_TEST(suite, name) {                                                                   \
+        SCUnitError scunit_error = scunit_table_execute(                                         \
+            scunit_context,                                                                      \
+            (path),                                                                              \
+            scunit_suite##suite##Test##name##Row                                                 \
+        );                                                                                       \
+        if (scunit_error != SCUNIT_ERROR_NONE) {                                                 \
+            scunit_fprintfc(                                                                     \
+                stderr,                                                                          \
+                SCUNIT_COLOR_DARK_RED,                                                           \
+                SCUNIT_COLOR_DARK_DEFAULT,                                                       \
+                "An unexpected error occurred while executing the rows of the test %s "          \
+                    "(code %d).\n",                                                              \
+                #name,                                                                           \
+                scunit_error                                                                     \
+            );                                                                                   \
+            exit(EXIT_FAILURE);                                                                  \
+        }                                                                                        \
+    }                                                                                            \
+    static void scunit_suite##suite##Test##name##Row(                                            \
+        [[maybe_unused]] SCUnitContext* scunit_context,                                          \
+        [[maybe_unused]] const SCUnitRow* scunit_row                                             \
+    )
+
+/**
+ * @brief Executes a function once for every row of a test data file.
+ *
+ * @note This function is intended for internal use by `SCUNIT_TEST_TABLE()`. The file is mapped
+ * using `scunit_data_map()` (so relative paths are resolved against the data directory) and
+ * tokenized lazily, one row at a time, so even files with millions of rows start executing
+ * immediately and are never copied. The format is chosen by the extension of the path:
+ *
+ * - `.csv`: The first row names the columns. Fields are separated by commas and may be quoted
+ *   (`"..."`), in which case they may contain commas, doubled quotes and line breaks.
+ * - `.jsonl` (or any other extension): Every line is a flat JSON object. Values are strings,
+ *   numbers, booleans, `null` or nested arrays and objects, which are returned as raw text.
+ *
+ * Empty lines are ignored. Each row is executed as a sub-case: Every row is executed even if an
+ * earlier one failed (up to a maximum number of failed rows), and every failed row is reported
+ * with its row and line number. The test fails if any row failed and is skipped if every row was
+ * skipped. If the file cannot be mapped or a row is malformed, the test fails as well.
+ *
+ * @param[in, out] context  `SCUnitContext` of the test.
+ * @param[in]      path     A null-terminated string for the path of the test data file.
+ * @param[in]      function Function to execute for every row.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+SCUnitError scunit_table_execute(
+    SCUnitContext* context,
+    const char* path,
+    SCUnitRowFunction function
+);
+
+/**
+ * @brief Calls the function of a table-driven test for a single row.
+ *
+ * @note This function is intended for internal use by `scunit_table_execute()`. Like
+ * `scunit_suite_callTest()`, it marks the frame at which backtraces of failures are trimmed.
+ *
+ * @param[in]      function Function to call.
+ * @param[in, out] context  `SCUnitContext` to pass to the function.
+ * @param[in]      row      `SCUnitRow` to pass to the function.
+ */
+void scunit_table_callRow(SCUnitRowFunction function, SCUnitContext* context, const SCUnitRow* row);
+
+/**
+ * @brief Gets the number of a given `SCUnitRow`.
+ *
+ * @note Rows are numbered starting at one, not counting the header of a CSV file or empty lines.
+ *
+ * @param[in] row `SCUnitRow` to get the number of.
+ * @return The number of the `SCUnitRow`.
+ */
+int64_t scunit_row_getNumber(const SCUnitRow* row);
+
+/**
+ * @brief Gets the number of fields of a given `SCUnitRow`.
+ *
+ * @param[in] row `SCUnitRow` to get the number of fields of.
+ * @return The number of fields of the `SCUnitRow`.
+ */
+int64_t scunit_row_getFieldCount(const SCUnitRow* row);
+
+/**
+ * @brief Gets the field of a given `SCUnitRow` at a given index.
+ *
+ * @param[in] row   `SCUnitRow` to get the field of.
+ * @param[in] index Index of the field (in the order of the columns or keys in the file).
+ * @return The field at the index or a field with a `nullptr` as its text if the index is out of
+ *         range.
+ */
+SCUnitField scunit_row_getFieldAt(const SCUnitRow* row, int64_t index);
+
+/**
+ * @brief Gets the field of a given `SCUnitRow` with a given name.
+ *
+ * @param[in] row  `SCUnitRow` to get the field of.
+ * @param[in] name A null-terminated string for the name of the column (CSV) or key (JSONL).
+ * @return The field with the name or a field with a `nullptr` as its text if the row has no such
+ *         field.
+ */
+SCUnitField scunit_row_getField(const SCUnitRow* row, const char* name);
+
+/**
+ * @brief Determines whether a given field is equal to a given string.
+ *
+ * @param[in] field  Field to compare.
+ * @param[in] string A null-terminated string to compare the field to.
+ * @return `true` if the field is present and equal to the string, otherwise `false`.
+ */
+bool scunit_field_equals(SCUnitField field, const char* string);
+
+/**
+ * @brief Converts a given field to an integer.
+ *
+ * @param[in]  field Field to convert, consisting of an optional sign followed by decimal digits.
+ * @param[out] error `SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE` if the field is missing, not an integer or
+ *                   does not fit into an `int64_t`, otherwise `SCUNIT_ERROR_NONE`.
+ * @return The integer on success, otherwise zero.
+ */
+int64_t scunit_field_toInteger(SCUnitField field, SCUnitError* error);
+
+#endif
\ No newline at end of file
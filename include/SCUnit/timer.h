@@ -126,6 +126,18 @@ SCUnitMeasurement scunit_timer_getWallTime(const SCUnitTimer* timer, SCUnitError
  */
 SCUnitMeasurement scunit_timer_getCPUTime(const SCUnitTimer* timer, SCUnitError* error);
 
+/**
+ * @brief Converts an elapsed time in seconds to an `SCUnitMeasurement` with an appropriate
+ * `SCUnitTimeUnit`.
+ *
+ * @note This is the same conversion applied to the times measured by an `SCUnitTimer`, which is
+ * useful for printing durations measured in other ways (e. g. by a benchmark) consistently.
+ *
+ * @param[in] seconds Elapsed time to convert (in seconds).
+ * @return An `SCUnitMeasurement` for the elapsed time.
+ */
+SCUnitMeasurement scunit_timer_toMeasurement(double seconds);
+
 /**
  * @brief Deallocates a given `SCUnitTimer`.
  *
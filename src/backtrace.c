@@ -0,0 +1,1272 @@
+#define _GNU_SOURCE
+
+#include <elf.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <link.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <SCUnit/backtrace.h>
+#include <SCUnit/benchmark.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/schedule.h>
+#include <SCUnit/suite.h>
+#include <SCUnit/table.h>
+
+/** @brief Maximum number of frames captured by `scunit_backtrace_append()`. */
+static constexpr int32_t MAX_FRAMES = 64;
+
+/**
+ * @brief Functions of SCUnit that call the code of a test.
+ *
+ * @note A backtrace is trimmed at the first frame in one of these functions, since the frames
+ * from there on are the same for every test. They are recognized by their address range, so a
+ * function of the test executable with the same name is never mistaken for one of them.
+ */
+static void (* const BOUNDARY_FUNCTIONS[])() = {
+    (void (*)()) scunit_suite_callTest,
+    (void (*)()) scunit_schedule_callThread,
+    (void (*)()) scunit_table_callRow,
+    (void (*)()) scunit_benchmark_callBody
+};
+
+/** @brief DWARF standard opcodes of a line number program. */
+enum {
+    DW_LNS_COPY = 0x01,
+    DW_LNS_ADVANCE_PC = 0x02,
+    DW_LNS_ADVANCE_LINE = 0x03,
+    DW_LNS_SET_FILE = 0x04,
+    DW_LNS_CONST_ADD_PC = 0x08,
+    DW_LNS_FIXED_ADVANCE_PC = 0x09
+};
+
+/** @brief DWARF extended opcodes of a line number program. */
+enum {
+    DW_LNE_END_SEQUENCE = 0x01,
+    DW_LNE_SET_ADDRESS = 0x02
+};
+
+/** @brief DWARF content types of a directory or file name entry (version 5). */
+enum {
+    DW_LNCT_PATH = 0x01,
+    DW_LNCT_DIRECTORY_INDEX = 0x02
+};
+
+/** @brief DWARF attribute forms that may occur in a directory or file name entry (version 5). */
+enum {
+    DW_FORM_DATA2 = 0x05,
+    DW_FORM_DATA4 = 0x06,
+    DW_FORM_DATA8 = 0x07,
+    DW_FORM_STRING = 0x08,
+    DW_FORM_BLOCK = 0x09,
+    DW_FORM_DATA1 = 0x0b,
+    DW_FORM_STRP = 0x0e,
+    DW_FORM_UDATA = 0x0f,
+    DW_FORM_DATA16 = 0x1e,
+    DW_FORM_LINE_STRP = 0x1f
+};
+
+/** @brief Represents a function symbol of a module. */
+typedef struct Symbol {
+
+    /** @brief Link-time address of the symbol. */
+    uintptr_t address;
+
+    /** @brief Size of the symbol (in bytes) or zero if it is unknown. */
+    uintptr_t size;
+
+    /** @brief A null-terminated string for the name of the symbol. */
+    const char* name;
+
+} Symbol;
+
+/** @brief Represents a row of the line table of a module. */
+typedef struct LineRow {
+
+    /** @brief Link-time address of the first instruction of the row. */
+    uintptr_t address;
+
+    /** @brief Index of the row in the order it was emitted by the line number program. */
+    int64_t index;
+
+    /** @brief Index of the file name of the row or `-1` if it is unknown. */
+    int64_t file;
+
+    /** @brief Line of the row. */
+    int64_t line;
+
+    /** @brief Whether the row marks the first address after the end of a sequence. */
+    bool isEndOfSequence;
+
+} LineRow;
+
+/** @brief Represents a module (the executable or a shared library) with its parsed tables. */
+typedef struct Module {
+
+    /** @brief A null-terminated string for the path of the module. */
+    char* path;
+
+    /** @brief Difference between the load-time and link-time addresses of the module. */
+    uintptr_t bias;
+
+    /** @brief Device of the module file when it was loaded. */
+    dev_t device;
+
+    /** @brief Inode of the module file when it was loaded. */
+    ino_t inode;
+
+    /** @brief Last modification of the module file when it was loaded. */
+    struct timespec modification;
+
+    /** @brief Memory-mapped image of the module file or a `nullptr` if mapping it failed. */
+    const uint8_t* image;
+
+    /** @brief Size of the memory-mapped image (in bytes). */
+    size_t imageSize;
+
+    /** @brief Function symbols of the module, sorted by their address. */
+    Symbol* symbols;
+
+    /** @brief Number of function symbols of the module. */
+    int64_t symbolCount;
+
+    /** @brief Rows of the line table of the module, sorted by their address. */
+    LineRow* rows;
+
+    /** @brief Number of rows of the line table of the module. */
+    int64_t rowCount;
+
+    /** @brief Capacity of the rows of the line table of the module. */
+    int64_t rowCapacity;
+
+    /** @brief Dynamically allocated file names referenced by the rows of the line table. */
+    char** fileNames;
+
+    /** @brief Number of file names referenced by the rows of the line table. */
+    int64_t fileNameCount;
+
+    /** @brief Capacity of the file names referenced by the rows of the line table. */
+    int64_t fileNameCapacity;
+
+    /** @brief Next cached module or a `nullptr` if there is none. */
+    struct Module* next;
+
+} Module;
+
+/** @brief Represents a bounds-checked cursor into a section of a module. */
+typedef struct Cursor {
+
+    /** @brief Current position of the cursor. */
+    const uint8_t* position;
+
+    /** @brief End of the section the cursor moves in. */
+    const uint8_t* end;
+
+    /** @brief Whether all reads so far stayed within the section. */
+    bool isValid;
+
+} Cursor;
+
+/** @brief Represents the result of looking up the module containing an address. */
+typedef struct ModuleQuery {
+
+    /** @brief Address to look up. */
+    uintptr_t address;
+
+    /** @brief A null-terminated string for the name of the module found (if any). */
+    const char* name;
+
+    /** @brief Difference between the load-time and link-time addresses of the module found. */
+    uintptr_t bias;
+
+    /** @brief Whether a module containing the address was found. */
+    bool isFound;
+
+} ModuleQuery;
+
+/** @brief Cached modules, which are parsed on first use and kept until the process exits. */
+static Module* modules;
+
+/** @brief Mutex guarding the cached modules. */
+static pthread_mutex_t modulesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Reads a given number of bytes from a `Cursor`.
+ *
+ * @param[in, out] cursor `Cursor` to read from.
+ * @param[in]      size   Number of bytes to read.
+ * @return A pointer to the bytes read or a `nullptr` if they exceed the section.
+ */
+static const uint8_t* readBytes(Cursor* cursor, uint64_t size) {
+    if (!cursor->isValid || (size > (uint64_t) (cursor->end - cursor->position))) {
+        cursor->isValid = false;
+        return nullptr;
+    }
+    const uint8_t* bytes = cursor->position;
+    cursor->position += size;
+    return bytes;
+}
+
+/**
+ * @brief Reads an unsigned little-endian integer of a given size from a `Cursor`.
+ *
+ * @param[in, out] cursor `Cursor` to read from.
+ * @param[in]      size   Size of the integer (in bytes, at most eight).
+ * @return The integer read or zero if it exceeds the section.
+ */
+static uint64_t readUnsigned(Cursor* cursor, int32_t size) {
+    const uint8_t* bytes = readBytes(cursor, size);
+    if (bytes == nullptr) {
+        return 0;
+    }
+    uint64_t value = 0;
+    for (int32_t i = size - 1; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+/**
+ * @brief Reads an unsigned LEB128 integer from a `Cursor`.
+ *
+ * @param[in, out] cursor `Cursor` to read from.
+ * @return The integer read or zero if it exceeds the section.
+ */
+static uint64_t readUleb128(Cursor* cursor) {
+    uint64_t value = 0;
+    int32_t shift = 0;
+    const uint8_t* byte;
+    do {
+        byte = readBytes(cursor, 1);
+        if (byte == nullptr) {
+            return 0;
+        }
+        if (shift < 64) {
+            value |= ((uint64_t) (*byte & 0x7f)) << shift;
+        }
+        shift += 7;
+    }
+    while ((*byte & 0x80) != 0);
+    return value;
+}
+
+/**
+ * @brief Reads a signed LEB128 integer from a `Cursor`.
+ *
+ * @param[in, out] cursor `Cursor` to read from.
+ * @return The integer read or zero if it exceeds the section.
+ */
+static int64_t readSleb128(Cursor* cursor) {
+    uint64_t value = 0;
+    int32_t shift = 0;
+    const uint8_t* byte;
+    do {
+        byte = readBytes(cursor, 1);
+        if (byte == nullptr) {
+            return 0;
+        }
+        if (shift < 64) {
+            value |= ((uint64_t) (*byte & 0x7f)) << shift;
+        }
+        shift += 7;
+    }
+    while ((*byte & 0x80) != 0);
+    if ((shift < 64) && ((*byte & 0x40) != 0)) {
+        value |= ~((uint64_t) 0) << shift;
+    }
+    return (int64_t) value;
+}
+
+/**
+ * @brief Reads a null-terminated string from a `Cursor`.
+ *
+ * @param[in, out] cursor `Cursor` to read from.
+ * @return The string read or a `nullptr` if it exceeds the section.
+ */
+static const char* readString(Cursor* cursor) {
+    if (!cursor->isValid) {
+        return nullptr;
+    }
+    const uint8_t* terminator = memchr(cursor->position, '\0', cursor->end - cursor->position);
+    if (terminator == nullptr) {
+        cursor->isValid = false;
+        return nullptr;
+    }
+    const char* string = (const char*) cursor->position;
+    cursor->position = terminator + 1;
+    return string;
+}
+
+/**
+ * @brief Returns a null-terminated string at a given offset into a string section.
+ *
+ * @param[in] section Cursor spanning the string section.
+ * @param[in] offset  Offset of the string.
+ * @return The string at the given offset or a `nullptr` if it exceeds the section.
+ */
+static const char* getString(Cursor section, uint64_t offset) {
+    if ((section.position == nullptr) || (offset >= (uint64_t) (section.end - section.position))) {
+        return nullptr;
+    }
+    section.position += offset;
+    return readString(&section);
+}
+
+/**
+ * @brief Returns a cursor spanning a given section of a module.
+ *
+ * @param[in] module Module containing the section.
+ * @param[in] header Header of the section.
+ * @return A cursor spanning the section, which is invalid if the section exceeds the module image,
+ *         has no contents in the file or is compressed.
+ */
+static Cursor getSection(const Module* module, const ElfW(Shdr)* header) {
+    Cursor cursor = { };
+    if ((header->sh_type == SHT_NOBITS) || ((header->sh_flags & SHF_COMPRESSED) != 0)
+        || (header->sh_offset > module->imageSize)
+        || (header->sh_size > module->imageSize - header->sh_offset)) {
+        return cursor;
+    }
+    cursor.position = module->image + header->sh_offset;
+    cursor.end = cursor.position + header->sh_size;
+    cursor.isValid = true;
+    return cursor;
+}
+
+/**
+ * @brief Compares two symbols by their address.
+ *
+ * @param[in] first  First symbol to compare.
+ * @param[in] second Second symbol to compare.
+ * @return A negative value, zero or a positive value if the first symbol is located before, at or
+ *         after the second one.
+ */
+static int compareSymbols(const void* first, const void* second) {
+    const Symbol* firstSymbol = first;
+    const Symbol* secondSymbol = second;
+    if (firstSymbol->address != secondSymbol->address) {
+        return (firstSymbol->address < secondSymbol->address) ? -1 : 1;
+    }
+    // Prefer sized symbols over aliases without a size at the same address.
+    return (firstSymbol->size > secondSymbol->size) ? -1 : (firstSymbol->size < secondSymbol->size);
+}
+
+/**
+ * @brief Compares two rows of a line table by their address.
+ *
+ * @note At the same address, the end of one sequence is ordered before the rows of the next one
+ * and rows of the same sequence are kept in the order they were emitted in.
+ *
+ * @param[in] first  First row to compare.
+ * @param[in] second Second row to compare.
+ * @return A negative value, zero or a positive value if the first row is ordered before, equal to
+ *         or after the second one.
+ */
+static int compareLineRows(const void* first, const void* second) {
+    const LineRow* firstRow = first;
+    const LineRow* secondRow = second;
+    if (firstRow->address != secondRow->address) {
+        return (firstRow->address < secondRow->address) ? -1 : 1;
+    }
+    if (firstRow->isEndOfSequence != secondRow->isEndOfSequence) {
+        return firstRow->isEndOfSequence ? -1 : 1;
+    }
+    return (firstRow->index < secondRow->index) ? -1 : (firstRow->index > secondRow->index);
+}
+
+/**
+ * @brief Loads the function symbols of a module from its symbol table.
+ *
+ * @note The static symbol table (`.symtab`) is preferred, since it also contains functions with
+ * internal linkage. If the module is stripped, the dynamic symbol table (`.dynsym`) is used.
+ *
+ * @param[in, out] module   Module to load the symbols of.
+ * @param[in]      sections Section headers of the module.
+ * @param[in]      count    Number of section headers of the module.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError loadSymbols(Module* module, const ElfW(Shdr)* sections, int64_t count) {
+    const ElfW(Shdr)* symbolTable = nullptr;
+    for (int64_t i = 0; i < count; i++) {
+        if (sections[i].sh_type == SHT_SYMTAB) {
+            symbolTable = &sections[i];
+            break;
+        }
+        if ((sections[i].sh_type == SHT_DYNSYM) && (symbolTable == nullptr)) {
+            symbolTable = &sections[i];
+        }
+    }
+    if ((symbolTable == nullptr) || (symbolTable->sh_link >= count)) {
+        return SCUNIT_ERROR_NONE;
+    }
+    Cursor symbols = getSection(module, symbolTable);
+    Cursor names = getSection(module, &sections[symbolTable->sh_link]);
+    if (!symbols.isValid || !names.isValid) {
+        return SCUNIT_ERROR_NONE;
+    }
+    int64_t capacity = (symbols.end - symbols.position) / sizeof(ElfW(Sym));
+    if (capacity == 0) {
+        return SCUNIT_ERROR_NONE;
+    }
+    module->symbols = SCUNIT_MALLOC(capacity * sizeof(Symbol));
+    if (module->symbols == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    for (int64_t i = 0; i < capacity; i++) {
+        ElfW(Sym) symbol;
+        memcpy(&symbol, symbols.position + (i * sizeof(ElfW(Sym))), sizeof(ElfW(Sym)));
+        int type = ELF64_ST_TYPE(symbol.st_info);
+        if (((type != STT_FUNC) && (type != STT_GNU_IFUNC)) || (symbol.st_shndx == SHN_UNDEF)
+            || (symbol.st_value == 0)) {
+            continue;
+        }
+        const char* name = getString(names, symbol.st_name);
+        if ((name == nullptr) || (*name == '\0')) {
+            continue;
+        }
+        module->symbols[module->symbolCount++] = (Symbol) {
+            .address = symbol.st_value,
+            .size = symbol.st_size,
+            .name = name
+        };
+    }
+    qsort(module->symbols, module->symbolCount, sizeof(Symbol), compareSymbols);
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Adds a file name of a line number program to a module.
+ *
+ * @note Files in the compilation directory (with a directory index of zero) are shown as they
+ * were passed to the compiler, while all other files are prefixed with their directory.
+ *
+ * @param[in, out] module    Module to add the file name to.
+ * @param[in]      directory A null-terminated string for the directory of the file or a `nullptr`
+ *                           if it is the compilation directory.
+ * @param[in]      name      A null-terminated string for the name of the file.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError addFileName(Module* module, const char* directory, const char* name) {
+    if (module->fileNameCount == module->fileNameCapacity) {
+        int64_t newCapacity = (module->fileNameCapacity > 0) ? 2 * module->fileNameCapacity : 64;
+        char** newFileNames = SCUNIT_REALLOC(module->fileNames, newCapacity * sizeof(char*));
+        if (newFileNames == nullptr) {
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+        module->fileNames = newFileNames;
+        module->fileNameCapacity = newCapacity;
+    }
+    if ((name[0] == '/') || (directory == nullptr) || (*directory == '\0')) {
+        directory = "";
+    }
+    size_t directoryLength = strlen(directory);
+    size_t nameLength = strlen(name);
+    char* fileName = SCUNIT_MALLOC(directoryLength + nameLength + 2);
+    if (fileName == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    memcpy(fileName, directory, directoryLength);
+    if (directoryLength > 0) {
+        fileName[directoryLength++] = '/';
+    }
+    memcpy(fileName + directoryLength, name, nameLength + 1);
+    module->fileNames[module->fileNameCount++] = fileName;
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Adds a row to the line table of a module.
+ *
+ * @param[in, out] module Module to add the row to.
+ * @param[in]      row    Row to add.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError addLineRow(Module* module, LineRow row) {
+    if (module->rowCount == module->rowCapacity) {
+        int64_t newCapacity = (module->rowCapacity > 0) ? 2 * module->rowCapacity : 1024;
+        LineRow* newRows = SCUNIT_REALLOC(module->rows, newCapacity * sizeof(LineRow));
+        if (newRows == nullptr) {
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+        module->rows = newRows;
+        module->rowCapacity = newCapacity;
+    }
+    row.index = module->rowCount;
+    module->rows[module->rowCount++] = row;
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Reads the value of an attribute of a directory or file name entry (version 5).
+ *
+ * @param[in, out] cursor        Cursor to read from.
+ * @param[in]      form          Form of the attribute.
+ * @param[in]      offsetSize    Size of section offsets (in bytes).
+ * @param[in]      strings       Cursor spanning the `.debug_str` section.
+ * @param[in]      lineStrings   Cursor spanning the `.debug_line_str` section.
+ * @param[out]     string        Value of the attribute if it is a string, otherwise a `nullptr`.
+ * @return The value of the attribute if it is a constant, otherwise zero. If the form is not
+ *         supported, the cursor is invalidated.
+ */
+static uint64_t readAttribute(
+    Cursor* cursor,
+    uint64_t form,
+    int32_t offsetSize,
+    Cursor strings,
+    Cursor lineStrings,
+    const char** string
+) {
+    *string = nullptr;
+    switch (form) {
+        case DW_FORM_STRING:
+            *string = readString(cursor);
+            return 0;
+        case DW_FORM_STRP:
+            *string = getString(strings, readUnsigned(cursor, offsetSize));
+            return 0;
+        case DW_FORM_LINE_STRP:
+            *string = getString(lineStrings, readUnsigned(cursor, offsetSize));
+            return 0;
+        case DW_FORM_UDATA:
+            return readUleb128(cursor);
+        case DW_FORM_DATA1:
+            return readUnsigned(cursor, 1);
+        case DW_FORM_DATA2:
+            return readUnsigned(cursor, 2);
+        case DW_FORM_DATA4:
+            return readUnsigned(cursor, 4);
+        case DW_FORM_DATA8:
+            return readUnsigned(cursor, 8);
+        case DW_FORM_DATA16:
+            readBytes(cursor, 16);
+            return 0;
+        case DW_FORM_BLOCK:
+            readBytes(cursor, readUleb128(cursor));
+            return 0;
+        default:
+            cursor->isValid = false;
+            return 0;
+    }
+}
+
+/**
+ * @brief Reads the directory and file name tables of a line number program header (version 5).
+ *
+ * @param[in, out] module      Module to add the file names to.
+ * @param[in, out] cursor      Cursor positioned at the directory entry format.
+ * @param[in]      offsetSize  Size of section offsets (in bytes).
+ * @param[in]      strings     Cursor spanning the `.debug_str` section.
+ * @param[in]      lineStrings Cursor spanning the `.debug_line_str` section.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`. If the tables are malformed, the cursor is invalidated.
+ */
+static SCUnitError readEntryTables(
+    Module* module,
+    Cursor* cursor,
+    int32_t offsetSize,
+    Cursor strings,
+    Cursor lineStrings
+) {
+    const char** directories = nullptr;
+    uint64_t directoryCount = 0;
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    // The directory table comes first and has the same layout as the file name table that follows.
+    for (int32_t table = 0; (table < 2) && cursor->isValid; table++) {
+        uint64_t formatCount = readUnsigned(cursor, 1);
+        Cursor format = *cursor;
+        for (uint64_t i = 0; i < 2 * formatCount; i++) {
+            readUleb128(cursor);
+        }
+        uint64_t entryCount = readUleb128(cursor);
+        if (!cursor->isValid || (entryCount > (uint64_t) (cursor->end - cursor->position))) {
+            cursor->isValid = false;
+            break;
+        }
+        if ((table == 0) && (entryCount > 0)) {
+            directories = SCUNIT_CALLOC(entryCount, sizeof(const char*));
+            if (directories == nullptr) {
+                return SCUNIT_ERROR_OUT_OF_MEMORY;
+            }
+            directoryCount = entryCount;
+        }
+        for (uint64_t i = 0; (i < entryCount) && cursor->isValid; i++) {
+            const char* path = nullptr;
+            uint64_t directoryIndex = 0;
+            Cursor entryFormat = format;
+            for (uint64_t j = 0; j < formatCount; j++) {
+                uint64_t contentType = readUleb128(&entryFormat);
+                uint64_t form = readUleb128(&entryFormat);
+                const char* string;
+                uint64_t value = readAttribute(
+                    cursor,
+                    form,
+                    offsetSize,
+                    strings,
+                    lineStrings,
+                    &string
+                );
+                if (contentType == DW_LNCT_PATH) {
+                    path = string;
+                }
+                else if (contentType == DW_LNCT_DIRECTORY_INDEX) {
+                    directoryIndex = value;
+                }
+            }
+            if (table == 0) {
+                directories[i] = path;
+                continue;
+            }
+            const char* directory = ((directoryIndex > 0) && (directoryIndex < directoryCount))
+                ? directories[directoryIndex]
+                : nullptr;
+            error = addFileName(module, directory, (path != nullptr) ? path : "<unknown>");
+            if (error != SCUNIT_ERROR_NONE) {
+                goto finished;
+            }
+        }
+    }
+finished:
+    SCUNIT_FREE(directories);
+    return error;
+}
+
+/**
+ * @brief Reads the directory and file name tables of a line number program header (versions 2 to
+ * 4).
+ *
+ * @param[in, out] module Module to add the file names to.
+ * @param[in, out] cursor Cursor positioned at the include directories.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`. If the tables are malformed, the cursor is invalidated.
+ */
+static SCUnitError readLegacyEntryTables(Module* module, Cursor* cursor) {
+    // The include directories are only walked once here and looked up again for every file, since
+    // there are usually just a few of them.
+    Cursor directories = *cursor;
+    uint64_t directoryCount = 0;
+    for (const char* directory = readString(cursor); (directory != nullptr) && (*directory != '\0');
+        directory = readString(cursor)) {
+        directoryCount++;
+    }
+    for (const char* name = readString(cursor); (name != nullptr) && (*name != '\0');
+        name = readString(cursor)) {
+        uint64_t directoryIndex = readUleb128(cursor);
+        readUleb128(cursor);
+        readUleb128(cursor);
+        const char* directory = nullptr;
+        if ((directoryIndex > 0) && (directoryIndex <= directoryCount)) {
+            Cursor entry = directories;
+            for (uint64_t i = 0; i < directoryIndex; i++) {
+                directory = readString(&entry);
+            }
+        }
+        SCUnitError error = addFileName(module, directory, name);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Executes the line number program of a single unit and adds the resulting rows to the
+ * line table of a module.
+ *
+ * @param[in, out] module      Module to add the rows to.
+ * @param[in, out] cursor      Cursor positioned at the start of the unit.
+ * @param[in]      strings     Cursor spanning the `.debug_str` section.
+ * @param[in]      lineStrings Cursor spanning the `.debug_line_str` section.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`. If the unit is malformed or uses an unsupported version, the cursor
+ *         is invalidated.
+ */
+static SCUnitError readLineUnit(
+    Module* module,
+    Cursor* cursor,
+    Cursor strings,
+    Cursor lineStrings
+) {
+    int32_t offsetSize = 4;
+    uint64_t unitLength = readUnsigned(cursor, 4);
+    if (unitLength == 0xffffffff) {
+        offsetSize = 8;
+        unitLength = readUnsigned(cursor, 8);
+    }
+    Cursor unit = *cursor;
+    if (readBytes(cursor, unitLength) == nullptr) {
+        return SCUNIT_ERROR_NONE;
+    }
+    unit.end = cursor->position;
+    uint64_t version = readUnsigned(&unit, 2);
+    if ((version < 2) || (version > 5)) {
+        return SCUNIT_ERROR_NONE;
+    }
+    if (version >= 5) {
+        // The address size and segment selector size are implied by the module itself.
+        readUnsigned(&unit, 1);
+        readUnsigned(&unit, 1);
+    }
+    uint64_t headerLength = readUnsigned(&unit, offsetSize);
+    Cursor program = unit;
+    if (readBytes(&program, headerLength) == nullptr) {
+        return SCUNIT_ERROR_NONE;
+    }
+    uint64_t minimumInstructionLength = readUnsigned(&unit, 1);
+    // The maximum number of operations per instruction (since version 4) only matters for VLIW
+    // architectures and whether a row is a statement is irrelevant for symbolizing, so both are
+    // skipped.
+    if (version >= 4) {
+        readUnsigned(&unit, 1);
+    }
+    readUnsigned(&unit, 1);
+    int64_t lineBase = (int8_t) readUnsigned(&unit, 1);
+    uint64_t lineRange = readUnsigned(&unit, 1);
+    uint64_t opcodeBase = readUnsigned(&unit, 1);
+    const uint8_t* opcodeLengths = readBytes(&unit, (opcodeBase > 0) ? opcodeBase - 1 : 0);
+    if (!unit.isValid || (lineRange == 0) || (opcodeBase == 0)) {
+        return SCUNIT_ERROR_NONE;
+    }
+    // File indices start at zero since version 5 and at one before.
+    int64_t firstFile = module->fileNameCount - ((version >= 5) ? 0 : 1);
+    SCUnitError error = (version >= 5)
+        ? readEntryTables(module, &unit, offsetSize, strings, lineStrings)
+        : readLegacyEntryTables(module, &unit);
+    if ((error != SCUNIT_ERROR_NONE) || !unit.isValid) {
+        return error;
+    }
+    int64_t lastFile = module->fileNameCount;
+    uintptr_t address = 0;
+    uint64_t file = 1;
+    int64_t line = 1;
+    while (program.isValid && (program.position < program.end)) {
+        uint64_t opcode = readUnsigned(&program, 1);
+        bool isRow = false;
+        bool isEndOfSequence = false;
+        if (opcode >= opcodeBase) {
+            uint64_t adjustedOpcode = opcode - opcodeBase;
+            address += (adjustedOpcode / lineRange) * minimumInstructionLength;
+            line += lineBase + (int64_t) (adjustedOpcode % lineRange);
+            isRow = true;
+        }
+        else if (opcode == 0) {
+            uint64_t length = readUleb128(&program);
+            Cursor instruction = program;
+            if ((length == 0) || (readBytes(&program, length) == nullptr)) {
+                break;
+            }
+            uint64_t extendedOpcode = readUnsigned(&instruction, 1);
+            if (extendedOpcode == DW_LNE_END_SEQUENCE) {
+                isRow = true;
+                isEndOfSequence = true;
+            }
+            else if ((extendedOpcode == DW_LNE_SET_ADDRESS) && (length - 1 <= 8)) {
+                address = (uintptr_t) readUnsigned(&instruction, (int32_t) (length - 1));
+            }
+        }
+        else {
+            switch (opcode) {
+                case DW_LNS_COPY:
+                    isRow = true;
+                    break;
+                case DW_LNS_ADVANCE_PC:
+                    address += readUleb128(&program) * minimumInstructionLength;
+                    break;
+                case DW_LNS_ADVANCE_LINE:
+                    line += readSleb128(&program);
+                    break;
+                case DW_LNS_SET_FILE:
+                    file = readUleb128(&program);
+                    break;
+                case DW_LNS_CONST_ADD_PC:
+                    address += ((255 - opcodeBase) / lineRange) * minimumInstructionLength;
+                    break;
+                case DW_LNS_FIXED_ADVANCE_PC:
+                    address += readUnsigned(&program, 2);
+                    break;
+                default:
+                    // All other standard opcodes only affect registers we are not interested in,
+                    // so their operands are skipped.
+                    for (uint8_t i = 0; i < opcodeLengths[opcode - 1]; i++) {
+                        readUleb128(&program);
+                    }
+                    break;
+            }
+        }
+        if (!isRow) {
+            continue;
+        }
+        int64_t fileIndex = firstFile + (int64_t) file;
+        error = addLineRow(module, (LineRow) {
+            .address = address,
+            .file = ((fileIndex >= 0) && (fileIndex < lastFile)) ? fileIndex : -1,
+            .line = line,
+            .isEndOfSequence = isEndOfSequence
+        });
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        if (isEndOfSequence) {
+            address = 0;
+            file = 1;
+            line = 1;
+        }
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Loads the line table of a module from its `.debug_line` section.
+ *
+ * @note Malformed units are skipped, so that a single one does not prevent the others from being
+ * used.
+ *
+ * @param[in, out] module   Module to load the line table of.
+ * @param[in]      sections Section headers of the module.
+ * @param[in]      count    Number of section headers of the module.
+ * @param[in]      names    Cursor spanning the section name string table of the module.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError loadLineTable(
+    Module* module,
+    const ElfW(Shdr)* sections,
+    int64_t count,
+    Cursor names
+) {
+    Cursor lines = { };
+    Cursor strings = { };
+    Cursor lineStrings = { };
+    for (int64_t i = 0; i < count; i++) {
+        const char* name = getString(names, sections[i].sh_name);
+        if (name == nullptr) {
+            continue;
+        }
+        if (strcmp(name, ".debug_line") == 0) {
+            lines = getSection(module, &sections[i]);
+        }
+        else if (strcmp(name, ".debug_str") == 0) {
+            strings = getSection(module, &sections[i]);
+        }
+        else if (strcmp(name, ".debug_line_str") == 0) {
+            lineStrings = getSection(module, &sections[i]);
+        }
+    }
+    while (lines.isValid && (lines.position < lines.end)) {
+        SCUnitError error = readLineUnit(module, &lines, strings, lineStrings);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    qsort(module->rows, module->rowCount, sizeof(LineRow), compareLineRows);
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Maps the file of a module into memory and loads its symbol and line tables.
+ *
+ * @note A module that cannot be mapped or is not a valid ELF file is kept without any tables, so
+ * that it is not parsed again.
+ *
+ * @param[in, out] module Module to load.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError loadModule(Module* module) {
+    int fd = open(module->path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return SCUNIT_ERROR_NONE;
+    }
+    struct stat status;
+    if (fstat(fd, &status) < 0) {
+        close(fd);
+        return SCUNIT_ERROR_NONE;
+    }
+    module->device = status.st_dev;
+    module->inode = status.st_ino;
+    module->modification = status.st_mtim;
+    if (status.st_size < (off_t) sizeof(ElfW(Ehdr))) {
+        close(fd);
+        return SCUNIT_ERROR_NONE;
+    }
+    void* image = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (image == MAP_FAILED) {
+        return SCUNIT_ERROR_NONE;
+    }
+    module->image = image;
+    module->imageSize = status.st_size;
+    const ElfW(Ehdr)* header = image;
+    bool isValid = (memcmp(header->e_ident, ELFMAG, SELFMAG) == 0)
+        && (header->e_ident[EI_CLASS] == ((sizeof(void*) == 8) ? ELFCLASS64 : ELFCLASS32))
+        && (header->e_shentsize == sizeof(ElfW(Shdr)))
+        && (header->e_shoff <= module->imageSize)
+        && (header->e_shnum <= (module->imageSize - header->e_shoff) / sizeof(ElfW(Shdr)))
+        && (header->e_shstrndx < header->e_shnum);
+    if (!isValid) {
+        return SCUNIT_ERROR_NONE;
+    }
+    const ElfW(Shdr)* sections = (const ElfW(Shdr)*) (module->image + header->e_shoff);
+    SCUnitError error = loadSymbols(module, sections, header->e_shnum);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    Cursor names = getSection(module, &sections[header->e_shstrndx]);
+    return loadLineTable(module, sections, header->e_shnum, names);
+}
+
+/**
+ * @brief Unmaps the file of a module and frees its symbol and line tables.
+ *
+ * @note The path and the bias of the module are kept, so that it can be loaded again.
+ *
+ * @param[in, out] module Module to unload.
+ */
+static void unloadModule(Module* module) {
+    if (module->image != nullptr) {
+        munmap((void*) module->image, module->imageSize);
+    }
+    for (int64_t i = 0; i < module->fileNameCount; i++) {
+        SCUNIT_FREE(module->fileNames[i]);
+    }
+    SCUNIT_FREE(module->fileNames);
+    SCUNIT_FREE(module->rows);
+    SCUNIT_FREE(module->symbols);
+    *module = (Module) { .path = module->path, .bias = module->bias, .next = module->next };
+}
+
+/**
+ * @brief Returns whether the file of a cached module was replaced since it was loaded.
+ *
+ * @note A shared library that is unloaded and loaded again (e. g. by `scunit-worker` after it was
+ * rebuilt) is usually mapped at the same address, so its path and bias alone do not tell the new
+ * build from the old one. If the file cannot be examined, the cached module is kept.
+ *
+ * @param[in] module Module to examine.
+ * @return `true` if the file of the module was replaced, otherwise `false`.
+ */
+static bool isStale(const Module* module) {
+    struct stat status;
+    if (stat(module->path, &status) < 0) {
+        return false;
+    }
+    return (status.st_dev != module->device) || (status.st_ino != module->inode)
+        || (status.st_mtim.tv_sec != module->modification.tv_sec)
+        || (status.st_mtim.tv_nsec != module->modification.tv_nsec);
+}
+
+/**
+ * @brief Finds the module containing the address of a given `ModuleQuery`.
+ *
+ * @note This function is a callback for `dl_iterate_phdr()`. Unlike `dladdr()`, it yields the
+ * difference between load-time and link-time addresses, which also works for non-PIE executables.
+ *
+ * @param[in]      info  Information about the current module.
+ * @param[in]      size  Size of the information about the current module.
+ * @param[in, out] query `ModuleQuery` to answer.
+ * @return A non-zero value if the module was found, otherwise zero.
+ */
+static int findModule(struct dl_phdr_info* info, size_t size, void* query) {
+    (void) size;
+    ModuleQuery* moduleQuery = query;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)* segment = &info->dlpi_phdr[i];
+        uintptr_t start = info->dlpi_addr + segment->p_vaddr;
+        if ((segment->p_type == PT_LOAD) && (moduleQuery->address >= start)
+            && (moduleQuery->address - start < segment->p_memsz)) {
+            moduleQuery->name = info->dlpi_name;
+            moduleQuery->bias = info->dlpi_addr;
+            moduleQuery->isFound = true;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the cached module containing a given address, loading it on first use.
+ *
+ * @note The modules mutex must be held while calling this function. A cached module whose file
+ * was replaced is loaded again in place, which invalidates all symbols and rows previously found
+ * in it.
+ *
+ * @param[in]  address Address to find the module of.
+ * @param[out] module  Module containing the address or a `nullptr` if there is none.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError getModule(uintptr_t address, Module** module) {
+    *module = nullptr;
+    ModuleQuery query = { .address = address };
+    dl_iterate_phdr(findModule, &query);
+    if (!query.isFound) {
+        return SCUNIT_ERROR_NONE;
+    }
+    // The executable itself has an empty name.
+    const char* path = (*query.name != '\0') ? query.name : "/proc/self/exe";
+    for (Module* cached = modules; cached != nullptr; cached = cached->next) {
+        if ((cached->bias == query.bias) && (strcmp(cached->path, path) == 0)) {
+            *module = cached;
+            if (!isStale(cached)) {
+                return SCUNIT_ERROR_NONE;
+            }
+            unloadModule(cached);
+            return loadModule(cached);
+        }
+    }
+    Module* newModule = SCUNIT_CALLOC(1, sizeof(Module));
+    if (newModule == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    newModule->path = SCUNIT_MALLOC(strlen(path) + 1);
+    if (newModule->path == nullptr) {
+        SCUNIT_FREE(newModule);
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    strcpy(newModule->path, path);
+    newModule->bias = query.bias;
+    newModule->next = modules;
+    modules = newModule;
+    *module = newModule;
+    return loadModule(newModule);
+}
+
+/**
+ * @brief Finds the function symbol containing a given link-time address.
+ *
+ * @param[in] module  Module to search.
+ * @param[in] address Link-time address to find the symbol of.
+ * @return The symbol containing the address or a `nullptr` if there is none.
+ */
+static const Symbol* findSymbol(const Module* module, uintptr_t address) {
+    int64_t low = 0;
+    int64_t high = module->symbolCount;
+    while (low < high) {
+        int64_t middle = low + ((high - low) / 2);
+        if (module->symbols[middle].address <= address) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    if (low == 0) {
+        return nullptr;
+    }
+    // Several symbols may start at the same address, of which the first one is sized.
+    const Symbol* symbol = &module->symbols[low - 1];
+    while ((symbol > module->symbols) && ((symbol - 1)->address == symbol->address)) {
+        symbol--;
+    }
+    if ((symbol->size > 0) && (address - symbol->address >= symbol->size)) {
+        return nullptr;
+    }
+    return symbol;
+}
+
+/**
+ * @brief Finds the row of the line table covering a given link-time address.
+ *
+ * @param[in] module  Module to search.
+ * @param[in] address Link-time address to find the row of.
+ * @return The row covering the address or a `nullptr` if there is none.
+ */
+static const LineRow* findLineRow(const Module* module, uintptr_t address) {
+    int64_t low = 0;
+    int64_t high = module->rowCount;
+    while (low < high) {
+        int64_t middle = low + ((high - low) / 2);
+        if (module->rows[middle].address <= address) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    if ((low == 0) || module->rows[low - 1].isEndOfSequence) {
+        return nullptr;
+    }
+    return &module->rows[low - 1];
+}
+
+/**
+ * @brief Returns whether a given frame lies within one of the functions of SCUnit calling the code
+ * of a test.
+ *
+ * @note The modules mutex must be held while calling this function. The range of each function is
+ * taken from the symbol table of its module, so a frame is never recognized as a boundary if that
+ * symbol table is unavailable (e. g. because the module is stripped).
+ *
+ * @param[in] frame Return address of the frame.
+ * @return `true` if the frame is a boundary of the backtrace, otherwise `false`.
+ */
+static bool isBoundary(uintptr_t frame) {
+    for (size_t i = 0; i < (sizeof(BOUNDARY_FUNCTIONS) / sizeof(BOUNDARY_FUNCTIONS[0])); i++) {
+        uintptr_t begin = (uintptr_t) BOUNDARY_FUNCTIONS[i];
+        Module* module;
+        if ((getModule(begin, &module) != SCUNIT_ERROR_NONE) || (module == nullptr)) {
+            continue;
+        }
+        const Symbol* symbol = findSymbol(module, begin - module->bias);
+        if ((symbol == nullptr) || (symbol->address != begin - module->bias)) {
+            continue;
+        }
+        // Like in `appendFrame()`, the call instruction itself is looked up.
+        if ((frame - 1 >= begin) && (frame - 1 - begin < symbol->size)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Appends a single symbolized frame to a given `SCUnitContext`.
+ *
+ * @param[in, out] context `SCUnitContext` to append the frame to.
+ * @param[in]      number  Number of the frame.
+ * @param[in]      frame   Return address of the frame.
+ * @param[in]      module  Module containing the frame or a `nullptr` if it is unknown.
+ * @param[in]      symbol  Symbol containing the frame or a `nullptr` if it is unknown.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendFrame(
+    SCUnitContext* context,
+    int32_t number,
+    uintptr_t frame,
+    const Module* module,
+    const Symbol* symbol
+) {
+    if (module == nullptr) {
+        return scunit_context_appendMessage(context, "    #%d %p\n", number, (void*) frame);
+    }
+    // Return addresses point right after the call instruction, which may already belong to the
+    // next line (or even the next function), so the call instruction itself is looked up instead.
+    uintptr_t address = frame - module->bias - 1;
+    const char* moduleName = strrchr(module->path, '/');
+    moduleName = (moduleName != nullptr) ? moduleName + 1 : module->path;
+    if (symbol == nullptr) {
+        return scunit_context_appendMessage(
+            context,
+            "    #%d %p (%s+0x%tx)\n",
+            number,
+            (void*) frame,
+            moduleName,
+            address + 1
+        );
+    }
+    const LineRow* row = findLineRow(module, address);
+    if ((row == nullptr) || (row->file < 0)) {
+        return scunit_context_appendMessage(
+            context,
+            "    #%d %s+0x%tx (%s)\n",
+            number,
+            symbol->name,
+            address + 1 - symbol->address,
+            moduleName
+        );
+    }
+    return scunit_context_appendMessage(
+        context,
+        "    #%d %s (%s:%" PRId64 ")\n",
+        number,
+        symbol->name,
+        module->fileNames[row->file],
+        row->line
+    );
+}
+
+SCUnitError scunit_backtrace_appendFrames(
+    SCUnitContext* context,
+    void* const* frames,
+    int32_t frameCount
+) {
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    pthread_mutex_lock(&modulesMutex);
+    int32_t number = 0;
+    for (int32_t i = 0; i < frameCount; i++) {
+        uintptr_t frame = (uintptr_t) frames[i];
+        // Looking up the boundaries may reload a module, so it is done before finding the symbol.
+        if (isBoundary(frame)) {
+            break;
+        }
+        Module* module;
+        error = getModule(frame - 1, &module);
+        if (error != SCUNIT_ERROR_NONE) {
+            goto finished;
+        }
+        const Symbol* symbol = (module != nullptr)
+            ? findSymbol(module, frame - module->bias - 1)
+            : nullptr;
+        error = appendFrame(context, number++, frame, module, symbol);
+        if (error != SCUNIT_ERROR_NONE) {
+            goto finished;
+        }
+        int32_t repetitions = 0;
+        while ((i + 1 < frameCount) && (frames[i + 1] == frames[i])) {
+            repetitions++;
+            i++;
+        }
+        if (repetitions > 0) {
+            error = scunit_context_appendMessage(
+                context,
+                "    ... (repeated %d more time%s)\n",
+                repetitions,
+                (repetitions == 1) ? "" : "s"
+            );
+            if (error != SCUNIT_ERROR_NONE) {
+                goto finished;
+            }
+            number += repetitions;
+        }
+    }
+finished:
+    pthread_mutex_unlock(&modulesMutex);
+    return error;
+}
+
+[[gnu::noinline]]
+SCUnitError scunit_backtrace_append(SCUnitContext* context) {
+    void* frames[MAX_FRAMES];
+    // The innermost frame is this function itself, which is of no interest.
+    int32_t frameCount = backtrace(frames, MAX_FRAMES) - 1;
+    if (frameCount <= 1) {
+        return SCUNIT_ERROR_NONE;
+    }
+    // Only append the backtrace if the failure occurred in a helper function, that is if there is
+    // more than one frame up to the boundary.
+    pthread_mutex_lock(&modulesMutex);
+    bool isHelper = !isBoundary((uintptr_t) frames[2]);
+    pthread_mutex_unlock(&modulesMutex);
+    if (!isHelper) {
+        return SCUNIT_ERROR_NONE;
+    }
+    SCUnitError error = scunit_context_appendMessage(context, "  Backtrace:\n\n");
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    error = scunit_backtrace_appendFrames(context, frames + 1, frameCount);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_context_appendMessage(context, "\n");
+}
+
+/** @brief Unmaps and frees all cached modules once the process exits. */
+[[gnu::destructor]]
+static void freeModules() {
+    while (modules != nullptr) {
+        Module* module = modules;
+        modules = module->next;
+        unloadModule(module);
+        SCUNIT_FREE(module->path);
+        SCUNIT_FREE(module);
+    }
+}
\ No newline at end of file
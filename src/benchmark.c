@@ -0,0 +1,2540 @@
+#define _GNU_SOURCE
+
+#include <dlfcn.h>
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <SCUnit/benchmark.h>
+#include <SCUnit/clock.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/optimize.h>
+#include <SCUnit/random.h>
+#include <SCUnit/scunit.h>
+#include <SCUnit/timer.h>
+
+/** @brief Number of nanoseconds per second. */
+static constexpr int64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+/** @brief Maximum number of iterations of the timed loop of a benchmark. */
+static constexpr int64_t MAX_ITERATIONS = 1'000'000'000;
+
+/** @brief Maximum factor the number of iterations grows by between two attempts. */
+static constexpr double MAX_GROWTH_FACTOR = 10.0;
+
+/**
+ * @brief Factor the number of iterations is overestimated by, so that the next attempt most
+ * likely reaches the minimum time.
+ */
+static constexpr double OVERESTIMATION_FACTOR = 1.4;
+
+/**
+ * @brief Greatest factor the time of the timed loop including the time timing was paused for may
+ * exceed the minimum time by.
+ */
+static constexpr int64_t MAX_PAUSED_FACTOR = 10;
+
+/** @brief Number of pauses timed to calibrate the overhead of pausing and resuming. */
+static constexpr int64_t CALIBRATION_PAUSES = 1'000;
+
+/** @brief Duration the tick counter is compared against the monotonic clock for (in ns). */
+static constexpr int64_t CALIBRATION_TIME = 10'000'000;
+
+/**
+ * @brief Number of sub-buckets of every bucket of a latency histogram, which keeps latencies to a
+ * precision of three significant digits.
+ */
+static constexpr int64_t SUB_BUCKET_COUNT = 2'048;
+
+/** @brief Number of buckets of a latency histogram, each covering twice the range of the last. */
+static constexpr int64_t BUCKET_COUNT = 32;
+
+/** @brief Number of counts of a latency histogram. */
+static constexpr int64_t HISTOGRAM_SIZE = (BUCKET_COUNT + 1) * (SUB_BUCKET_COUNT / 2);
+
+/** @brief Greatest latency a histogram can record (about 73 minutes, in ns). */
+static constexpr int64_t MAX_LATENCY = (SUB_BUCKET_COUNT << (BUCKET_COUNT - 1)) - 1;
+
+/** @brief Percentiles of the latencies reported by a latency benchmark. */
+static const double PERCENTILES[] = { 50.0, 90.0, 99.0, 99.9 };
+
+/** @brief Size of the buffer streamed over to evict the caches if their size is unknown. */
+static constexpr int64_t DEFAULT_EVICTION_SIZE = 64 * 1'024 * 1'024;
+
+/** @brief Number of pages touched to evict the entries of the TLB. */
+static constexpr int64_t EVICTION_PAGES = 16'384;
+
+/** @brief Size of a cache line, used as the stride for evicting the caches. */
+static constexpr int64_t CACHE_LINE_SIZE = 64;
+
+/** @brief Number of iterations of an empty timed loop timed to calibrate the eviction. */
+static constexpr int64_t EVICTION_CALIBRATION_ITERATIONS = 8;
+
+/** @brief Number of times the eviction is calibrated, of which the fastest one is used. */
+static constexpr int64_t EVICTION_CALIBRATION_RUNS = 3;
+
+/** @brief Greatest number of cache descriptions read from `/sys/devices/system/cpu/cpu0/cache`. */
+static constexpr int MAX_CACHE_INDEX = 16;
+
+/** @brief Number of pairs of samples measured to compare two libraries for an input size. */
+static constexpr int64_t AB_PAIRS = 100;
+
+/** @brief Divisor of the minimum time giving the time a sample of an A/B comparison runs for. */
+static constexpr int64_t AB_SAMPLE_DIVISOR = 20;
+
+/** @brief Quantile of the standard normal distribution for a two-sided 95 % confidence level. */
+static constexpr double NORMAL_QUANTILE = 1.959963984540054;
+
+/** @brief Notations of the different cache states. */
+static const char* const CACHE_STATE_STRINGS[SCUNIT_CACHE_STATE_COLD_TLB + 1] = {
+    [SCUNIT_CACHE_STATE_WARM] = "warm",
+    [SCUNIT_CACHE_STATE_COLD] = "cold",
+    [SCUNIT_CACHE_STATE_COLD_TLB] = "cold TLB"
+};
+
+/** @brief Units of throughputs, each a thousand times the previous one. */
+static const char* const RATE_UNIT_STRINGS[] = { "/s", "k/s", "M/s", "G/s" };
+
+/** @brief Notations of the different complexity classes. */
+static const char* const COMPLEXITY_STRINGS[SCUNIT_COMPLEXITY_QUADRATIC + 1] = {
+    [SCUNIT_COMPLEXITY_CONSTANT] = "O(1)",
+    [SCUNIT_COMPLEXITY_LOGARITHMIC] = "O(log n)",
+    [SCUNIT_COMPLEXITY_LINEAR] = "O(n)",
+    [SCUNIT_COMPLEXITY_LINEARITHMIC] = "O(n log n)",
+    [SCUNIT_COMPLEXITY_QUADRATIC] = "O(n^2)"
+};
+
+/** @brief Notations of the different complexity classes used by Google Benchmark. */
+static const char* const GBENCH_COMPLEXITY_STRINGS[SCUNIT_COMPLEXITY_QUADRATIC + 1] = {
+    [SCUNIT_COMPLEXITY_CONSTANT] = "(1)",
+    [SCUNIT_COMPLEXITY_LOGARITHMIC] = "lgN",
+    [SCUNIT_COMPLEXITY_LINEAR] = "N",
+    [SCUNIT_COMPLEXITY_LINEARITHMIC] = "NlgN",
+    [SCUNIT_COMPLEXITY_QUADRATIC] = "N^2"
+};
+
+/** @brief Represents how the caches are evicted before every iteration of a benchmark. */
+typedef struct Eviction {
+
+    /** @brief State of the caches every iteration starts with. */
+    SCUnitCacheState cacheState;
+
+    /** @brief Buffer accessed to evict the caches. */
+    unsigned char* buffer;
+
+    /** @brief Number of bytes of the buffer accessed. */
+    int64_t size;
+
+    /** @brief Distance between two bytes accessed. */
+    int64_t stride;
+
+    /** @brief Time an iteration of an empty timed loop takes with the eviction (in ns). */
+    int64_t overhead;
+
+} Eviction;
+
+struct SCUnitBenchmark {
+
+    /** @brief Input size the benchmark is currently executed for. */
+    int64_t size;
+
+    /** @brief Number of iterations of the timed loop. */
+    int64_t iterations;
+
+    /** @brief Number of iterations of the timed loop remaining. */
+    int64_t remaining;
+
+    /** @brief Whether the timed loop is currently running. */
+    bool isRunning;
+
+    /** @brief Whether the timed loop ran to completion. */
+    bool isFinished;
+
+    /** @brief Wall time the timed loop started at (in nanoseconds). */
+    int64_t wallTimeStart;
+
+    /** @brief CPU time the timed loop started at (in nanoseconds). */
+    int64_t cpuTimeStart;
+
+    /** @brief Wall time the timed loop ran for (in nanoseconds). */
+    int64_t wallTime;
+
+    /** @brief CPU time the timed loop ran for (in nanoseconds). */
+    int64_t cpuTime;
+
+    /** @brief Wall time the timed loop ran for including paused time (in nanoseconds). */
+    int64_t grossWallTime;
+
+    /** @brief Whether reading a clock failed while measuring. */
+    bool isClockFailed;
+
+    /** @brief Whether timing is currently paused. */
+    bool isPaused;
+
+    /** @brief Tick count timing was last paused at. */
+    int64_t pauseTicks;
+
+    /** @brief Ticks timing was paused for. */
+    int64_t pausedTicks;
+
+    /** @brief Number of times timing was paused. */
+    int64_t pauseCount;
+
+    /** @brief Clock the CPU time is read from (the one of the process or of the thread). */
+    clockid_t cpuClockId;
+
+    /** @brief Index of the thread the benchmark is executed on. */
+    int64_t threadIndex;
+
+    /** @brief Number of threads the benchmark is executed on. */
+    int64_t threadCount;
+
+    /**
+     * @brief Number of threads that reached their timed loop so far, shared by all threads, or a
+     * `nullptr` if the benchmark is executed on the calling thread only.
+     */
+    _Atomic int64_t* arrivedThreads;
+
+    /** @brief Whether this thread reached its timed loop (or returned without doing so). */
+    bool hasArrived;
+
+    /**
+     * @brief Counts of the latencies recorded so far, indexed by `histogramIndex()`, or a
+     * `nullptr` if the benchmark is not executed at a target rate.
+     */
+    int64_t* histogram;
+
+    /** @brief Ticks between the intended start times of two consecutive operations. */
+    double intervalTicks;
+
+    /** @brief Tick count the first operation started at. */
+    int64_t scheduleTicks;
+
+    /** @brief Greatest latency recorded so far (in nanoseconds). */
+    int64_t maxLatency;
+
+    /**
+     * @brief Eviction of the caches before every iteration or a `nullptr` if the caches are left
+     * warm.
+     */
+    const Eviction* eviction;
+
+    /**
+     * @brief Handle of the library symbols are resolved from or a `nullptr` if they are resolved
+     * from the global scope.
+     */
+    void* library;
+
+};
+
+/** @brief Represents a thread executing the body of a benchmark. */
+typedef struct Worker {
+
+    /** @brief `SCUnitBenchmark` of the thread. */
+    SCUnitBenchmark benchmark;
+
+    /** @brief `SCUnitContext` of the thread, which is merged into the one of the benchmark. */
+    SCUnitContext* context;
+
+    /** @brief Body of the benchmark. */
+    SCUnitBenchmarkFunction function;
+
+    /** @brief Handle of the POSIX thread. */
+    pthread_t handle;
+
+} Worker;
+
+/** @brief Represents a group of threads executing the body of a benchmark simultaneously. */
+typedef struct Team {
+
+    /** @brief Threads of the team. */
+    Worker* workers;
+
+    /** @brief Number of threads of the team. */
+    int64_t threadCount;
+
+    /** @brief Number of threads that reached their timed loop so far. */
+    _Atomic int64_t arrivedThreads;
+
+    /** @brief CPUs available to the process, which the threads are pinned to in turn. */
+    const int* cpus;
+
+    /** @brief Number of CPUs available to the process or zero if the threads are not pinned. */
+    int64_t cpuCount;
+
+} Team;
+
+/** @brief Represents the measurement of a benchmark for a single input size. */
+typedef struct Sample {
+
+    /** @brief Input size. */
+    int64_t size;
+
+    /** @brief Number of threads. */
+    int64_t threadCount;
+
+    /** @brief Number of iterations of the timed loop (of every thread). */
+    int64_t iterations;
+
+    /** @brief Wall time per iteration of a single thread (in seconds). */
+    double wallTime;
+
+    /** @brief CPU time per iteration of a single thread (in seconds). */
+    double cpuTime;
+
+    /** @brief Iterations of all threads per second. */
+    double throughput;
+
+} Sample;
+
+/** @brief Represents a cache of the first CPU, as described in `/sys/devices/system/cpu`. */
+typedef struct Cache {
+
+    /** @brief Type of the cache (`Data`, `Instruction` or `Unified`). */
+    char type[16];
+
+    /** @brief Level of the cache. */
+    int level;
+
+    /** @brief Size of the cache (in bytes). */
+    int64_t size;
+
+    /** @brief Number of CPUs sharing the cache. */
+    int64_t sharingCount;
+
+} Cache;
+
+/** @brief Represents the comparison of two libraries for a single input size. */
+typedef struct Comparison {
+
+    /** @brief Input size. */
+    int64_t size;
+
+    /** @brief Number of iterations of the timed loop of every sample. */
+    int64_t iterations;
+
+    /** @brief Mean wall time per iteration with the first library (in seconds). */
+    double firstTime;
+
+    /** @brief Mean wall time per iteration with the second library (in seconds). */
+    double secondTime;
+
+    /** @brief Mean paired difference relative to the first library. */
+    double difference;
+
+    /** @brief Half the width of the 95 % confidence interval of the relative difference. */
+    double margin;
+
+} Comparison;
+
+/**
+ * @brief Runs of the benchmarks recorded so far as JSON objects in the format of Google Benchmark,
+ * each preceded by a separator, or a `nullptr` if no runs were recorded.
+ */
+static char* report;
+
+/** @brief Size of the buffer of the recorded runs. */
+static int64_t reportSize;
+
+/** @brief Number of benchmarks runs were recorded for. */
+static int64_t recordedBenchmarks;
+
+/** @brief Ensures that the tick counter is calibrated only once. */
+static pthread_once_t calibration = PTHREAD_ONCE_INIT;
+
+/** @brief Number of ticks per nanosecond of the tick counter. */
+static double ticksPerNanosecond = 1.0;
+
+/**
+ * @brief Ticks counted for a single pause and resume (the part of it the paused time does not
+ * cover).
+ */
+static double pauseOverheadTicks;
+
+/**
+ * @brief Reads the real time of a given clock, bypassing the virtual clock.
+ *
+ * @param[in]      clockId   Identifier of the clock to read.
+ * @param[in, out] benchmark `SCUnitBenchmark` to flag if reading the clock failed.
+ * @return The time of the clock (in nanoseconds).
+ */
+static int64_t readClock(clockid_t clockId, SCUnitBenchmark* benchmark) {
+    struct timespec time;
+    if (scunit_clock_getRealTime(clockId, &time) < 0) {
+        benchmark->isClockFailed = true;
+        return 0;
+    }
+    return (((int64_t) time.tv_sec) * NANOSECONDS_PER_SECOND) + time.tv_nsec;
+}
+
+/**
+ * @brief Reads a low-overhead tick counter, which never enters the kernel.
+ *
+ * @note This is the time stamp counter on x86-64 and the virtual counter on AArch64, both of which
+ * tick at a constant rate on current CPUs. Other architectures fall back to the monotonic clock.
+ *
+ * @return The current tick count.
+ */
+static inline int64_t readTicks() {
+#if defined(__x86_64__)
+    return (int64_t) __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+    int64_t ticks;
+    __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    struct timespec time;
+    scunit_clock_getRealTime(CLOCK_MONOTONIC, &time);
+    return (((int64_t) time.tv_sec) * NANOSECONDS_PER_SECOND) + time.tv_nsec;
+#endif
+}
+
+/**
+ * @brief Calibrates the tick counter against the monotonic clock and measures the overhead of
+ * pausing and resuming timing.
+ */
+static void calibrate() {
+    struct timespec start;
+    struct timespec end;
+    if (scunit_clock_getRealTime(CLOCK_MONOTONIC, &start) < 0) {
+        return;
+    }
+    int64_t startTicks = readTicks();
+    int64_t elapsedTime;
+    do {
+        if (scunit_clock_getRealTime(CLOCK_MONOTONIC, &end) < 0) {
+            return;
+        }
+        elapsedTime = ((((int64_t) end.tv_sec) - start.tv_sec) * NANOSECONDS_PER_SECOND)
+            + (end.tv_nsec - start.tv_nsec);
+    }
+    while (elapsedTime < CALIBRATION_TIME);
+    int64_t elapsedTicks = readTicks() - startTicks;
+    if (elapsedTicks > 0) {
+        ticksPerNanosecond = ((double) elapsedTicks) / elapsedTime;
+    }
+    SCUnitBenchmark benchmark = { .isRunning = true };
+    startTicks = readTicks();
+    for (int64_t i = 0; i < CALIBRATION_PAUSES; i++) {
+        scunit_benchmark_pauseTiming(&benchmark);
+        scunit_benchmark_resumeTiming(&benchmark);
+    }
+    elapsedTicks = readTicks() - startTicks;
+    double overheadTicks = ((double) (elapsedTicks - benchmark.pausedTicks)) / CALIBRATION_PAUSES;
+    pauseOverheadTicks = (overheadTicks > 0.0) ? overheadTicks : 0.0;
+}
+
+/** @brief Hints the CPU that the calling thread is spinning, so that it yields resources. */
+static inline void pauseSpinning() {
+#if defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ volatile("yield");
+#endif
+}
+
+/**
+ * @brief Waits until every thread executing a benchmark reached its timed loop.
+ *
+ * @note The threads spin instead of blocking, so that they are released within nanoseconds of
+ * each other rather than one by one as the scheduler wakes them up.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` of the calling thread.
+ */
+static void waitForThreads(SCUnitBenchmark* benchmark) {
+    benchmark->hasArrived = true;
+    atomic_fetch_add_explicit(benchmark->arrivedThreads, 1, memory_order_acq_rel);
+    while (atomic_load_explicit(benchmark->arrivedThreads, memory_order_acquire)
+            < benchmark->threadCount) {
+        pauseSpinning();
+    }
+}
+
+/**
+ * @brief Starts measuring the timed loop of a benchmark.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` to start measuring.
+ */
+static void startLoop(SCUnitBenchmark* benchmark) {
+    if (benchmark->arrivedThreads != nullptr) {
+        waitForThreads(benchmark);
+    }
+    benchmark->isRunning = true;
+    benchmark->cpuTimeStart = readClock(benchmark->cpuClockId, benchmark);
+    benchmark->wallTimeStart = readClock(CLOCK_MONOTONIC, benchmark);
+}
+
+/**
+ * @brief Stops measuring the timed loop of a benchmark.
+ *
+ * @note The time timing was paused for is subtracted from both the wall and the CPU time, along
+ * with the calibrated overhead of every pause. The CPU time spent while paused is not measured
+ * separately, since reading the CPU clock enters the kernel, so the paused time is assumed to be
+ * spent on the CPU.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` to stop measuring.
+ */
+static void stopLoop(SCUnitBenchmark* benchmark) {
+    int64_t wallTimeEnd = readClock(CLOCK_MONOTONIC, benchmark);
+    int64_t cpuTimeEnd = readClock(benchmark->cpuClockId, benchmark);
+    if (benchmark->isPaused) {
+        scunit_benchmark_resumeTiming(benchmark);
+    }
+    int64_t pausedTime = (int64_t) ((benchmark->pausedTicks
+        + (benchmark->pauseCount * pauseOverheadTicks)) / ticksPerNanosecond);
+    if (benchmark->eviction != nullptr) {
+        pausedTime += benchmark->iterations * benchmark->eviction->overhead;
+    }
+    int64_t wallTime = wallTimeEnd - benchmark->wallTimeStart - pausedTime;
+    int64_t cpuTime = cpuTimeEnd - benchmark->cpuTimeStart - pausedTime;
+    benchmark->grossWallTime += wallTimeEnd - benchmark->wallTimeStart;
+    benchmark->wallTime += (wallTime > 0) ? wallTime : 0;
+    benchmark->cpuTime += (cpuTime > 0) ? cpuTime : 0;
+    benchmark->isRunning = false;
+    benchmark->isFinished = true;
+}
+
+/**
+ * @brief Determines the index of the count of a given latency in a latency histogram.
+ *
+ * @note Like an HDR histogram, every bucket covers twice the range of the last one with the same
+ * number of sub-buckets, so that the relative precision is the same for all latencies. Latencies
+ * below `SUB_BUCKET_COUNT` are recorded exactly.
+ *
+ * @param[in] latency Latency (in nanoseconds, at most `MAX_LATENCY`).
+ * @return The index of the count.
+ */
+static int64_t histogramIndex(int64_t latency) {
+    int64_t bucket = 0;
+    while ((latency >> bucket) >= SUB_BUCKET_COUNT) {
+        bucket++;
+    }
+    return (bucket * (SUB_BUCKET_COUNT / 2)) + (latency >> bucket);
+}
+
+/**
+ * @brief Determines the greatest latency recorded by a given count of a latency histogram.
+ *
+ * @param[in] index Index of the count.
+ * @return The greatest latency the count stands for (in nanoseconds).
+ */
+static int64_t histogramValue(int64_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int64_t bucket = (index / (SUB_BUCKET_COUNT / 2)) - 1;
+    int64_t subBucket = index - (bucket * (SUB_BUCKET_COUNT / 2));
+    return ((subBucket + 1) << bucket) - 1;
+}
+
+/**
+ * @brief Determines a given percentile of the latencies recorded by a given `SCUnitBenchmark`.
+ *
+ * @note The percentile is the smallest latency at least the given share of operations is below.
+ *
+ * @param[in] benchmark  `SCUnitBenchmark` the latencies were recorded by.
+ * @param[in] percentile Percentile to determine (between zero and 100).
+ * @return The percentile (in nanoseconds).
+ */
+static int64_t findPercentile(const SCUnitBenchmark* benchmark, double percentile) {
+    int64_t rank = (int64_t) ceil((percentile / 100.0) * benchmark->iterations);
+    int64_t index = 0;
+    int64_t count = benchmark->histogram[0];
+    while ((count < rank) && (index < (HISTOGRAM_SIZE - 1))) {
+        count += benchmark->histogram[++index];
+    }
+    int64_t latency = histogramValue(index);
+    return (latency < benchmark->maxLatency) ? latency : benchmark->maxLatency;
+}
+
+/**
+ * @brief Determines whether the timed loop of a benchmark executed at a target rate should run
+ * another operation, waiting for its intended start time.
+ *
+ * @note The latency of every operation is measured from its intended start time instead of its
+ * actual one. If an operation stalls, the following ones start late and their latencies include
+ * the time they had to wait, like the requests of real clients would. Timing each operation from
+ * its actual start would hide this wait (known as coordinated omission).
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` of the benchmark.
+ * @return `true` if another operation should run, otherwise `false`.
+ */
+static bool keepScheduling(SCUnitBenchmark* benchmark) {
+    if (!benchmark->isRunning) {
+        if (benchmark->isFinished || (benchmark->remaining == 0)) {
+            return false;
+        }
+        startLoop(benchmark);
+        benchmark->scheduleTicks = readTicks();
+        benchmark->remaining--;
+        return true;
+    }
+    int64_t operation = benchmark->iterations - benchmark->remaining - 1;
+    int64_t intendedTicks = benchmark->scheduleTicks
+        + (int64_t) (operation * benchmark->intervalTicks);
+    int64_t latency = (int64_t) ((readTicks() - intendedTicks) / ticksPerNanosecond);
+    latency = (latency < 0) ? 0 : (latency > MAX_LATENCY) ? MAX_LATENCY : latency;
+    benchmark->histogram[histogramIndex(latency)]++;
+    if (latency > benchmark->maxLatency) {
+        benchmark->maxLatency = latency;
+    }
+    if (benchmark->remaining == 0) {
+        stopLoop(benchmark);
+        return false;
+    }
+    int64_t nextTicks = benchmark->scheduleTicks
+        + (int64_t) ((operation + 1) * benchmark->intervalTicks);
+    while (readTicks() < nextTicks) {
+        pauseSpinning();
+    }
+    benchmark->remaining--;
+    return true;
+}
+
+/**
+ * @brief Evicts the caches as described by a given `Eviction`.
+ *
+ * @note Every accessed byte is incremented rather than only read, so that the evicted cache lines
+ * of the benchmark are replaced by dirty ones, which is what they would compete with in a busy
+ * process.
+ *
+ * @param[in] eviction `Eviction` describing how to evict the caches.
+ */
+static void evictCaches(const Eviction* eviction) {
+    for (int64_t i = 0; i < eviction->size; i += eviction->stride) {
+        eviction->buffer[i]++;
+    }
+    scunit_clobberMemory();
+}
+
+/**
+ * @brief Determines whether the timed loop of a benchmark executed with cold caches should run
+ * another iteration, evicting the caches while timing is paused.
+ *
+ * @param[in, out] benchmark `SCUnitBenchmark` of the benchmark.
+ * @return `true` if another iteration should run, otherwise `false`.
+ */
+static bool keepEvicting(SCUnitBenchmark* benchmark) {
+    if (!benchmark->isRunning) {
+        if (benchmark->isFinished || (benchmark->remaining == 0)) {
+            return false;
+        }
+        startLoop(benchmark);
+    }
+    else if (benchmark->remaining == 0) {
+        stopLoop(benchmark);
+        return false;
+    }
+    scunit_benchmark_pauseTiming(benchmark);
+    evictCaches(benchmark->eviction);
+    scunit_benchmark_resumeTiming(benchmark);
+    benchmark->remaining--;
+    return true;
+}
+
+bool scunit_benchmark_keepRunning(SCUnitBenchmark* benchmark) {
+    if (benchmark->histogram != nullptr) {
+        return keepScheduling(benchmark);
+    }
+    if (benchmark->eviction != nullptr) {
+        return keepEvicting(benchmark);
+    }
+    if (benchmark->isRunning && (benchmark->remaining > 0)) {
+        benchmark->remaining--;
+        return true;
+    }
+    if (!benchmark->isRunning) {
+        if (benchmark->isFinished || (benchmark->remaining == 0)) {
+            return false;
+        }
+        startLoop(benchmark);
+        benchmark->remaining--;
+        return true;
+    }
+    stopLoop(benchmark);
+    return false;
+}
+
+int64_t scunit_benchmark_nextBatch(SCUnitBenchmark* benchmark, int64_t batchSize) {
+    if (!benchmark->isRunning) {
+        if (benchmark->isFinished || (benchmark->remaining == 0) || (batchSize < 1)) {
+            return 0;
+        }
+        startLoop(benchmark);
+        scunit_benchmark_pauseTiming(benchmark);
+    }
+    else if (benchmark->remaining == 0) {
+        stopLoop(benchmark);
+        return 0;
+    }
+    else {
+        scunit_benchmark_pauseTiming(benchmark);
+    }
+    int64_t batch = (batchSize < benchmark->remaining) ? batchSize : benchmark->remaining;
+    benchmark->remaining -= batch;
+    return batch;
+}
+
+void scunit_benchmark_pauseTiming(SCUnitBenchmark* benchmark) {
+    if (benchmark->isRunning && !benchmark->isPaused) {
+        benchmark->isPaused = true;
+        benchmark->pauseCount++;
+        benchmark->pauseTicks = readTicks();
+    }
+}
+
+void scunit_benchmark_resumeTiming(SCUnitBenchmark* benchmark) {
+    if (benchmark->isPaused) {
+        benchmark->pausedTicks += readTicks() - benchmark->pauseTicks;
+        benchmark->isPaused = false;
+    }
+}
+
+int64_t scunit_benchmark_getSize(const SCUnitBenchmark* benchmark) {
+    return benchmark->size;
+}
+
+int64_t scunit_benchmark_getIterations(const SCUnitBenchmark* benchmark) {
+    return benchmark->iterations;
+}
+
+int64_t scunit_benchmark_getThreadIndex(const SCUnitBenchmark* benchmark) {
+    return benchmark->threadIndex;
+}
+
+int64_t scunit_benchmark_getThreadCount(const SCUnitBenchmark* benchmark) {
+    return benchmark->threadCount;
+}
+
+void* scunit_benchmark_getSymbol(const SCUnitBenchmark* benchmark, const char* name) {
+    return dlsym((benchmark->library != nullptr) ? benchmark->library : RTLD_DEFAULT, name);
+}
+
+/**
+ * @brief Evaluates the function of a given complexity class for a given input size.
+ *
+ * @param[in] complexity `SCUnitComplexity` to evaluate.
+ * @param[in] size       Input size to evaluate the function for.
+ * @return The value of the function.
+ */
+static double evaluateComplexity(SCUnitComplexity complexity, int64_t size) {
+    double n = (double) size;
+    switch (complexity) {
+        case SCUNIT_COMPLEXITY_LOGARITHMIC:
+            return log2(n);
+        case SCUNIT_COMPLEXITY_LINEAR:
+            return n;
+        case SCUNIT_COMPLEXITY_LINEARITHMIC:
+            return n * log2(n);
+        case SCUNIT_COMPLEXITY_QUADRATIC:
+            return n * n;
+        default:
+            return 1.0;
+    }
+}
+
+/**
+ * @brief Fits the wall or CPU times of given samples to a given complexity class by least squares.
+ *
+ * @note The coefficient `c` minimizing the squared error of `t(n) = c * f(n)` is
+ * `sum(t * f) / sum(f * f)`.
+ *
+ * @param[in] samples    Samples to fit.
+ * @param[in] count      Number of samples.
+ * @param[in] complexity `SCUnitComplexity` to fit the times to.
+ * @param[in] isCpuTime  Whether the CPU times are fitted instead of the wall times.
+ * @return The coefficient `c` (in seconds) or NaN if the function is zero for all samples.
+ */
+static double fitCoefficient(
+    const Sample* samples,
+    int64_t count,
+    SCUnitComplexity complexity,
+    bool isCpuTime
+) {
+    double timesValues = 0.0;
+    double squaredValues = 0.0;
+    for (int64_t i = 0; i < count; i++) {
+        double value = evaluateComplexity(complexity, samples[i].size);
+        timesValues += (isCpuTime ? samples[i].cpuTime : samples[i].wallTime) * value;
+        squaredValues += value * value;
+    }
+    return (squaredValues > 0.0) ? timesValues / squaredValues : NAN;
+}
+
+/**
+ * @brief Fits the wall times of given samples to each complexity class by least squares and finds
+ * the best fit.
+ *
+ * @note For every class `f`, the coefficient `c` of `t(n) = c * f(n)` is found by
+ * `fitCoefficient()`. The classes are compared by their root mean square error relative to the
+ * mean time, so that the error is independent of the magnitude of the times.
+ *
+ * @param[in]  samples    Samples to fit.
+ * @param[in]  count      Number of samples.
+ * @param[out] complexity Best fitting `SCUnitComplexity`.
+ * @param[out] error      Relative root mean square error of the best fit.
+ */
+static void fitComplexity(
+    const Sample* samples,
+    int64_t count,
+    SCUnitComplexity* complexity,
+    double* error
+) {
+    double mean = 0.0;
+    for (int64_t i = 0; i < count; i++) {
+        mean += samples[i].wallTime;
+    }
+    mean /= count;
+    *complexity = SCUNIT_COMPLEXITY_CONSTANT;
+    *error = INFINITY;
+    for (SCUnitComplexity candidate = SCUNIT_COMPLEXITY_CONSTANT;
+            candidate <= SCUNIT_COMPLEXITY_QUADRATIC; candidate++) {
+        double coefficient = fitCoefficient(samples, count, candidate, false);
+        if (isnan(coefficient)) {
+            continue;
+        }
+        double squaredErrors = 0.0;
+        for (int64_t i = 0; i < count; i++) {
+            double residual = samples[i].wallTime
+                - (coefficient * evaluateComplexity(candidate, samples[i].size));
+            squaredErrors += residual * residual;
+        }
+        double candidateError = sqrt(squaredErrors / count) / mean;
+        // Ties are resolved in favor of the simpler class, which is tried first.
+        if (candidateError < *error) {
+            *complexity = candidate;
+            *error = candidateError;
+        }
+    }
+}
+
+/**
+ * @brief Fits the speedups of given samples to Amdahl's law by least squares.
+ *
+ * @note Amdahl's law `S(T) = 1 / (s + (1 - s) / T)` is linear in the serial fraction `s` when
+ * written as `1 / S - 1 / T = s * (1 - 1 / T)`, so `s` is `sum(x * y) / sum(x * x)` with
+ * `x = 1 - 1 / T` and `y = 1 / S - 1 / T`.
+ *
+ * @param[in] samples Samples to fit, the first one being the baseline of the speedups.
+ * @param[in] count   Number of samples.
+ * @return The serial fraction (between zero and one).
+ */
+static double fitSerialFraction(const Sample* samples, int64_t count) {
+    double baseline = samples[0].throughput / samples[0].threadCount;
+    double timesValues = 0.0;
+    double squaredValues = 0.0;
+    for (int64_t i = 0; i < count; i++) {
+        double inverseThreads = 1.0 / samples[i].threadCount;
+        double value = 1.0 - inverseThreads;
+        double speedup = samples[i].throughput / baseline;
+        timesValues += value * ((1.0 / speedup) - inverseThreads);
+        squaredValues += value * value;
+    }
+    if (squaredValues == 0.0) {
+        return 0.0;
+    }
+    double serialFraction = timesValues / squaredValues;
+    return (serialFraction < 0.0) ? 0.0 : (serialFraction > 1.0) ? 1.0 : serialFraction;
+}
+
+[[gnu::noinline]]
+void scunit_benchmark_callBody(
+    SCUnitBenchmarkFunction function,
+    SCUnitContext* context,
+    SCUnitBenchmark* benchmark
+) {
+    function(context, benchmark);
+    // Keeps the call from becoming a tail call, which would remove this frame from backtraces.
+    scunit_clobberMemory();
+}
+
+/**
+ * @brief Entry point of every POSIX thread executing the body of a benchmark.
+ *
+ * @param[in, out] argument Thread to execute.
+ * @return Always a `nullptr`.
+ */
+static void* executeWorker(void* argument) {
+    Worker* worker = argument;
+    scunit_benchmark_callBody(worker->function, worker->context, &worker->benchmark);
+    // A body returning before its timed loop (e. g. due to a failed assertion) still has to
+    // release the other threads waiting for it.
+    if (!worker->benchmark.hasArrived) {
+        atomic_fetch_add_explicit(worker->benchmark.arrivedThreads, 1, memory_order_acq_rel);
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Starts a given thread of a team, pinned to the next CPU available to the process.
+ *
+ * @param[in, out] team  Team of the thread.
+ * @param[in, out] index Index of the thread.
+ * @return `true` if the thread was started, otherwise `false`.
+ */
+static bool startWorker(Team* team, int64_t index) {
+    pthread_attr_t attributes;
+    if (pthread_attr_init(&attributes) != 0) {
+        return false;
+    }
+    if (team->cpuCount > 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(team->cpus[index % team->cpuCount], &cpuSet);
+        // Pinning is only a hint for more stable results, so the thread is started even without it.
+        pthread_attr_setaffinity_np(&attributes, sizeof(cpu_set_t), &cpuSet);
+    }
+    Worker* worker = &team->workers[index];
+    bool isStarted = pthread_create(&worker->handle, &attributes, executeWorker, worker) == 0;
+    pthread_attr_destroy(&attributes);
+    return isStarted;
+}
+
+/**
+ * @brief Merges the results of the threads of a team into a given `SCUnitContext`.
+ *
+ * @note The worst result of any thread is reported along with the message of the first thread
+ * having it, so that a failing benchmark is not reported once for every thread.
+ *
+ * @param[in]      team    Team to merge the results of.
+ * @param[in, out] context `SCUnitContext` of the benchmark.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError mergeResults(const Team* team, SCUnitContext* context) {
+    int64_t worstIndex = 0;
+    for (int64_t i = 1; i < team->threadCount; i++) {
+        if (scunit_context_getResult(team->workers[i].context)
+                > scunit_context_getResult(team->workers[worstIndex].context)) {
+            worstIndex = i;
+        }
+    }
+    SCUnitContext* worstContext = team->workers[worstIndex].context;
+    SCUnitResult result = scunit_context_getResult(worstContext);
+    if (result == SCUNIT_RESULT_PASS) {
+        return SCUNIT_ERROR_NONE;
+    }
+    SCUnitError error = scunit_context_appendMessage(
+        context,
+        "%s",
+        scunit_context_getMessage(worstContext)
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    if (result == SCUNIT_RESULT_FAIL) {
+        error = scunit_context_appendMessage(
+            context,
+            "  Failed on thread %" PRId64 " of %" PRId64 ".\n\n",
+            worstIndex,
+            team->threadCount
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    return scunit_context_setResult(context, result);
+}
+
+/**
+ * @brief Executes the body of a benchmark once on every thread of a team.
+ *
+ * @param[in, out] team       Team to execute the body on.
+ * @param[in, out] context    `SCUnitContext` of the benchmark.
+ * @param[in]      function   Body of the benchmark.
+ * @param[in]      size       Input size to execute the body for.
+ * @param[in]      iterations Number of iterations of the timed loop of every thread.
+ * @param[out]     benchmark  `SCUnitBenchmark` combining the threads, whose wall time spans from
+ *                            the first thread starting to the last one finishing its timed loop
+ *                            and whose CPU time is the sum of the ones of all threads.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_CREATING_THREAD_FAILED` if creating a thread failed and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+static SCUnitError runTeam(
+    Team* team,
+    SCUnitContext* context,
+    SCUnitBenchmarkFunction function,
+    int64_t size,
+    int64_t iterations,
+    SCUnitBenchmark* benchmark
+) {
+    atomic_store_explicit(&team->arrivedThreads, 0, memory_order_relaxed);
+    for (int64_t i = 0; i < team->threadCount; i++) {
+        Worker* worker = &team->workers[i];
+        scunit_context_reset(worker->context);
+        worker->function = function;
+        worker->benchmark = (SCUnitBenchmark) {
+            .size = size,
+            .iterations = iterations,
+            .remaining = iterations,
+            .cpuClockId = CLOCK_THREAD_CPUTIME_ID,
+            .threadIndex = i,
+            .threadCount = team->threadCount,
+            .arrivedThreads = &team->arrivedThreads
+        };
+    }
+    int64_t startedThreads = 0;
+    while ((startedThreads < team->threadCount) && startWorker(team, startedThreads)) {
+        startedThreads++;
+    }
+    if (startedThreads < team->threadCount) {
+        // Threads that were already started wait for the missing ones, which never arrive.
+        atomic_fetch_add_explicit(
+            &team->arrivedThreads,
+            team->threadCount - startedThreads,
+            memory_order_acq_rel
+        );
+    }
+    for (int64_t i = 0; i < startedThreads; i++) {
+        pthread_join(team->workers[i].handle, nullptr);
+    }
+    if (startedThreads < team->threadCount) {
+        return SCUNIT_ERROR_CREATING_THREAD_FAILED;
+    }
+    *benchmark = (SCUnitBenchmark) {
+        .size = size,
+        .iterations = iterations,
+        .isFinished = true,
+        .threadCount = team->threadCount
+    };
+    int64_t wallTimeEnd = 0;
+    for (int64_t i = 0; i < team->threadCount; i++) {
+        const SCUnitBenchmark* threadBenchmark = &team->workers[i].benchmark;
+        int64_t threadWallTimeEnd = threadBenchmark->wallTimeStart + threadBenchmark->wallTime;
+        if ((i == 0) || (threadBenchmark->wallTimeStart < benchmark->wallTimeStart)) {
+            benchmark->wallTimeStart = threadBenchmark->wallTimeStart;
+        }
+        if (threadWallTimeEnd > wallTimeEnd) {
+            wallTimeEnd = threadWallTimeEnd;
+        }
+        benchmark->cpuTime += threadBenchmark->cpuTime;
+        if (threadBenchmark->grossWallTime > benchmark->grossWallTime) {
+            benchmark->grossWallTime = threadBenchmark->grossWallTime;
+        }
+        benchmark->isFinished = benchmark->isFinished && threadBenchmark->isFinished;
+        benchmark->isClockFailed = benchmark->isClockFailed || threadBenchmark->isClockFailed;
+    }
+    benchmark->wallTime = wallTimeEnd - benchmark->wallTimeStart;
+    return mergeResults(team, context);
+}
+
+/**
+ * @brief Opens an attribute of a given cache of the first CPU in
+ * `/sys/devices/system/cpu/cpu0/cache`.
+ *
+ * @param[in] index     Index of the cache.
+ * @param[in] attribute Name of the attribute.
+ * @return The opened attribute or a `nullptr` if it does not exist.
+ */
+static FILE* openCacheAttribute(int index, const char* attribute) {
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/%s", index, attribute);
+    return fopen(path, "r");
+}
+
+/**
+ * @brief Reads the description of a given cache of the first CPU from
+ * `/sys/devices/system/cpu/cpu0/cache`.
+ *
+ * @note The number of CPUs sharing the cache is counted from its list of CPUs (e. g. `0-3,8-11`).
+ *
+ * @param[in]  index Index of the cache.
+ * @param[out] cache Description of the cache.
+ * @return `false` if no cache with the given index exists, otherwise `true`.
+ */
+static bool readCache(int index, Cache* cache) {
+    *cache = (Cache) { .type = "Unknown" };
+    FILE* file = openCacheAttribute(index, "size");
+    if (file == nullptr) {
+        return false;
+    }
+    int64_t size;
+    char unit = '\0';
+    if (fscanf(file, "%" SCNd64 "%c", &size, &unit) >= 1) {
+        cache->size = size * ((unit == 'K') ? 1'024 : (unit == 'M') ? 1'024 * 1'024 : 1);
+    }
+    fclose(file);
+    file = openCacheAttribute(index, "type");
+    if (file != nullptr) {
+        if (fscanf(file, "%15s", cache->type) != 1) {
+            strcpy(cache->type, "Unknown");
+        }
+        fclose(file);
+    }
+    file = openCacheAttribute(index, "level");
+    if (file != nullptr) {
+        if (fscanf(file, "%d", &cache->level) != 1) {
+            cache->level = 0;
+        }
+        fclose(file);
+    }
+    file = openCacheAttribute(index, "shared_cpu_list");
+    if (file != nullptr) {
+        int first;
+        while (fscanf(file, "%d", &first) == 1) {
+            int last = first;
+            if ((fscanf(file, "-%d", &last) == 1) && (last < first)) {
+                last = first;
+            }
+            cache->sharingCount += last - first + 1;
+            if (fgetc(file) != ',') {
+                break;
+            }
+        }
+        fclose(file);
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the size of the largest cache of the first CPU from
+ * `/sys/devices/system/cpu/cpu0/cache`.
+ *
+ * @return The size of the largest cache (in bytes) or zero if it could not be read.
+ */
+static int64_t readLargestCacheSize() {
+    int64_t largestSize = 0;
+    Cache cache;
+    for (int index = 0; (index < MAX_CACHE_INDEX) && readCache(index, &cache); index++) {
+        if (cache.size > largestSize) {
+            largestSize = cache.size;
+        }
+    }
+    return largestSize;
+}
+
+/**
+ * @brief Prepares the eviction of the caches for a given `SCUnitCacheState` and calibrates it.
+ *
+ * @note To evict the data caches, every cache line of a buffer twice the size of the largest
+ * cache is accessed, so that the buffer fills all levels even if they are not inclusive. To evict
+ * the entries of the TLB, a single byte of each of many pages is accessed instead. The calibration
+ * times an empty timed loop with the same eviction, which covers the misses the timing code itself
+ * suffers after an eviction.
+ *
+ * @param[in]  cacheState `SCUnitCacheState` to prepare the eviction for.
+ * @param[out] eviction   Prepared `Eviction`, whose buffer must be deallocated using
+ *                        `SCUNIT_FREE()`.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if calibrating the eviction failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError prepareEviction(SCUnitCacheState cacheState, Eviction* eviction) {
+    *eviction = (Eviction) { .cacheState = cacheState };
+    if (cacheState == SCUNIT_CACHE_STATE_COLD) {
+        int64_t cacheSize = readLargestCacheSize();
+        eviction->size = (cacheSize > 0) ? 2 * cacheSize : DEFAULT_EVICTION_SIZE;
+        eviction->stride = CACHE_LINE_SIZE;
+    }
+    else {
+        long pageSize = sysconf(_SC_PAGESIZE);
+        eviction->stride = (pageSize > 0) ? pageSize : 4'096;
+        eviction->size = EVICTION_PAGES * eviction->stride;
+    }
+    eviction->buffer = SCUNIT_CALLOC(eviction->size, 1);
+    if (eviction->buffer == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    int64_t overhead = INT64_MAX;
+    for (int64_t run = 0; run < EVICTION_CALIBRATION_RUNS; run++) {
+        SCUnitBenchmark benchmark = {
+            .iterations = EVICTION_CALIBRATION_ITERATIONS,
+            .remaining = EVICTION_CALIBRATION_ITERATIONS,
+            .cpuClockId = CLOCK_PROCESS_CPUTIME_ID,
+            .threadCount = 1,
+            .eviction = eviction
+        };
+        while (scunit_benchmark_keepRunning(&benchmark)) {
+        }
+        if (benchmark.isClockFailed) {
+            return SCUNIT_ERROR_TIMER_FAILED;
+        }
+        if ((benchmark.wallTime / EVICTION_CALIBRATION_ITERATIONS) < overhead) {
+            overhead = benchmark.wallTime / EVICTION_CALIBRATION_ITERATIONS;
+        }
+    }
+    eviction->overhead = overhead;
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Checks whether a single execution of the body of a benchmark succeeded.
+ *
+ * @param[in, out] context   `SCUnitContext` of the benchmark.
+ * @param[in]      benchmark `SCUnitBenchmark` the body was executed with.
+ * @param[out]     isStopped Whether the benchmark has to be stopped, since the body failed, was
+ *                           skipped or did not run its timed loop to completion.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the benchmark failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError checkAttempt(
+    SCUnitContext* context,
+    const SCUnitBenchmark* benchmark,
+    bool* isStopped
+) {
+    if (benchmark->isClockFailed) {
+        return SCUNIT_ERROR_TIMER_FAILED;
+    }
+    if (scunit_context_getResult(context) != SCUNIT_RESULT_PASS) {
+        *isStopped = true;
+        return SCUNIT_ERROR_NONE;
+    }
+    if (benchmark->isFinished) {
+        return SCUNIT_ERROR_NONE;
+    }
+    *isStopped = true;
+    SCUnitError error = scunit_context_appendMessage(
+        context,
+        "\n  The benchmark did not run its timed loop to completion (input size %" PRId64 ").\n\n",
+        benchmark->size
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+}
+
+/**
+ * @brief Measures the body of a benchmark for a single input size.
+ *
+ * @note The number of iterations starts at one and grows with every attempt based on the time
+ * measured so far, until the timed loop runs for at least the minimum time.
+ *
+ * @param[in, out] context   `SCUnitContext` of the benchmark.
+ * @param[in, out] benchmark `SCUnitBenchmark` to execute the body with.
+ * @param[in]      function  Body of the benchmark.
+ * @param[in, out] team      Team to execute the body on or a `nullptr` to execute it on the
+ *                           calling thread.
+ * @param[in]      eviction  Eviction of the caches before every iteration or a `nullptr` to leave
+ *                           the caches warm.
+ * @param[in]      library   Handle of the library to resolve symbols from or a `nullptr` to
+ *                           resolve them from the global scope.
+ * @param[in]      size      Input size to measure.
+ * @param[out]     sample    Measurement for the input size.
+ * @param[out]     isStopped Whether the benchmark was stopped, since the body failed, was skipped
+ *                           or did not run its timed loop to completion.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the benchmark failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError measureSize(
+    SCUnitContext* context,
+    SCUnitBenchmark* benchmark,
+    SCUnitBenchmarkFunction function,
+    Team* team,
+    const Eviction* eviction,
+    void* library,
+    int64_t size,
+    Sample* sample,
+    bool* isStopped
+) {
+    int64_t minTime = scunit_getBenchmarkMinTime();
+    int64_t iterations = 1;
+    while (true) {
+        if (team != nullptr) {
+            SCUnitError error = runTeam(team, context, function, size, iterations, benchmark);
+            if (error != SCUNIT_ERROR_NONE) {
+                return error;
+            }
+        }
+        else {
+            *benchmark = (SCUnitBenchmark) {
+                .size = size,
+                .iterations = iterations,
+                .remaining = iterations,
+                .cpuClockId = CLOCK_PROCESS_CPUTIME_ID,
+                .threadCount = 1,
+                .eviction = eviction,
+                .library = library
+            };
+            scunit_benchmark_callBody(function, context, benchmark);
+        }
+        SCUnitError error = checkAttempt(context, benchmark, isStopped);
+        if ((error != SCUNIT_ERROR_NONE) || *isStopped) {
+            return error;
+        }
+        // Paused time partially counts towards the minimum time, so that a body pausing for most
+        // of its time does not run for many times as long.
+        int64_t measuredTime = benchmark->grossWallTime / MAX_PAUSED_FACTOR;
+        if (benchmark->wallTime > measuredTime) {
+            measuredTime = benchmark->wallTime;
+        }
+        if ((measuredTime >= minTime) || (iterations >= MAX_ITERATIONS)) {
+            break;
+        }
+        double factor = (measuredTime > 0)
+            ? (OVERESTIMATION_FACTOR * minTime) / measuredTime
+            : MAX_GROWTH_FACTOR;
+        if (factor > MAX_GROWTH_FACTOR) {
+            factor = MAX_GROWTH_FACTOR;
+        }
+        int64_t nextIterations = (int64_t) (iterations * factor);
+        iterations = (nextIterations > iterations) ? nextIterations : iterations + 1;
+        if (iterations > MAX_ITERATIONS) {
+            iterations = MAX_ITERATIONS;
+        }
+    }
+    // The latency of a single thread is averaged over all threads, which may finish at different
+    // times, while the throughput is based on the time span of all threads together.
+    int64_t threadCount = benchmark->threadCount;
+    int64_t threadWallTime = benchmark->wallTime * threadCount;
+    if (team != nullptr) {
+        threadWallTime = 0;
+        for (int64_t i = 0; i < threadCount; i++) {
+            threadWallTime += team->workers[i].benchmark.wallTime;
+        }
+    }
+    double totalIterations = (double) iterations * threadCount;
+    *sample = (Sample) {
+        .size = size,
+        .threadCount = threadCount,
+        .iterations = iterations,
+        .wallTime = threadWallTime / totalIterations / NANOSECONDS_PER_SECOND,
+        .cpuTime = benchmark->cpuTime / totalIterations / NANOSECONDS_PER_SECOND,
+        .throughput = (benchmark->wallTime > 0)
+            ? (totalIterations * NANOSECONDS_PER_SECOND) / benchmark->wallTime
+            : INFINITY
+    };
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Converts a given rate to the most suitable unit.
+ *
+ * @param[in]  rate       Rate to convert (per second).
+ * @param[out] unitString A string for the unit of the converted rate.
+ * @return The converted rate.
+ */
+static double toRate(double rate, const char** unitString) {
+    size_t unit = 0;
+    while ((rate >= 1000.0)
+            && (unit < (sizeof(RATE_UNIT_STRINGS) / sizeof(RATE_UNIT_STRINGS[0])) - 1)) {
+        rate /= 1000.0;
+        unit++;
+    }
+    *unitString = RATE_UNIT_STRINGS[unit];
+    return rate;
+}
+
+/**
+ * @brief Appends the results of a benchmark executed at a target rate to a given
+ * `SCUnitContext`.
+ *
+ * @param[in, out] context   `SCUnitContext` to append the results to.
+ * @param[in]      options   Options of the benchmark.
+ * @param[in]      benchmark `SCUnitBenchmark` the latencies were recorded by.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendLatencyResults(
+    SCUnitContext* context,
+    const SCUnitBenchmarkOptions* options,
+    const SCUnitBenchmark* benchmark
+) {
+    const char* targetUnitString;
+    const char* achievedUnitString;
+    double targetRate = toRate(options->targetRate, &targetUnitString);
+    double achievedRate = toRate(
+        ((double) benchmark->iterations * NANOSECONDS_PER_SECOND) / benchmark->grossWallTime,
+        &achievedUnitString
+    );
+    SCUnitError error = scunit_context_appendMessage(
+        context,
+        "\n  Latency: %" PRId64 " operations at %.3F %s (achieved: %.3F %s).\n\n",
+        benchmark->iterations,
+        targetRate,
+        targetUnitString,
+        achievedRate,
+        achievedUnitString
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    for (size_t i = 0; i < (sizeof(PERCENTILES) / sizeof(PERCENTILES[0])); i++) {
+        SCUnitMeasurement measurement = scunit_timer_toMeasurement(
+            ((double) findPercentile(benchmark, PERCENTILES[i])) / NANOSECONDS_PER_SECOND
+        );
+        char label[16];
+        snprintf(label, sizeof(label), "p%g", PERCENTILES[i]);
+        error = scunit_context_appendMessage(
+            context,
+            "  %9s  %10.3F %s\n",
+            label,
+            measurement.time,
+            measurement.timeUnitString
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    SCUnitMeasurement maxLatency = scunit_timer_toMeasurement(
+        ((double) benchmark->maxLatency) / NANOSECONDS_PER_SECOND
+    );
+    return scunit_context_appendMessage(
+        context,
+        "  %9s  %10.3F %s\n\n",
+        "max",
+        maxLatency.time,
+        maxLatency.timeUnitString
+    );
+}
+
+/**
+ * @brief Appends the results of a benchmark executed on a range of numbers of threads to a given
+ * `SCUnitContext`.
+ *
+ * @param[in, out] context     `SCUnitContext` to append the results to.
+ * @param[in]      options     Options of the benchmark.
+ * @param[in]      samples     Measurements of the benchmark.
+ * @param[in]      count       Number of measurements.
+ * @param[in]      cappedCount Number of CPUs available if greater numbers of threads were skipped,
+ *                             otherwise zero.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendThreadResults(
+    SCUnitContext* context,
+    const SCUnitBenchmarkOptions* options,
+    const Sample* samples,
+    int64_t count,
+    int64_t cappedCount
+) {
+    SCUnitError error = scunit_context_appendMessage(
+        context,
+        "\n  %8s  %12s  %14s  %14s  %8s  %10s\n",
+        "Threads",
+        "Iterations",
+        "Throughput",
+        "Latency",
+        "Speedup",
+        "Efficiency"
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    double baseline = samples[0].throughput / samples[0].threadCount;
+    for (int64_t i = 0; i < count; i++) {
+        const char* unitString;
+        double throughput = toRate(samples[i].throughput, &unitString);
+        SCUnitMeasurement latency = scunit_timer_toMeasurement(samples[i].wallTime);
+        double speedup = samples[i].throughput / baseline;
+        error = scunit_context_appendMessage(
+            context,
+            "  %8" PRId64 "  %12" PRId64 "  %10.3F %-3s  %10.3F %-3s  %7.2Fx  %8.1F %%\n",
+            samples[i].threadCount,
+            samples[i].iterations,
+            throughput,
+            unitString,
+            latency.time,
+            latency.timeUnitString,
+            speedup,
+            (speedup / samples[i].threadCount) * 100.0
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    error = scunit_context_appendMessage(context, "\n");
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    if (cappedCount > 0) {
+        error = scunit_context_appendMessage(
+            context,
+            "  Stopped at %" PRId64 " threads, since only %" PRId64 " CPUs are available.\n\n",
+            samples[count - 1].threadCount,
+            cappedCount
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    if (count == 1) {
+        return SCUNIT_ERROR_NONE;
+    }
+    double serialFraction = fitSerialFraction(samples, count);
+    if (serialFraction > 0.0) {
+        error = scunit_context_appendMessage(
+            context,
+            "  Serial fraction (Amdahl): %.1F %% (maximum speedup: %.1Fx).\n\n",
+            serialFraction * 100.0,
+            1.0 / serialFraction
+        );
+    }
+    else {
+        error = scunit_context_appendMessage(
+            context,
+            "  Serial fraction (Amdahl): 0.0 %% (maximum speedup: unbounded).\n\n"
+        );
+    }
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    if ((options->maxSerialFraction <= 0.0) || (serialFraction <= options->maxSerialFraction)) {
+        return SCUNIT_ERROR_NONE;
+    }
+    error = scunit_context_appendMessage(
+        context,
+        "  Scalability degraded: expected a serial fraction of at most %.1F %%, but measured "
+            "%.1F %%.\n\n",
+        options->maxSerialFraction * 100.0,
+        serialFraction * 100.0
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+}
+
+/**
+ * @brief Appends the results of a benchmark to a given `SCUnitContext`.
+ *
+ * @param[in, out] context `SCUnitContext` to append the results to.
+ * @param[in]      options Options of the benchmark.
+ * @param[in]      samples Measurements of the benchmark.
+ * @param[in]      count   Number of measurements.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendResults(
+    SCUnitContext* context,
+    const SCUnitBenchmarkOptions* options,
+    const Sample* samples,
+    int64_t count
+) {
+    SCUnitError error;
+    if (count == 1) {
+        SCUnitMeasurement wallTime = scunit_timer_toMeasurement(samples[0].wallTime);
+        SCUnitMeasurement cpuTime = scunit_timer_toMeasurement(samples[0].cpuTime);
+        return scunit_context_appendMessage(
+            context,
+            "\n  Benchmark: %.3F %s per iteration (CPU: %.3F %s), %" PRId64 " iterations.\n\n",
+            wallTime.time,
+            wallTime.timeUnitString,
+            cpuTime.time,
+            cpuTime.timeUnitString,
+            samples[0].iterations
+        );
+    }
+    error = scunit_context_appendMessage(
+        context,
+        "\n  %14s  %12s  %14s  %14s\n",
+        "Size",
+        "Iterations",
+        "Time",
+        "CPU"
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    for (int64_t i = 0; i < count; i++) {
+        SCUnitMeasurement wallTime = scunit_timer_toMeasurement(samples[i].wallTime);
+        SCUnitMeasurement cpuTime = scunit_timer_toMeasurement(samples[i].cpuTime);
+        error = scunit_context_appendMessage(
+            context,
+            "  %14" PRId64 "  %12" PRId64 "  %10.3F %-3s  %10.3F %s\n",
+            samples[i].size,
+            samples[i].iterations,
+            wallTime.time,
+            wallTime.timeUnitString,
+            cpuTime.time,
+            cpuTime.timeUnitString
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    SCUnitComplexity complexity;
+    double rmsError;
+    fitComplexity(samples, count, &complexity, &rmsError);
+    error = scunit_context_appendMessage(
+        context,
+        "\n  Complexity: %s (RMS error: %.1F %%).\n\n",
+        COMPLEXITY_STRINGS[complexity],
+        rmsError * 100.0
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    if (!options->isComplexityChecked || (complexity <= options->expectedComplexity)) {
+        return SCUNIT_ERROR_NONE;
+    }
+    error = scunit_context_appendMessage(
+        context,
+        "  Complexity degraded: expected at most %s, but measured %s.\n\n",
+        COMPLEXITY_STRINGS[options->expectedComplexity],
+        COMPLEXITY_STRINGS[complexity]
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+}
+
+/**
+ * @brief Records a run of a benchmark for the report in the format of Google Benchmark.
+ *
+ * @param[in] name     Name of the benchmark.
+ * @param[in] suffix   Suffix distinguishing the run from the other runs of the benchmark (e. g.
+ *                     `/64`) or an empty string.
+ * @param[in] instance Index of the run within the runs of the benchmark.
+ * @param[in] sample   Measurement of the run.
+ * @param[in] members  Additional members of the JSON object of the run, each preceded by a
+ *                     separator, or an empty string.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError recordRun(
+    const char* name,
+    const char* suffix,
+    int64_t instance,
+    const Sample* sample,
+    const char* members
+) {
+    SCUnitError error = scunit_rasnprintf(
+        &report,
+        &reportSize,
+        "%s    {\n"
+        "      \"name\": \"%s%s\",\n"
+        "      \"family_index\": %" PRId64 ",\n"
+        "      \"per_family_instance_index\": %" PRId64 ",\n"
+        "      \"run_name\": \"%s%s\",\n"
+        "      \"run_type\": \"iteration\",\n"
+        "      \"repetitions\": 1,\n"
+        "      \"repetition_index\": 0,\n"
+        "      \"threads\": %" PRId64 ",\n"
+        "      \"iterations\": %" PRId64 ",\n"
+        "      \"real_time\": %.17g,\n"
+        "      \"cpu_time\": %.17g,\n"
+        "      \"time_unit\": \"ns\"",
+        (report != nullptr) ? ",\n" : "",
+        name,
+        suffix,
+        recordedBenchmarks,
+        instance,
+        name,
+        suffix,
+        sample->threadCount,
+        sample->iterations,
+        sample->wallTime * NANOSECONDS_PER_SECOND,
+        sample->cpuTime * NANOSECONDS_PER_SECOND
+    );
+    if ((error == SCUNIT_ERROR_NONE) && isfinite(sample->throughput)) {
+        error = scunit_rasnprintf(
+            &report,
+            &reportSize,
+            ",\n      \"items_per_second\": %.17g",
+            sample->throughput
+        );
+    }
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_rasnprintf(&report, &reportSize, "%s\n    }", members);
+}
+
+/**
+ * @brief Records the runs of a benchmark executed for a range of input sizes or numbers of threads
+ * for the report in the format of Google Benchmark.
+ *
+ * @note Like Google Benchmark, the best fitting complexity class of more than one input size is
+ * recorded as two aggregates, `<name>_BigO` with the coefficients (in nanoseconds) and `<name>_RMS`
+ * with the relative root mean square error.
+ *
+ * @param[in] name       Name of the benchmark.
+ * @param[in] options    Options of the benchmark.
+ * @param[in] samples    Measurements of the benchmark.
+ * @param[in] count      Number of measurements.
+ * @param[in] hasThreads Whether the measurements are for numbers of threads rather than input
+ *                       sizes.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError recordSamples(
+    const char* name,
+    const SCUnitBenchmarkOptions* options,
+    const Sample* samples,
+    int64_t count,
+    bool hasThreads
+) {
+    char members[64] = "";
+    if (options->cacheState != SCUNIT_CACHE_STATE_WARM) {
+        snprintf(
+            members,
+            sizeof(members),
+            ",\n      \"label\": \"%s caches\"",
+            CACHE_STATE_STRINGS[options->cacheState]
+        );
+    }
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    for (int64_t i = 0; (i < count) && (error == SCUNIT_ERROR_NONE); i++) {
+        char suffix[32] = "";
+        if (hasThreads) {
+            snprintf(suffix, sizeof(suffix), "/threads:%" PRId64, samples[i].threadCount);
+        }
+        else if (count > 1) {
+            snprintf(suffix, sizeof(suffix), "/%" PRId64, samples[i].size);
+        }
+        error = recordRun(name, suffix, i, &samples[i], members);
+    }
+    if ((error == SCUNIT_ERROR_NONE) && !hasThreads && (count > 1)) {
+        SCUnitComplexity complexity;
+        double rmsError;
+        fitComplexity(samples, count, &complexity, &rmsError);
+        error = scunit_rasnprintf(
+            &report,
+            &reportSize,
+            ",\n    {\n"
+            "      \"name\": \"%s_BigO\",\n"
+            "      \"family_index\": %" PRId64 ",\n"
+            "      \"per_family_instance_index\": %" PRId64 ",\n"
+            "      \"run_name\": \"%s\",\n"
+            "      \"run_type\": \"aggregate\",\n"
+            "      \"repetitions\": 1,\n"
+            "      \"threads\": 1,\n"
+            "      \"aggregate_name\": \"BigO\",\n"
+            "      \"aggregate_unit\": \"time\",\n"
+            "      \"cpu_coefficient\": %.17g,\n"
+            "      \"real_coefficient\": %.17g,\n"
+            "      \"big_o\": \"%s\",\n"
+            "      \"time_unit\": \"ns\"\n"
+            "    },\n"
+            "    {\n"
+            "      \"name\": \"%s_RMS\",\n"
+            "      \"family_index\": %" PRId64 ",\n"
+            "      \"per_family_instance_index\": %" PRId64 ",\n"
+            "      \"run_name\": \"%s\",\n"
+            "      \"run_type\": \"aggregate\",\n"
+            "      \"repetitions\": 1,\n"
+            "      \"threads\": 1,\n"
+            "      \"aggregate_name\": \"RMS\",\n"
+            "      \"aggregate_unit\": \"percentage\",\n"
+            "      \"rms\": %.17g\n"
+            "    }",
+            name,
+            recordedBenchmarks,
+            count,
+            name,
+            fitCoefficient(samples, count, complexity, true) * NANOSECONDS_PER_SECOND,
+            fitCoefficient(samples, count, complexity, false) * NANOSECONDS_PER_SECOND,
+            GBENCH_COMPLEXITY_STRINGS[complexity],
+            name,
+            recordedBenchmarks,
+            count,
+            name,
+            isfinite(rmsError) ? rmsError : 0.0
+        );
+    }
+    recordedBenchmarks++;
+    return error;
+}
+
+/**
+ * @brief Records the run of a benchmark executed at a target rate for the report in the format of
+ * Google Benchmark.
+ *
+ * @note The wall time is the mean latency (as recorded by the histogram), the throughput is the
+ * rate actually achieved, and the target rate and the percentiles of the latencies (in
+ * nanoseconds) are recorded as the counters `target_rate`, `p50`, `p90`, `p99`, `p99.9` and `max`.
+ *
+ * @param[in] name      Name of the benchmark.
+ * @param[in] options   Options of the benchmark.
+ * @param[in] benchmark `SCUnitBenchmark` the latencies were recorded by.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError recordLatencies(
+    const char* name,
+    const SCUnitBenchmarkOptions* options,
+    const SCUnitBenchmark* benchmark
+) {
+    double totalLatency = 0.0;
+    for (int64_t i = 0; i < HISTOGRAM_SIZE; i++) {
+        totalLatency += ((double) benchmark->histogram[i]) * histogramValue(i);
+    }
+    Sample sample = {
+        .size = benchmark->size,
+        .threadCount = 1,
+        .iterations = benchmark->iterations,
+        .wallTime = totalLatency / benchmark->iterations / NANOSECONDS_PER_SECOND,
+        .cpuTime = ((double) benchmark->cpuTime) / benchmark->iterations / NANOSECONDS_PER_SECOND,
+        .throughput = ((double) benchmark->iterations * NANOSECONDS_PER_SECOND)
+            / benchmark->grossWallTime
+    };
+    char* members = nullptr;
+    int64_t size = 0;
+    SCUnitError error = scunit_rasnprintf(
+        &members,
+        &size,
+        ",\n      \"target_rate\": %.17g",
+        options->targetRate
+    );
+    for (size_t i = 0;
+            (i < (sizeof(PERCENTILES) / sizeof(PERCENTILES[0]))) && (error == SCUNIT_ERROR_NONE);
+            i++) {
+        error = scunit_rasnprintf(
+            &members,
+            &size,
+            ",\n      \"p%g\": %" PRId64,
+            PERCENTILES[i],
+            findPercentile(benchmark, PERCENTILES[i])
+        );
+    }
+    if (error == SCUNIT_ERROR_NONE) {
+        error = scunit_rasnprintf(
+            &members,
+            &size,
+            ",\n      \"max\": %" PRId64,
+            benchmark->maxLatency
+        );
+    }
+    if (error == SCUNIT_ERROR_NONE) {
+        error = recordRun(name, "", 0, &sample, members);
+    }
+    SCUNIT_FREE(members);
+    recordedBenchmarks++;
+    return error;
+}
+
+/**
+ * @brief Determines the input size following a given one.
+ *
+ * @note The sizes are the first size multiplied repeatedly, followed by the last size itself if the
+ * multiplication overshoots it (or would overflow).
+ *
+ * @param[in] size    Current input size.
+ * @param[in] options Options of the benchmark.
+ * @return The next input size.
+ */
+static int64_t nextSize(int64_t size, const SCUnitBenchmarkOptions* options) {
+    if ((options->multiplier < 2) || (size > (options->lastSize / options->multiplier))) {
+        return options->lastSize;
+    }
+    return size * options->multiplier;
+}
+
+/**
+ * @brief Counts the input sizes a benchmark is executed for.
+ *
+ * @param[in] options Options of the benchmark.
+ * @return The number of input sizes.
+ */
+static int64_t countSizes(const SCUnitBenchmarkOptions* options) {
+    int64_t count = 1;
+    for (int64_t size = options->firstSize; size < options->lastSize; count++) {
+        size = nextSize(size, options);
+    }
+    return count;
+}
+
+/**
+ * @brief Executes a benchmark at a target rate and reports the latencies of its operations to a
+ * given `SCUnitContext`.
+ *
+ * @note The number of operations is chosen so that the timed loop runs for the minimum time at
+ * the target rate. Unlike other benchmarks, the body is executed only once, since the number of
+ * operations does not depend on how long they take.
+ *
+ * @param[in, out] context  `SCUnitContext` of the benchmark.
+ * @param[in]      name     Name of the benchmark.
+ * @param[in]      options  Options of the benchmark.
+ * @param[in]      function Body of the benchmark.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the benchmark failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError measureLatency(
+    SCUnitContext* context,
+    const char* name,
+    const SCUnitBenchmarkOptions* options,
+    SCUnitBenchmarkFunction function
+) {
+    int64_t* histogram = SCUNIT_CALLOC(HISTOGRAM_SIZE, sizeof(int64_t));
+    if (histogram == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    double operations = ceil(
+        (options->targetRate * scunit_getBenchmarkMinTime()) / NANOSECONDS_PER_SECOND
+    );
+    int64_t iterations = (operations > MAX_ITERATIONS) ? MAX_ITERATIONS : (int64_t) operations;
+    SCUnitBenchmark benchmark = {
+        .size = options->firstSize,
+        .iterations = iterations,
+        .remaining = iterations,
+        .cpuClockId = CLOCK_PROCESS_CPUTIME_ID,
+        .threadCount = 1,
+        .histogram = histogram,
+        .intervalTicks = (ticksPerNanosecond * NANOSECONDS_PER_SECOND) / options->targetRate
+    };
+    scunit_benchmark_callBody(function, context, &benchmark);
+    bool isStopped = false;
+    SCUnitError error = checkAttempt(context, &benchmark, &isStopped);
+    if ((error == SCUNIT_ERROR_NONE) && !isStopped) {
+        error = appendLatencyResults(context, options, &benchmark);
+    }
+    if ((error == SCUNIT_ERROR_NONE) && !isStopped
+            && (scunit_getBenchmarkFormat() == SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON)) {
+        error = recordLatencies(name, options, &benchmark);
+    }
+    SCUNIT_FREE(histogram);
+    return error;
+}
+
+/**
+ * @brief Determines the number of threads following a given one.
+ *
+ * @param[in] threadCount     Current number of threads.
+ * @param[in] lastThreadCount Last number of threads.
+ * @return The next number of threads.
+ */
+static int64_t nextThreadCount(int64_t threadCount, int64_t lastThreadCount) {
+    return (threadCount > (lastThreadCount / 2)) ? lastThreadCount : threadCount * 2;
+}
+
+/**
+ * @brief Executes a benchmark on a range of numbers of threads and reports its results to a given
+ * `SCUnitContext`.
+ *
+ * @param[in, out] context  `SCUnitContext` of the benchmark.
+ * @param[in]      name     Name of the benchmark.
+ * @param[in]      options  Options of the benchmark.
+ * @param[in]      function Body of the benchmark.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_CREATING_THREAD_FAILED` if creating a thread failed,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the benchmark failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError executeOnThreads(
+    SCUnitContext* context,
+    const char* name,
+    const SCUnitBenchmarkOptions* options,
+    SCUnitBenchmarkFunction function
+) {
+    cpu_set_t cpuSet;
+    int64_t cpuCount = 0;
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0) {
+        cpuCount = CPU_COUNT(&cpuSet);
+    }
+    int64_t lastThreadCount = options->lastThreads;
+    int64_t cappedCount = 0;
+    if ((cpuCount > 0) && (lastThreadCount > cpuCount)) {
+        lastThreadCount = (options->firstThreads > cpuCount) ? options->firstThreads : cpuCount;
+        cappedCount = cpuCount;
+    }
+    int64_t count = 1;
+    for (int64_t threads = options->firstThreads; threads < lastThreadCount; count++) {
+        threads = nextThreadCount(threads, lastThreadCount);
+    }
+    int* cpus = SCUNIT_MALLOC(((cpuCount > 0) ? cpuCount : 1) * sizeof(int));
+    Sample* samples = SCUNIT_MALLOC(count * sizeof(Sample));
+    Worker* workers = SCUNIT_MALLOC(lastThreadCount * sizeof(Worker));
+    int64_t contextCount = 0;
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    if ((cpus == nullptr) || (samples == nullptr) || (workers == nullptr)) {
+        error = SCUNIT_ERROR_OUT_OF_MEMORY;
+        goto finished;
+    }
+    for (int cpu = 0, i = 0; i < cpuCount; cpu++) {
+        if (CPU_ISSET(cpu, &cpuSet)) {
+            cpus[i++] = cpu;
+        }
+    }
+    for (; contextCount < lastThreadCount; contextCount++) {
+        workers[contextCount].context = scunit_context_new();
+        if (workers[contextCount].context == nullptr) {
+            error = SCUNIT_ERROR_OUT_OF_MEMORY;
+            goto finished;
+        }
+    }
+    Team team = { .workers = workers, .cpus = cpus, .cpuCount = cpuCount };
+    SCUnitBenchmark benchmark;
+    int64_t threadCount = options->firstThreads;
+    for (int64_t i = 0; i < count; i++) {
+        bool isStopped = false;
+        team.threadCount = threadCount;
+        error = measureSize(
+            context,
+            &benchmark,
+            function,
+            &team,
+            nullptr,
+            nullptr,
+            options->firstSize,
+            &samples[i],
+            &isStopped
+        );
+        if ((error != SCUNIT_ERROR_NONE) || isStopped) {
+            goto finished;
+        }
+        threadCount = nextThreadCount(threadCount, lastThreadCount);
+    }
+    error = appendThreadResults(context, options, samples, count, cappedCount);
+    if ((error == SCUNIT_ERROR_NONE)
+            && (scunit_getBenchmarkFormat() == SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON)) {
+        error = recordSamples(name, options, samples, count, true);
+    }
+finished:
+    for (int64_t i = 0; i < contextCount; i++) {
+        scunit_context_free(workers[i].context);
+    }
+    SCUNIT_FREE(workers);
+    SCUNIT_FREE(samples);
+    SCUNIT_FREE(cpus);
+    return error;
+}
+
+/**
+ * @brief Approximates the quantile of Student's t-distribution for a two-sided 95 % confidence
+ * level.
+ *
+ * @note The Cornish-Fisher expansion around the quantile of the standard normal distribution is
+ * accurate to three decimal places for five or more degrees of freedom.
+ *
+ * @param[in] degreesOfFreedom Degrees of freedom.
+ * @return The quantile.
+ */
+static double findStudentQuantile(int64_t degreesOfFreedom) {
+    double z = NORMAL_QUANTILE;
+    double z3 = z * z * z;
+    double z5 = z3 * z * z;
+    double z7 = z5 * z * z;
+    double n = (double) degreesOfFreedom;
+    return z + ((z3 + z) / (4.0 * n)) + (((5.0 * z5) + (16.0 * z3) + (3.0 * z)) / (96.0 * n * n))
+        + (((3.0 * z7) + (19.0 * z5) + (17.0 * z3) - (15.0 * z)) / (384.0 * n * n * n));
+}
+
+/**
+ * @brief Compares two libraries by executing the body of a benchmark with each of them for a
+ * single input size.
+ *
+ * @note The number of iterations of a sample is calibrated with the first library, so that a
+ * sample runs for a fraction of the minimum time. Pairs of samples are then measured, one with each
+ * library in a random order, so that any drift of the machine (e. g. its temperature or other
+ * load) affects both libraries alike and cancels out in the difference within each pair. The
+ * confidence interval of the mean difference follows from the spread of these paired differences.
+ *
+ * @param[in, out] context    `SCUnitContext` of the benchmark.
+ * @param[in, out] benchmark  `SCUnitBenchmark` to execute the body with.
+ * @param[in]      function   Body of the benchmark.
+ * @param[in]      eviction   Eviction of the caches before every iteration or a `nullptr` to leave
+ *                            the caches warm.
+ * @param[in]      libraries  Handles of the two libraries to compare.
+ * @param[in, out] random     `SCUnitRandom` the order within each pair is chosen by.
+ * @param[in]      size       Input size to compare the libraries for.
+ * @param[out]     comparison Comparison for the input size.
+ * @param[out]     isStopped  Whether the benchmark was stopped, since the body failed, was skipped
+ *                            or did not run its timed loop to completion.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the benchmark failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError compareSize(
+    SCUnitContext* context,
+    SCUnitBenchmark* benchmark,
+    SCUnitBenchmarkFunction function,
+    const Eviction* eviction,
+    void* const* libraries,
+    SCUnitRandom* random,
+    int64_t size,
+    Comparison* comparison,
+    bool* isStopped
+) {
+    Sample sample;
+    SCUnitError error = measureSize(
+        context,
+        benchmark,
+        function,
+        nullptr,
+        eviction,
+        libraries[0],
+        size,
+        &sample,
+        isStopped
+    );
+    if ((error != SCUNIT_ERROR_NONE) || *isStopped) {
+        return error;
+    }
+    int64_t iterations = sample.iterations / AB_SAMPLE_DIVISOR;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+    double times[2] = { };
+    double differences[AB_PAIRS];
+    double meanDifference = 0.0;
+    // The first pair only warms up the second library (the first one is warm from calibrating) and
+    // is discarded.
+    for (int64_t pair = -1; pair < AB_PAIRS; pair++) {
+        int64_t first = scunit_random_int64(random, 0, 1);
+        double pairTimes[2];
+        for (int64_t i = 0; i < 2; i++) {
+            int64_t library = first ^ i;
+            *benchmark = (SCUnitBenchmark) {
+                .size = size,
+                .iterations = iterations,
+                .remaining = iterations,
+                .cpuClockId = CLOCK_PROCESS_CPUTIME_ID,
+                .threadCount = 1,
+                .eviction = eviction,
+                .library = libraries[library]
+            };
+            scunit_benchmark_callBody(function, context, benchmark);
+            error = checkAttempt(context, benchmark, isStopped);
+            if ((error != SCUNIT_ERROR_NONE) || *isStopped) {
+                return error;
+            }
+            pairTimes[library] = ((double) benchmark->wallTime) / iterations
+                / NANOSECONDS_PER_SECOND;
+        }
+        if (pair < 0) {
+            continue;
+        }
+        times[0] += pairTimes[0];
+        times[1] += pairTimes[1];
+        differences[pair] = pairTimes[1] - pairTimes[0];
+        meanDifference += differences[pair];
+    }
+    meanDifference /= AB_PAIRS;
+    double variance = 0.0;
+    for (int64_t pair = 0; pair < AB_PAIRS; pair++) {
+        double deviation = differences[pair] - meanDifference;
+        variance += deviation * deviation;
+    }
+    variance /= AB_PAIRS - 1;
+    double firstTime = times[0] / AB_PAIRS;
+    double margin = findStudentQuantile(AB_PAIRS - 1) * sqrt(variance / AB_PAIRS);
+    *comparison = (Comparison) {
+        .size = size,
+        .iterations = iterations,
+        .firstTime = firstTime,
+        .secondTime = times[1] / AB_PAIRS,
+        .difference = (firstTime > 0.0) ? meanDifference / firstTime : 0.0,
+        .margin = (firstTime > 0.0) ? margin / firstTime : 0.0
+    };
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Appends the comparison of two libraries to a given `SCUnitContext`.
+ *
+ * @note The second library is reported as faster or slower only if the confidence interval of the
+ * difference excludes zero.
+ *
+ * @param[in, out] context     `SCUnitContext` to append the comparison to.
+ * @param[in]      comparisons Comparisons of the libraries.
+ * @param[in]      count       Number of comparisons.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendComparisons(
+    SCUnitContext* context,
+    const Comparison* comparisons,
+    int64_t count
+) {
+    const char* names[2];
+    for (int64_t i = 0; i < 2; i++) {
+        const char* path = scunit_getBenchmarkLibrary(i);
+        const char* separator = strrchr(path, '/');
+        names[i] = (separator != nullptr) ? separator + 1 : path;
+    }
+    SCUnitError error = scunit_context_appendMessage(
+        context,
+        "\n  A/B: %s (A) vs. %s (B), %" PRId64 " interleaved pairs of samples.\n\n"
+        "  %14s  %14s  %14s  %10s  %21s\n",
+        names[0],
+        names[1],
+        AB_PAIRS,
+        "Size",
+        "A",
+        "B",
+        "B vs. A",
+        "95 % confidence"
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    for (int64_t i = 0; i < count; i++) {
+        const Comparison* comparison = &comparisons[i];
+        SCUnitMeasurement firstTime = scunit_timer_toMeasurement(comparison->firstTime);
+        SCUnitMeasurement secondTime = scunit_timer_toMeasurement(comparison->secondTime);
+        double lowerBound = comparison->difference - comparison->margin;
+        double upperBound = comparison->difference + comparison->margin;
+        error = scunit_context_appendMessage(
+            context,
+            "  %14" PRId64 "  %10.3F %-3s  %10.3F %-3s  %+8.2F %%  %+8.2F %% .. %+6.2F %%  %s\n",
+            comparison->size,
+            firstTime.time,
+            firstTime.timeUnitString,
+            secondTime.time,
+            secondTime.timeUnitString,
+            comparison->difference * 100.0,
+            lowerBound * 100.0,
+            upperBound * 100.0,
+            (upperBound < 0.0) ? "faster" : (lowerBound > 0.0) ? "slower" : "no change"
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    return scunit_context_appendMessage(context, "\n");
+}
+
+/**
+ * @brief Compares the two libraries set by calling `scunit_setBenchmarkLibraries()` by executing
+ * the body of a benchmark with each of them and reports the comparison to a given `SCUnitContext`.
+ *
+ * @note Both libraries are loaded for the duration of the benchmark only. If loading either of them
+ * fails, the benchmark fails.
+ *
+ * @param[in, out] context  `SCUnitContext` of the benchmark.
+ * @param[in]      options  Options of the benchmark.
+ * @param[in]      function Body of the benchmark.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the benchmark failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError compareLibraries(
+    SCUnitContext* context,
+    const SCUnitBenchmarkOptions* options,
+    SCUnitBenchmarkFunction function
+) {
+    void* libraries[2] = { };
+    Eviction eviction = { .buffer = nullptr };
+    int64_t count = countSizes(options);
+    Comparison* comparisons = SCUNIT_MALLOC(count * sizeof(Comparison));
+    SCUnitRandom* random = scunit_random_new();
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    if ((comparisons == nullptr) || (random == nullptr)) {
+        error = SCUNIT_ERROR_OUT_OF_MEMORY;
+        goto finished;
+    }
+    for (int64_t i = 0; i < 2; i++) {
+        const char* path = scunit_getBenchmarkLibrary(i);
+        libraries[i] = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+        if (libraries[i] == nullptr) {
+            error = scunit_context_appendMessage(
+                context,
+                "\n  Loading the library '%s' failed: %s.\n\n",
+                path,
+                dlerror()
+            );
+            if (error == SCUNIT_ERROR_NONE) {
+                error = scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+            }
+            goto finished;
+        }
+    }
+    bool isEvicting = options->cacheState != SCUNIT_CACHE_STATE_WARM;
+    if (isEvicting) {
+        error = prepareEviction(options->cacheState, &eviction);
+        if (error != SCUNIT_ERROR_NONE) {
+            goto finished;
+        }
+    }
+    SCUnitBenchmark benchmark;
+    int64_t size = options->firstSize;
+    for (int64_t i = 0; i < count; i++) {
+        bool isStopped = false;
+        error = compareSize(
+            context,
+            &benchmark,
+            function,
+            isEvicting ? &eviction : nullptr,
+            libraries,
+            random,
+            size,
+            &comparisons[i],
+            &isStopped
+        );
+        if ((error != SCUNIT_ERROR_NONE) || isStopped) {
+            goto finished;
+        }
+        size = nextSize(size, options);
+    }
+    error = appendComparisons(context, comparisons, count);
+finished:
+    for (int64_t i = 0; i < 2; i++) {
+        if (libraries[i] != nullptr) {
+            dlclose(libraries[i]);
+        }
+    }
+    SCUNIT_FREE(eviction.buffer);
+    scunit_random_free(random);
+    SCUNIT_FREE(comparisons);
+    return error;
+}
+
+SCUnitError scunit_benchmark_execute(
+    SCUnitContext* context,
+    const char* name,
+    const SCUnitBenchmarkOptions* options,
+    SCUnitBenchmarkFunction function
+) {
+    if ((options->firstSize < 0) || (options->lastSize < options->firstSize)
+            || ((options->lastSize > options->firstSize)
+                && ((options->firstSize < 1) || (options->multiplier < 2)))
+            || (options->isComplexityChecked
+                && ((options->expectedComplexity < SCUNIT_COMPLEXITY_CONSTANT)
+                    || (options->expectedComplexity > SCUNIT_COMPLEXITY_QUADRATIC)))
+            || (options->firstThreads < 0) || (options->lastThreads < options->firstThreads)
+            || ((options->lastThreads > 0)
+                && ((options->firstThreads < 1) || (options->lastSize != options->firstSize)))
+            || !((options->maxSerialFraction >= 0.0) && (options->maxSerialFraction <= 1.0))
+            || !(options->targetRate >= 0.0)
+            || ((options->targetRate > 0.0)
+                && ((options->lastThreads > 0) || (options->lastSize != options->firstSize)))
+            || (options->cacheState < SCUNIT_CACHE_STATE_WARM)
+            || (options->cacheState > SCUNIT_CACHE_STATE_COLD_TLB)
+            || ((options->cacheState != SCUNIT_CACHE_STATE_WARM)
+                && ((options->lastThreads > 0) || (options->targetRate > 0.0)))) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    pthread_once(&calibration, calibrate);
+    if (scunit_getBenchmarkLibrary(0) != nullptr) {
+        if ((options->targetRate > 0.0) || (options->lastThreads > 0)) {
+            SCUnitError error = scunit_context_appendMessage(
+                context,
+                "\n  A/B comparisons are not supported on multiple threads or at a target rate.\n\n"
+            );
+            return (error != SCUNIT_ERROR_NONE)
+                ? error
+                : scunit_context_setResult(context, SCUNIT_RESULT_SKIP);
+        }
+        return compareLibraries(context, options, function);
+    }
+    if (options->targetRate > 0.0) {
+        return measureLatency(context, name, options, function);
+    }
+    if (options->lastThreads > 0) {
+        return executeOnThreads(context, name, options, function);
+    }
+    int64_t count = countSizes(options);
+    Sample* samples = SCUNIT_MALLOC(count * sizeof(Sample));
+    if (samples == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    SCUnitBenchmark benchmark;
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    Eviction eviction = { .buffer = nullptr };
+    bool isEvicting = options->cacheState != SCUNIT_CACHE_STATE_WARM;
+    if (isEvicting) {
+        error = prepareEviction(options->cacheState, &eviction);
+        if (error != SCUNIT_ERROR_NONE) {
+            goto finished;
+        }
+    }
+    int64_t size = options->firstSize;
+    for (int64_t i = 0; i < count; i++) {
+        bool isStopped = false;
+        error = measureSize(
+            context,
+            &benchmark,
+            function,
+            nullptr,
+            isEvicting ? &eviction : nullptr,
+            nullptr,
+            size,
+            &samples[i],
+            &isStopped
+        );
+        if ((error != SCUNIT_ERROR_NONE) || isStopped) {
+            goto finished;
+        }
+        size = nextSize(size, options);
+    }
+    error = appendResults(context, options, samples, count);
+    if ((error == SCUNIT_ERROR_NONE) && isEvicting) {
+        SCUnitMeasurement overhead = scunit_timer_toMeasurement(
+            ((double) eviction.overhead) / NANOSECONDS_PER_SECOND
+        );
+        error = scunit_context_appendMessage(
+            context,
+            "  Caches: %s, %.1F MiB accessed before every iteration (%.3F %s calibrated out).\n\n",
+            CACHE_STATE_STRINGS[options->cacheState],
+            eviction.size / (1'024.0 * 1'024.0),
+            overhead.time,
+            overhead.timeUnitString
+        );
+    }
+    if ((error == SCUNIT_ERROR_NONE)
+            && (scunit_getBenchmarkFormat() == SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON)) {
+        error = recordSamples(name, options, samples, count, false);
+    }
+finished:
+    SCUNIT_FREE(eviction.buffer);
+    SCUNIT_FREE(samples);
+    return error;
+}
+
+/**
+ * @brief Writes a given string as a JSON string literal (including the quotes) to a given stream.
+ *
+ * @param[in, out] stream Stream to write to.
+ * @param[in]      string A null-terminated string to write.
+ */
+static void writeJsonString(FILE* stream, const char* string) {
+    fputc('"', stream);
+    for (const unsigned char* c = (const unsigned char*) string; *c != '\0'; c++) {
+        if ((*c == '"') || (*c == '\\')) {
+            fprintf(stream, "\\%c", *c);
+        }
+        else if (*c < 0x20) {
+            fprintf(stream, "\\u%04x", *c);
+        }
+        else {
+            fputc(*c, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+/**
+ * @brief Reads the frequency of the first CPU.
+ *
+ * @note The maximum frequency is read from `/sys/devices/system/cpu/cpu0/cpufreq`. If it is not
+ * available (e. g. in a virtual machine), the current frequency is read from `/proc/cpuinfo`
+ * instead.
+ *
+ * @return The frequency (in MHz) or zero if it could not be read.
+ */
+static int64_t readCpuFrequency() {
+    FILE* file = fopen("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq", "r");
+    if (file != nullptr) {
+        int64_t frequency;
+        int count = fscanf(file, "%" SCNd64, &frequency);
+        fclose(file);
+        if (count == 1) {
+            return frequency / 1'000;
+        }
+    }
+    file = fopen("/proc/cpuinfo", "r");
+    if (file == nullptr) {
+        return 0;
+    }
+    char line[256];
+    double frequency = 0.0;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        const char* separator = strchr(line, ':');
+        if ((strncmp(line, "cpu MHz", 7) == 0) && (separator != nullptr)
+                && (sscanf(separator + 1, "%lf", &frequency) == 1)) {
+            break;
+        }
+    }
+    fclose(file);
+    return (int64_t) frequency;
+}
+
+/**
+ * @brief Determines whether the frequency of the first CPU is scaled by a governor other than
+ * `performance`, which makes the results of benchmarks less stable.
+ *
+ * @return `true` if the frequency is scaled, otherwise `false`.
+ */
+static bool isCpuScalingEnabled() {
+    FILE* file = fopen("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor", "r");
+    if (file == nullptr) {
+        return false;
+    }
+    char governor[32];
+    bool isEnabled = (fscanf(file, "%31s", governor) == 1)
+        && (strcmp(governor, "performance") != 0);
+    fclose(file);
+    return isEnabled;
+}
+
+SCUnitError scunit_benchmark_writeReport(FILE* stream) {
+    char date[32] = "";
+    time_t now = time(nullptr);
+    struct tm localNow;
+    if (localtime_r(&now, &localNow) != nullptr) {
+        size_t length = strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", &localNow);
+        // ISO 8601 separates the hours and minutes of the offset by a colon, which `%z` omits.
+        if (length > 2) {
+            memmove(&date[length - 1], &date[length - 2], 3);
+            date[length - 2] = ':';
+        }
+    }
+    char hostName[256] = "";
+    if (gethostname(hostName, sizeof(hostName)) != 0) {
+        hostName[0] = '\0';
+    }
+    hostName[sizeof(hostName) - 1] = '\0';
+    char executable[4'096];
+    ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+    executable[(length > 0) ? length : 0] = '\0';
+    double loads[3] = { };
+    if (getloadavg(loads, 3) < 3) {
+        loads[0] = loads[1] = loads[2] = 0.0;
+    }
+    fprintf(stream, "{\n  \"context\": {\n    \"date\": ");
+    writeJsonString(stream, date);
+    fprintf(stream, ",\n    \"host_name\": ");
+    writeJsonString(stream, hostName);
+    fprintf(stream, ",\n    \"executable\": ");
+    writeJsonString(stream, executable);
+    fprintf(
+        stream,
+        ",\n"
+        "    \"num_cpus\": %ld,\n"
+        "    \"mhz_per_cpu\": %" PRId64 ",\n"
+        "    \"cpu_scaling_enabled\": %s,\n"
+        "    \"caches\": [",
+        sysconf(_SC_NPROCESSORS_ONLN),
+        readCpuFrequency(),
+        isCpuScalingEnabled() ? "true" : "false"
+    );
+    Cache cache;
+    for (int index = 0; (index < MAX_CACHE_INDEX) && readCache(index, &cache); index++) {
+        fprintf(
+            stream,
+            "%s\n"
+            "      {\n"
+            "        \"type\": \"%s\",\n"
+            "        \"level\": %d,\n"
+            "        \"size\": %" PRId64 ",\n"
+            "        \"num_sharing\": %" PRId64 "\n"
+            "      }",
+            (index > 0) ? "," : "",
+            cache.type,
+            cache.level,
+            cache.size,
+            cache.sharingCount
+        );
+    }
+    fprintf(
+        stream,
+        "\n"
+        "    ],\n"
+        "    \"load_avg\": [%.17g, %.17g, %.17g],\n"
+        "    \"library_build_type\": \"%s\"\n"
+        "  },\n"
+        "  \"benchmarks\": [\n"
+        "%s\n"
+        "  ]\n"
+        "}\n",
+        loads[0],
+        loads[1],
+        loads[2],
+// The Makefile does not define `NDEBUG`, so release builds are recognized by being optimized.
+#ifdef __OPTIMIZE__
+        "release",
+#else
+        "debug",
+#endif
+        (report != nullptr) ? report : ""
+    );
+    SCUNIT_FREE(report);
+    report = nullptr;
+    reportSize = 0;
+    recordedBenchmarks = 0;
+    return ((fflush(stream) != 0) || ferror(stream))
+        ? SCUNIT_ERROR_WRITING_STREAM_FAILED
+        : SCUNIT_ERROR_NONE;
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#define _GNU_SOURCE
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <SCUnit/clock.h>
+
+/** @brief Represents the signature of `clock_gettime()`. */
+typedef int (*SCUnitClockGetTime)(clockid_t clockId, struct timespec* timespec);
+
+/** @brief Represents the signature of `nanosleep()`. */
+typedef int (*SCUnitNanosleep)(const struct timespec* duration, struct timespec* remaining);
+
+/** @brief Number of nanoseconds in a single second (10^9 ns = 1 s). */
+static constexpr int64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+/**
+ * @brief Number of seconds between the Unix epoch and the start of the virtual time reported for
+ * `CLOCK_REALTIME` (2000-01-01T00:00:00Z).
+ *
+ * @note Starting at a fixed point in time (instead of the current one) keeps tests that format or
+ * compare calendar dates deterministic.
+ */
+static constexpr int64_t VIRTUAL_EPOCH_SECONDS = 946'684'800;
+
+/** @brief Whether the virtual clock is currently enabled. */
+static atomic_bool isVirtualEnabled;
+
+/** @brief Current virtual time in nanoseconds. */
+static _Atomic int64_t virtualTime;
+
+/** @brief Real `clock_gettime()` of the C library or a `nullptr` if it was not resolved yet. */
+static SCUnitClockGetTime realClockGetTime;
+
+/** @brief Real `nanosleep()` of the C library or a `nullptr` if it was not resolved yet. */
+static SCUnitNanosleep realNanosleep;
+
+/**
+ * @brief Resolves the real functions of the C library behind a potential interposer.
+ *
+ * @note The functions are resolved as early as possible, so that they are never written
+ * concurrently once tests (and potentially their threads) are running. They are nevertheless
+ * resolved lazily as well, in case some other constructor reads the time before this one ran.
+ */
+[[gnu::constructor(101)]]
+static void resolveRealFunctions() {
+    // ISO C forbids converting an object pointer to a function pointer, so the results of
+    // `dlsym()` are copied instead, which POSIX guarantees to yield the functions.
+    if (realClockGetTime == nullptr) {
+        void* symbol = dlsym(RTLD_NEXT, "clock_gettime");
+        memcpy(&realClockGetTime, &symbol, sizeof(symbol));
+    }
+    if (realNanosleep == nullptr) {
+        void* symbol = dlsym(RTLD_NEXT, "nanosleep");
+        memcpy(&realNanosleep, &symbol, sizeof(symbol));
+    }
+}
+
+/**
+ * @brief Determines whether a given clock is a wall clock that is virtualized.
+ *
+ * @param[in] clockId Identifier of the clock to check.
+ * @return `true` if the given clock is virtualized, otherwise `false`.
+ */
+static bool isVirtualClock(clockid_t clockId) {
+    switch (clockId) {
+        case CLOCK_REALTIME:
+        case CLOCK_MONOTONIC:
+#ifdef CLOCK_MONOTONIC_RAW
+        case CLOCK_MONOTONIC_RAW:
+#endif
+#ifdef CLOCK_REALTIME_COARSE
+        case CLOCK_REALTIME_COARSE:
+#endif
+#ifdef CLOCK_MONOTONIC_COARSE
+        case CLOCK_MONOTONIC_COARSE:
+#endif
+#ifdef CLOCK_BOOTTIME
+        case CLOCK_BOOTTIME:
+#endif
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool scunit_clock_isVirtual() {
+    return atomic_load(&isVirtualEnabled);
+}
+
+void scunit_clock_setVirtual(bool isVirtual) {
+    atomic_store(&isVirtualEnabled, isVirtual);
+}
+
+int64_t scunit_clock_now() {
+    return atomic_load(&virtualTime);
+}
+
+void scunit_clock_advance(int64_t nanoseconds) {
+    if (nanoseconds <= 0) {
+        return;
+    }
+    int64_t current = atomic_load(&virtualTime);
+    int64_t next;
+    do {
+        // Saturate instead of overflowing, e. g. if the code under test sleeps "forever".
+        next = (nanoseconds > (INT64_MAX - current)) ? INT64_MAX : current + nanoseconds;
+    } while (!atomic_compare_exchange_weak(&virtualTime, &current, next));
+}
+
+void scunit_clock_reset() {
+    atomic_store(&isVirtualEnabled, false);
+    atomic_store(&virtualTime, 0);
+}
+
+int scunit_clock_getTime(clockid_t clockId, struct timespec* timespec) {
+    if (!atomic_load(&isVirtualEnabled) || !isVirtualClock(clockId)) {
+        return scunit_clock_getRealTime(clockId, timespec);
+    }
+    if (timespec == nullptr) {
+        errno = EFAULT;
+        return -1;
+    }
+    int64_t now = atomic_load(&virtualTime);
+    int64_t seconds = now / NANOSECONDS_PER_SECOND;
+    bool isRealtime = (clockId == CLOCK_REALTIME);
+#ifdef CLOCK_REALTIME_COARSE
+    isRealtime = isRealtime || (clockId == CLOCK_REALTIME_COARSE);
+#endif
+    if (isRealtime) {
+        seconds += VIRTUAL_EPOCH_SECONDS;
+    }
+    timespec->tv_sec = (time_t) seconds;
+    timespec->tv_nsec = (long) (now % NANOSECONDS_PER_SECOND);
+    return 0;
+}
+
+int scunit_clock_getRealTime(clockid_t clockId, struct timespec* timespec) {
+    if (realClockGetTime == nullptr) {
+        resolveRealFunctions();
+        if (realClockGetTime == nullptr) {
+            errno = ENOSYS;
+            return -1;
+        }
+    }
+    return realClockGetTime(clockId, timespec);
+}
+
+int scunit_clock_sleep(const struct timespec* duration, struct timespec* remaining) {
+    if (!atomic_load(&isVirtualEnabled)) {
+        if (realNanosleep == nullptr) {
+            resolveRealFunctions();
+            if (realNanosleep == nullptr) {
+                errno = ENOSYS;
+                return -1;
+            }
+        }
+        return realNanosleep(duration, remaining);
+    }
+    if ((duration == nullptr) || (duration->tv_sec < 0) || (duration->tv_nsec < 0)
+            || (duration->tv_nsec >= NANOSECONDS_PER_SECOND)) {
+        errno = (duration == nullptr) ? EFAULT : EINVAL;
+        return -1;
+    }
+    int64_t nanoseconds = (duration->tv_sec >= (INT64_MAX / NANOSECONDS_PER_SECOND))
+        ? INT64_MAX
+        : (((int64_t) duration->tv_sec) * NANOSECONDS_PER_SECOND) + duration->tv_nsec;
+    scunit_clock_advance(nanoseconds);
+    if (remaining != nullptr) {
+        *remaining = (struct timespec) { };
+    }
+    return 0;
+}
\ No newline at end of file
@@ -1,8 +1,17 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <fcntl.h>
 #include <math.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include <SCUnit/context.h>
 #include <SCUnit/memory.h>
+#include <SCUnit/scunit.h>
+#include <SCUnit/timer.h>
 
 struct SCUnitContext {
 
@@ -22,6 +31,39 @@ struct SCUnitContext {
      */
     char* message;
 
+    /**
+     * @brief Path of the temporary directory of this `SCUnitContext`.
+     *
+     * @note This is a dynamically allocated string or a `nullptr` if the temporary directory was
+     * not created yet.
+     */
+    char* temporaryDirectory;
+
+    /** @brief Timer measuring the section currently executed. */
+    SCUnitTimer* sectionTimer;
+
+    /**
+     * @brief Name of the section currently executed or `nullptr` if no section is executed.
+     *
+     * @note This is a direct reference to the name passed to `scunit_context_beginSection()`.
+     */
+    const char* sectionName;
+
+    /** @brief Index of the next section encountered during the current pass through the test. */
+    int64_t sectionIndex;
+
+    /** @brief Number of sections (in the order they are encountered) that were already executed. */
+    int64_t completedSections;
+
+    /** @brief Number of sections nested inside the section currently executed. */
+    int64_t nestedSections;
+
+    /** @brief Result of the test before the section currently executed began. */
+    SCUnitResult outerResult;
+
+    /** @brief First error that occurred while ending a section, reported after the pass. */
+    SCUnitError sectionError;
+
 };
 
 /** @brief Size used for initially allocating a buffer. */
@@ -33,24 +75,40 @@ static constexpr int64_t GROWTH_FACTOR = 2;
 /** @brief Number of context lines to be read and included around a line of a failed assertion. */
 static constexpr int64_t CONTEXT_LINES = 2;
 
+/** @brief Template for the name of the temporary directory of a test. */
+static constexpr char TEMPORARY_DIRECTORY_TEMPLATE[] = "scunit-XXXXXX";
+
 SCUnitContext* scunit_context_new() {
     SCUnitContext* context = SCUNIT_MALLOC(sizeof(SCUnitContext));
     if (context == nullptr) {
         return nullptr;
     }
     context->result = SCUNIT_RESULT_PASS;
+    context->temporaryDirectory = nullptr;
     context->size = INITIAL_BUFFER_SIZE;
     context->message = SCUNIT_CALLOC(INITIAL_BUFFER_SIZE, sizeof(char));
     if (context->message == nullptr) {
         SCUNIT_FREE(context);
         return nullptr;
     }
+    context->sectionTimer = scunit_timer_new();
+    if (context->sectionTimer == nullptr) {
+        SCUNIT_FREE(context->message);
+        SCUNIT_FREE(context);
+        return nullptr;
+    }
+    scunit_context_reset(context);
     return context;
 }
 
 void scunit_context_reset(SCUnitContext* context) {
     context->result = SCUNIT_RESULT_PASS;
     context->message[0] = '\0';
+    context->sectionName = nullptr;
+    context->sectionIndex = 0;
+    context->completedSections = 0;
+    context->nestedSections = 0;
+    context->sectionError = SCUNIT_ERROR_NONE;
 }
 
 SCUnitResult scunit_context_getResult(const SCUnitContext* context) {
@@ -271,8 +329,220 @@ failed:
     return error;
 }
 
+const char* scunit_context_getTemporaryDirectory(SCUnitContext* context) {
+    if (context->temporaryDirectory != nullptr) {
+        return context->temporaryDirectory;
+    }
+    const char* root = scunit_getTemporaryDirectoryRoot();
+    size_t rootLength = strlen(root);
+    char* path = SCUNIT_MALLOC(rootLength + sizeof(TEMPORARY_DIRECTORY_TEMPLATE) + 1);
+    if (path == nullptr) {
+        return nullptr;
+    }
+    memcpy(path, root, rootLength);
+    path[rootLength] = '/';
+    memcpy(
+        path + rootLength + 1,
+        TEMPORARY_DIRECTORY_TEMPLATE,
+        sizeof(TEMPORARY_DIRECTORY_TEMPLATE)
+    );
+    if (mkdtemp(path) == nullptr) {
+        SCUNIT_FREE(path);
+        return nullptr;
+    }
+    context->temporaryDirectory = path;
+    return path;
+}
+
+/**
+ * @brief Removes all entries of a given directory recursively.
+ *
+ * @note Symbolic links are removed themselves and never followed.
+ *
+ * @param[in] directoryFd File descriptor of the directory to empty, which is closed by this
+ *                        function.
+ * @return `true` if all entries were removed, otherwise `false`.
+ */
+static bool removeEntries(int directoryFd) {
+    DIR* directory = fdopendir(directoryFd);
+    if (directory == nullptr) {
+        close(directoryFd);
+        return false;
+    }
+    bool isRemoved = true;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != nullptr) {
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)) {
+            continue;
+        }
+        if (unlinkat(directoryFd, entry->d_name, 0) == 0) {
+            continue;
+        }
+        // Unlinking fails for directories, which have to be emptied first.
+        int childFd = openat(
+            directoryFd,
+            entry->d_name,
+            O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC
+        );
+        if ((childFd < 0) || !removeEntries(childFd)
+                || (unlinkat(directoryFd, entry->d_name, AT_REMOVEDIR) < 0)) {
+            isRemoved = false;
+        }
+    }
+    closedir(directory);
+    return isRemoved;
+}
+
+SCUnitError scunit_context_removeTemporaryDirectory(SCUnitContext* context) {
+    if (context->temporaryDirectory == nullptr) {
+        return SCUNIT_ERROR_NONE;
+    }
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    if ((context->result == SCUNIT_RESULT_FAIL) && scunit_getKeepTemporaryOnFailure()) {
+        error = scunit_context_appendMessage(
+            context,
+            "\n  Kept temporary directory %s.\n\n",
+            context->temporaryDirectory
+        );
+        goto finished;
+    }
+    int directoryFd = open(context->temporaryDirectory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if ((directoryFd < 0) || !removeEntries(directoryFd)
+            || (rmdir(context->temporaryDirectory) < 0)) {
+        error = SCUNIT_ERROR_REMOVING_DIRECTORY_FAILED;
+    }
+finished:
+    SCUNIT_FREE(context->temporaryDirectory);
+    context->temporaryDirectory = nullptr;
+    return error;
+}
+
+bool scunit_context_beginSection(SCUnitContext* context, const char* name) {
+    if (context->sectionName != nullptr) {
+        context->nestedSections++;
+        return true;
+    }
+    if (context->sectionIndex++ < context->completedSections) {
+        return false;
+    }
+    SCUnitError error = scunit_timer_start(context->sectionTimer);
+    if ((error != SCUNIT_ERROR_NONE) && (context->sectionError == SCUNIT_ERROR_NONE)) {
+        context->sectionError = error;
+    }
+    context->sectionName = name;
+    context->outerResult = context->result;
+    context->result = SCUNIT_RESULT_PASS;
+    return true;
+}
+
+/**
+ * @brief Appends the report of the section currently executed to a given `SCUnitContext`.
+ *
+ * @param[in, out] context `SCUnitContext` to append the report to.
+ * @param[in]      result  Result of the section.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring the section failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError appendSectionReport(SCUnitContext* context, SCUnitResult result) {
+    SCUnitError error = scunit_timer_stop(context->sectionTimer);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    SCUnitMeasurement wallTimeMeasurement = scunit_timer_getWallTime(context->sectionTimer, &error);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    SCUnitMeasurement cpuTimeMeasurement = scunit_timer_getCPUTime(context->sectionTimer, &error);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    error = scunit_context_appendMessage(
+        context,
+        "%s  Section %s:",
+        (context->message[0] == '\0') ? "\n" : "",
+        context->sectionName
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    switch (result) {
+        case SCUNIT_RESULT_PASS:
+            error = scunit_context_appendColoredMessage(
+                context,
+                SCUNIT_COLOR_DARK_BLACK,
+                SCUNIT_COLOR_DARK_GREEN,
+                " PASS "
+            );
+            break;
+        case SCUNIT_RESULT_SKIP:
+            error = scunit_context_appendColoredMessage(
+                context,
+                SCUNIT_COLOR_DARK_BLACK,
+                SCUNIT_COLOR_DARK_YELLOW,
+                " SKIP "
+            );
+            break;
+        default:
+            error = scunit_context_appendColoredMessage(
+                context,
+                SCUNIT_COLOR_DARK_BLACK,
+                SCUNIT_COLOR_DARK_RED,
+                " FAIL "
+            );
+            break;
+    }
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_context_appendMessage(
+        context,
+        " [Wall: %.3F %s, CPU: %.3F %s]\n\n",
+        wallTimeMeasurement.time,
+        wallTimeMeasurement.timeUnitString,
+        cpuTimeMeasurement.time,
+        cpuTimeMeasurement.timeUnitString
+    );
+}
+
+void scunit_context_endSection(SCUnitContext* context) {
+    if (context->nestedSections > 0) {
+        context->nestedSections--;
+        return;
+    }
+    if (context->sectionName == nullptr) {
+        return;
+    }
+    SCUnitResult result = context->result;
+    SCUnitError error = appendSectionReport(context, result);
+    if ((error != SCUNIT_ERROR_NONE) && (context->sectionError == SCUNIT_ERROR_NONE)) {
+        context->sectionError = error;
+    }
+    // A skipped or passed section leaves the result of the test as it was before the section.
+    context->result = (result == SCUNIT_RESULT_FAIL) ? SCUNIT_RESULT_FAIL : context->outerResult;
+    context->completedSections = context->sectionIndex;
+    context->sectionName = nullptr;
+}
+
+void scunit_context_rewindSections(SCUnitContext* context) {
+    context->sectionIndex = 0;
+}
+
+SCUnitError scunit_context_closeSections(SCUnitContext* context, bool* hasPendingSections) {
+    // A section still being executed was left by returning from the test early (e. g. due to a
+    // failed assertion), so any sections after it have not been executed yet.
+    *hasPendingSections = (context->sectionName != nullptr);
+    context->nestedSections = 0;
+    scunit_context_endSection(context);
+    SCUnitError error = context->sectionError;
+    context->sectionError = SCUNIT_ERROR_NONE;
+    return error;
+}
+
 void scunit_context_free(SCUnitContext* context) {
     if (context != nullptr) {
+        scunit_timer_free(context->sectionTimer);
+        SCUNIT_FREE(context->temporaryDirectory);
         SCUNIT_FREE(context->message);
         SCUNIT_FREE(context);
     }
@@ -0,0 +1,203 @@
+#define _GNU_SOURCE
+
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <SCUnit/backtrace.h>
+#include <SCUnit/crash.h>
+#include <SCUnit/memory.h>
+
+/** @brief Maximum number of frames recorded in the backtrace of a crash. */
+static constexpr int32_t MAX_FRAMES = 64;
+
+/**
+ * @brief Number of innermost frames left out of the backtrace of a crash.
+ *
+ * @note These are the frames of the signal handler itself and the signal trampoline of the C
+ * library, which are of no interest to anyone debugging the test.
+ */
+static constexpr int32_t SKIPPED_FRAMES = 2;
+
+/** @brief Size of the alternate signal stack (in bytes). */
+static constexpr int64_t ALTERNATE_STACK_SIZE = 64 * 1024;
+
+/** @brief Signals caught by the signal handlers. */
+static const int CAUGHT_SIGNALS[] = { SIGSEGV, SIGBUS, SIGFPE, SIGABRT, SIGXCPU };
+
+/** @brief Whether the signal handlers are installed. */
+static bool isInstalled;
+
+/** @brief Recovery point a crashing test jumps back to or a `nullptr` if there is none. */
+static sigjmp_buf* volatile currentRecoveryPoint;
+
+/**
+ * @brief Thread that set the current recovery point.
+ *
+ * @note Jumping to a recovery point is only valid on the thread whose stack it refers to, so a
+ * crash on any other thread (e. g. one started by a schedule or a threaded benchmark) is not
+ * recovered from.
+ */
+static pthread_t recoveryThread;
+
+/** @brief Signal caught last. */
+static volatile sig_atomic_t caughtSignal;
+
+/**
+ * @brief Frames of the backtrace of the crash caught last.
+ *
+ * @note This is a dynamically allocated array with storage for `MAX_FRAMES` elements, which is
+ * allocated along with the alternate signal stack. The frames are only symbolized after jumping
+ * back to the recovery point (see `<SCUnit/backtrace.h>`), since symbolizing them requires
+ * functions that are not async-signal-safe.
+ */
+static void** frames;
+
+/** @brief Number of frames of the backtrace of the crash caught last. */
+static volatile sig_atomic_t frameCount;
+
+/**
+ * @brief Handles a signal raised by a crashing test.
+ *
+ * @param[in] signal Signal that was raised.
+ */
+static void handleSignal(int signal) {
+    sigjmp_buf* recoveryPoint = currentRecoveryPoint;
+    if ((recoveryPoint == nullptr) || !pthread_equal(pthread_self(), recoveryThread)) {
+        // The crash did not happen in a test (or on another thread than the one executing it), so
+        // there is nothing to recover. Raising the signal again with its default action
+        // terminates the process as if no handler was installed.
+        struct sigaction action = { .sa_handler = SIG_DFL };
+        sigemptyset(&action.sa_mask);
+        sigaction(signal, &action, nullptr);
+        raise(signal);
+        return;
+    }
+    currentRecoveryPoint = nullptr;
+    caughtSignal = signal;
+    frameCount = backtrace(frames, MAX_FRAMES);
+    siglongjmp(*recoveryPoint, 1);
+}
+
+SCUnitError scunit_crash_install() {
+    if (isInstalled) {
+        return SCUNIT_ERROR_NONE;
+    }
+    // The alternate stack and the frames are never freed once installed, since the handlers stay
+    // installed until the process exits. The alternate stack only applies to the installing
+    // thread, which is the one executing the tests.
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    frames = SCUNIT_MALLOC(MAX_FRAMES * sizeof(void*));
+    if (frames == nullptr) {
+        error = SCUNIT_ERROR_OUT_OF_MEMORY;
+        goto framesAllocationFailed;
+    }
+    stack_t stack = { .ss_size = ALTERNATE_STACK_SIZE };
+    stack.ss_sp = SCUNIT_MALLOC(ALTERNATE_STACK_SIZE);
+    if (stack.ss_sp == nullptr) {
+        error = SCUNIT_ERROR_OUT_OF_MEMORY;
+        goto stackAllocationFailed;
+    }
+    stack_t previousStack;
+    if (sigaltstack(&stack, &previousStack) < 0) {
+        error = SCUNIT_ERROR_INSTALLING_SIGNAL_HANDLERS_FAILED;
+        goto installingStackFailed;
+    }
+    // `backtrace()` loads the unwinder lazily on its first call, which must not happen within the
+    // signal handler.
+    void* frame;
+    backtrace(&frame, 1);
+    struct sigaction action = { .sa_handler = handleSignal, .sa_flags = SA_ONSTACK };
+    sigemptyset(&action.sa_mask);
+    struct sigaction previousActions[sizeof(CAUGHT_SIGNALS) / sizeof(CAUGHT_SIGNALS[0])];
+    size_t installedSignals = 0;
+    while (installedSignals < (sizeof(CAUGHT_SIGNALS) / sizeof(CAUGHT_SIGNALS[0]))) {
+        if (sigaction(
+                CAUGHT_SIGNALS[installedSignals],
+                &action,
+                &previousActions[installedSignals]
+            ) < 0) {
+            error = SCUNIT_ERROR_INSTALLING_SIGNAL_HANDLERS_FAILED;
+            goto installingHandlersFailed;
+        }
+        installedSignals++;
+    }
+    isInstalled = true;
+    return SCUNIT_ERROR_NONE;
+installingHandlersFailed:
+    // Restore the handlers installed so far, so that the process is left as it was before.
+    while (installedSignals > 0) {
+        installedSignals--;
+        sigaction(CAUGHT_SIGNALS[installedSignals], &previousActions[installedSignals], nullptr);
+    }
+    sigaltstack(&previousStack, nullptr);
+installingStackFailed:
+    SCUNIT_FREE(stack.ss_sp);
+stackAllocationFailed:
+    SCUNIT_FREE(frames);
+    frames = nullptr;
+framesAllocationFailed:
+    return error;
+}
+
+void scunit_crash_setRecoveryPoint(sigjmp_buf* recoveryPoint) {
+    // The thread is recorded first, so that the handler never sees a recovery point together with
+    // the thread of a previous one.
+    if (recoveryPoint != nullptr) {
+        recoveryThread = pthread_self();
+    }
+    currentRecoveryPoint = recoveryPoint;
+}
+
+/**
+ * @brief Returns the name of a given signal caught by the signal handlers.
+ *
+ * @param[in] signal Signal to get the name of.
+ * @return A null-terminated string for the name of the given signal.
+ */
+static const char* getSignalName(int signal) {
+    switch (signal) {
+        case SIGSEGV:
+            return "SIGSEGV (segmentation fault)";
+        case SIGBUS:
+            return "SIGBUS (bus error)";
+        case SIGFPE:
+            return "SIGFPE (arithmetic exception)";
+        case SIGABRT:
+            return "SIGABRT (aborted)";
+        case SIGXCPU:
+            return "SIGXCPU (CPU time limit exceeded)";
+        default:
+            return "unknown signal";
+    }
+}
+
+SCUnitError scunit_crash_appendReport(SCUnitContext* context) {
+    SCUnitError error = scunit_context_appendMessage(
+        context,
+        "\n  Caught signal %s, backtrace:\n\n",
+        getSignalName(caughtSignal)
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    if (frameCount > SKIPPED_FRAMES) {
+        // Unlike the other frames, the innermost one is not a return address but the address of
+        // the faulting instruction itself. Symbolizing assumes return addresses and looks up the
+        // preceding byte, so it is adjusted accordingly.
+        frames[SKIPPED_FRAMES] = (char*) frames[SKIPPED_FRAMES] + 1;
+        error = scunit_backtrace_appendFrames(
+            context,
+            frames + SKIPPED_FRAMES,
+            frameCount - SKIPPED_FRAMES
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    error = scunit_context_appendMessage(context, "\n");
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#define _GNU_SOURCE
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <SCUnit/data.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/scunit.h>
+
+/** @brief Size used for initially allocating the array of mapped files. */
+static constexpr int64_t INITIAL_CAPACITY = 8;
+
+/** @brief Growth factor used for resizing the array of mapped files. */
+static constexpr int64_t GROWTH_FACTOR = 2;
+
+/** @brief Represents a file mapped into memory. */
+typedef struct MappedFile {
+
+    /** @brief A dynamically allocated string for the resolved path of the file. */
+    char* path;
+
+    /** @brief View of the contents of the file. */
+    SCUnitData data;
+
+} MappedFile;
+
+/**
+ * @brief Files mapped into memory so far.
+ *
+ * @note This is a dynamically resized array with storage for `capacity` elements and `count`
+ * mapped files, except if `capacity` is zero, in which case it is initially a `nullptr`.
+ */
+static MappedFile* mappedFiles;
+
+/** @brief Number of files mapped into memory so far. */
+static int64_t count;
+
+/** @brief Capacity of the array of mapped files. */
+static int64_t capacity;
+
+/** @brief Mutex guarding the mapped files, since tests may request them from several threads. */
+static pthread_mutex_t mappedFilesMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Resolves a given path against the data directory.
+ *
+ * @param[in] path A null-terminated string for the path to resolve.
+ * @return A dynamically allocated string for the resolved path on success, otherwise a `nullptr`.
+ */
+static char* resolvePath(const char* path) {
+    const char* directory = (path[0] != '/') ? scunit_getDataDirectory() : "";
+    size_t directoryLength = strlen(directory);
+    size_t pathLength = strlen(path);
+    char* resolvedPath = SCUNIT_MALLOC(directoryLength + pathLength + 2);
+    if (resolvedPath == nullptr) {
+        return nullptr;
+    }
+    memcpy(resolvedPath, directory, directoryLength);
+    if (directoryLength > 0) {
+        resolvedPath[directoryLength++] = '/';
+    }
+    memcpy(resolvedPath + directoryLength, path, pathLength + 1);
+    return resolvedPath;
+}
+
+/**
+ * @brief Maps a file with a given path into memory.
+ *
+ * @note The pages of the file are populated up front using `MAP_POPULATE`, so that tests do not
+ * pay for page faults while reading it.
+ *
+ * @param[in]  path A null-terminated string for the path of the file to map.
+ * @param[out] data View of the contents of the file.
+ * @return `SCUNIT_ERROR_OPENING_STREAM_FAILED` if opening the file failed,
+ *         `SCUNIT_ERROR_MAPPING_FILE_FAILED` if mapping the file failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError mapFile(const char* path, SCUnitData* data) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return SCUNIT_ERROR_OPENING_STREAM_FAILED;
+    }
+    struct stat status;
+    if (fstat(fd, &status) < 0) {
+        close(fd);
+        return SCUNIT_ERROR_MAPPING_FILE_FAILED;
+    }
+    // Mapping an empty file fails, so it gets an empty view that is not a `nullptr` instead.
+    if (status.st_size == 0) {
+        close(fd);
+        *data = (SCUnitData) { .bytes = "", .size = 0 };
+        return SCUNIT_ERROR_NONE;
+    }
+    void* bytes = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (bytes == MAP_FAILED) {
+        return SCUNIT_ERROR_MAPPING_FILE_FAILED;
+    }
+    *data = (SCUnitData) { .bytes = bytes, .size = status.st_size };
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitData scunit_data_map(const char* path, SCUnitError* error) {
+    SCUnitData data = { .bytes = nullptr, .size = 0 };
+    char* resolvedPath = resolvePath(path);
+    if (resolvedPath == nullptr) {
+        *error = SCUNIT_ERROR_OUT_OF_MEMORY;
+        return data;
+    }
+    pthread_mutex_lock(&mappedFilesMutex);
+    for (int64_t i = 0; i < count; i++) {
+        if (strcmp(mappedFiles[i].path, resolvedPath) == 0) {
+            data = mappedFiles[i].data;
+            *error = SCUNIT_ERROR_NONE;
+            goto finished;
+        }
+    }
+    if (count == capacity) {
+        int64_t newCapacity = (capacity > 0) ? capacity * GROWTH_FACTOR : INITIAL_CAPACITY;
+        MappedFile* newMappedFiles = SCUNIT_REALLOC(mappedFiles, newCapacity * sizeof(MappedFile));
+        if (newMappedFiles == nullptr) {
+            *error = SCUNIT_ERROR_OUT_OF_MEMORY;
+            goto finished;
+        }
+        mappedFiles = newMappedFiles;
+        capacity = newCapacity;
+    }
+    *error = mapFile(resolvedPath, &data);
+    if (*error != SCUNIT_ERROR_NONE) {
+        goto finished;
+    }
+    // The array takes ownership of the resolved path.
+    mappedFiles[count++] = (MappedFile) { .path = resolvedPath, .data = data };
+    resolvedPath = nullptr;
+finished:
+    pthread_mutex_unlock(&mappedFilesMutex);
+    SCUNIT_FREE(resolvedPath);
+    return data;
+}
+
+/** @brief Unmaps all mapped files once the process exits. */
+[[gnu::destructor]]
+static void unmapFiles() {
+    for (int64_t i = 0; i < count; i++) {
+        if (mappedFiles[i].data.size > 0) {
+            munmap((void*) mappedFiles[i].data.bytes, mappedFiles[i].data.size);
+        }
+        SCUNIT_FREE(mappedFiles[i].path);
+    }
+    SCUNIT_FREE(mappedFiles);
+}
\ No newline at end of file
@@ -0,0 +1,450 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/file.h>
+#include <unistd.h>
+#include <SCUnit/flaky.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/scunit.h>
+
+/** @brief Represents the recorded history of a single test. */
+typedef struct SCUnitFlakyRecord {
+
+    /** @brief Name of the test in the form `<suite>.<test>` (dynamically allocated). */
+    char* name;
+
+    /** @brief Number of runs read from the history file. */
+    int64_t runs;
+
+    /** @brief Number of runs read from the history file in which the outcome flipped. */
+    int64_t flips;
+
+    /** @brief Whether the test failed in the last run read from the history file. */
+    bool hasFailed;
+
+    /** @brief Number of runs recorded by this process. */
+    int64_t newRuns;
+
+    /** @brief Number of runs recorded by this process in which the outcome flipped. */
+    int64_t newFlips;
+
+    /** @brief Whether the test failed in the last run recorded by this process. */
+    bool newHasFailed;
+
+} SCUnitFlakyRecord;
+
+/** @brief Represents a pattern of the quarantine file, split into a suite and test pattern. */
+typedef struct SCUnitQuarantinePattern {
+
+    /**
+     * @brief Shell wildcard pattern matched against the names of suites.
+     *
+     * @note This is a dynamically allocated string, which `testPattern` points into (unless it
+     * points to a static string).
+     */
+    char* suitePattern;
+
+    /** @brief Shell wildcard pattern matched against the names of tests. */
+    const char* testPattern;
+
+} SCUnitQuarantinePattern;
+
+/** @brief Growth factor used for resizing the arrays of records and patterns. */
+static constexpr int64_t GROWTH_FACTOR = 2;
+
+/** @brief Initial number of buckets of the hash table indexing the records (a power of two). */
+static constexpr int64_t INITIAL_BUCKET_COUNT = 16;
+
+/** @brief Offset basis of the 64-bit FNV-1a hash function. */
+static constexpr uint64_t FNV_OFFSET_BASIS = 14'695'981'039'346'656'037u;
+
+/** @brief Prime of the 64-bit FNV-1a hash function. */
+static constexpr uint64_t FNV_PRIME = 1'099'511'628'211u;
+
+/**
+ * @brief Recorded histories of tests.
+ *
+ * @note This is a dynamically resized array with storage for `recordCapacity` elements and
+ * `recordCount` records.
+ */
+static SCUnitFlakyRecord* records;
+
+/** @brief Capacity for recording the histories of tests. */
+static int64_t recordCapacity;
+
+/** @brief Number of recorded histories of tests. */
+static int64_t recordCount;
+
+/**
+ * @brief Hash table indexing the recorded histories of tests by name.
+ *
+ * @note This is a dynamically allocated array of `bucketCount` buckets (a power of two), each
+ * holding the index of a record plus one or zero if it is empty. Collisions are resolved using
+ * linear probing, and the table is kept at most half full.
+ */
+static int64_t* buckets;
+
+/** @brief Number of buckets of the hash table indexing the recorded histories of tests. */
+static int64_t bucketCount;
+
+/**
+ * @brief Patterns of the quarantine file.
+ *
+ * @note This is a dynamically resized array with storage for `patternCapacity` elements and
+ * `patternCount` patterns.
+ */
+static SCUnitQuarantinePattern* patterns;
+
+/** @brief Capacity for storing patterns of the quarantine file. */
+static int64_t patternCapacity;
+
+/** @brief Number of patterns of the quarantine file. */
+static int64_t patternCount;
+
+/**
+ * @brief Computes the 64-bit FNV-1a hash of a given string.
+ *
+ * @param[in] string A null-terminated string to hash.
+ * @return The hash of the string.
+ */
+static uint64_t hashName(const char* string) {
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (const char* c = string; *c != '\0'; c++) {
+        hash = (hash ^ (unsigned char) *c) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Finds the bucket of the hash table holding the record of a test with a given name or the
+ * empty bucket it would be inserted into.
+ *
+ * @param[in] name A null-terminated string for the name of the test in the form `<suite>.<test>`.
+ * @return The index of the bucket.
+ */
+static int64_t findBucket(const char* name) {
+    int64_t mask = bucketCount - 1;
+    int64_t bucket = (int64_t) (hashName(name) & (uint64_t) mask);
+    while ((buckets[bucket] != 0) && (strcmp(records[buckets[bucket] - 1].name, name) != 0)) {
+        bucket = (bucket + 1) & mask;
+    }
+    return bucket;
+}
+
+/**
+ * @brief Doubles the number of buckets of the hash table (or allocates the initial ones) and
+ * inserts all records again.
+ *
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError growBuckets() {
+    int64_t newBucketCount = (bucketCount == 0)
+        ? INITIAL_BUCKET_COUNT
+        : bucketCount * GROWTH_FACTOR;
+    int64_t* newBuckets = SCUNIT_CALLOC(newBucketCount, sizeof(int64_t));
+    if (newBuckets == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    SCUNIT_FREE(buckets);
+    buckets = newBuckets;
+    bucketCount = newBucketCount;
+    for (int64_t i = 0; i < recordCount; i++) {
+        buckets[findBucket(records[i].name)] = i + 1;
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Finds the record of a test with a given name, adding an empty one if there is none yet.
+ *
+ * @param[in] name A null-terminated string for the name of the test in the form `<suite>.<test>`.
+ * @return The record of the test or a `nullptr` if an out-of-memory condition occurred.
+ */
+static SCUnitFlakyRecord* findRecord(const char* name) {
+    if (((recordCount + 1) * 2 > bucketCount) && (growBuckets() != SCUNIT_ERROR_NONE)) {
+        return nullptr;
+    }
+    int64_t bucket = findBucket(name);
+    if (buckets[bucket] != 0) {
+        return &records[buckets[bucket] - 1];
+    }
+    if (recordCount >= recordCapacity) {
+        int64_t newCapacity = (recordCapacity == 0) ? 1 : recordCapacity * GROWTH_FACTOR;
+        SCUnitFlakyRecord* newRecords = SCUNIT_REALLOC(
+            records,
+            newCapacity * sizeof(SCUnitFlakyRecord)
+        );
+        if (newRecords == nullptr) {
+            return nullptr;
+        }
+        records = newRecords;
+        recordCapacity = newCapacity;
+    }
+    char* nameCopy = strdup(name);
+    if (nameCopy == nullptr) {
+        return nullptr;
+    }
+    records[recordCount] = (SCUnitFlakyRecord) { .name = nameCopy };
+    buckets[bucket] = recordCount + 1;
+    return &records[recordCount++];
+}
+
+/**
+ * @brief Reads the runs of all tests from a given history file, replacing the ones read before.
+ *
+ * @note Malformed lines are skipped, so that a damaged history file never breaks a run.
+ *
+ * @param[in, out] file History file to read from.
+ * @return `SCUNIT_ERROR_READING_STREAM_FAILED` if reading the file failed,
+ *         `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+static SCUnitError readHistory(FILE* file) {
+    for (int64_t i = 0; i < recordCount; i++) {
+        records[i].runs = 0;
+        records[i].flips = 0;
+        records[i].hasFailed = false;
+    }
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    char* line = nullptr;
+    size_t size = 0;
+    while (getline(&line, &size, file) >= 0) {
+        char* name = strtok(line, "\t");
+        char* runs = strtok(nullptr, "\t");
+        char* flips = strtok(nullptr, "\t");
+        char* outcome = strtok(nullptr, "\n");
+        if ((name == nullptr) || (runs == nullptr) || (flips == nullptr) || (outcome == nullptr)) {
+            continue;
+        }
+        SCUnitFlakyRecord* record = findRecord(name);
+        if (record == nullptr) {
+            error = SCUNIT_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        record->runs = strtoll(runs, nullptr, 10);
+        record->flips = strtoll(flips, nullptr, 10);
+        record->hasFailed = (strcmp(outcome, "fail") == 0);
+    }
+    if ((error == SCUNIT_ERROR_NONE) && ferror(file)) {
+        error = SCUNIT_ERROR_READING_STREAM_FAILED;
+    }
+    free(line);
+    return error;
+}
+
+/**
+ * @brief Reads the patterns of a given quarantine file.
+ *
+ * @param[in, out] file Quarantine file to read from.
+ * @return `SCUNIT_ERROR_READING_STREAM_FAILED` if reading the file failed,
+ *         `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+static SCUnitError readQuarantine(FILE* file) {
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    char* line = nullptr;
+    size_t size = 0;
+    while (getline(&line, &size, file) >= 0) {
+        char* pattern = line + strspn(line, " \t");
+        pattern[strcspn(pattern, " \t\r\n")] = '\0';
+        if ((*pattern == '\0') || (*pattern == '#')) {
+            continue;
+        }
+        if (patternCount >= patternCapacity) {
+            int64_t newCapacity = (patternCapacity == 0) ? 1 : patternCapacity * GROWTH_FACTOR;
+            SCUnitQuarantinePattern* newPatterns = SCUNIT_REALLOC(
+                patterns,
+                newCapacity * sizeof(SCUnitQuarantinePattern)
+            );
+            if (newPatterns == nullptr) {
+                error = SCUNIT_ERROR_OUT_OF_MEMORY;
+                break;
+            }
+            patterns = newPatterns;
+            patternCapacity = newCapacity;
+        }
+        char* suitePattern = strdup(pattern);
+        if (suitePattern == nullptr) {
+            error = SCUNIT_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        // Like the filter, the pattern is split at the first '.', since names of suites and tests
+        // are C identifiers and never contain one.
+        char* separator = strchr(suitePattern, '.');
+        if (separator != nullptr) {
+            *separator = '\0';
+        }
+        patterns[patternCount++] = (SCUnitQuarantinePattern) {
+            .suitePattern = suitePattern,
+            .testPattern = (separator != nullptr) ? separator + 1 : "*"
+        };
+    }
+    if ((error == SCUNIT_ERROR_NONE) && ferror(file)) {
+        error = SCUNIT_ERROR_READING_STREAM_FAILED;
+    }
+    free(line);
+    return error;
+}
+
+SCUnitError scunit_flaky_load() {
+    scunit_flaky_unload();
+    const char* quarantinePath = scunit_getQuarantineFile();
+    if (quarantinePath != nullptr) {
+        FILE* file = fopen(quarantinePath, "r");
+        if (file == nullptr) {
+            return SCUNIT_ERROR_OPENING_STREAM_FAILED;
+        }
+        SCUnitError error = readQuarantine(file);
+        fclose(file);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    const char* historyPath = scunit_getFlakyHistoryFile();
+    if (historyPath != nullptr) {
+        FILE* file = fopen(historyPath, "r");
+        if (file != nullptr) {
+            SCUnitError error = readHistory(file);
+            fclose(file);
+            if (error != SCUNIT_ERROR_NONE) {
+                return error;
+            }
+        }
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+bool scunit_flaky_isQuarantined(const char* suiteName, const char* testName) {
+    for (int64_t i = 0; i < patternCount; i++) {
+        if ((fnmatch(patterns[i].suitePattern, suiteName, 0) == 0)
+                && (fnmatch(patterns[i].testPattern, testName, 0) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SCUnitError scunit_flaky_record(
+    const char* suiteName,
+    const char* testName,
+    bool hasFailed,
+    bool isFlaky,
+    int64_t* runs,
+    int64_t* flips
+) {
+    if (scunit_getFlakyHistoryFile() == nullptr) {
+        *runs = 1;
+        *flips = isFlaky ? 1 : 0;
+        return SCUNIT_ERROR_NONE;
+    }
+    int size = snprintf(nullptr, 0, "%s.%s", suiteName, testName) + 1;
+    char* name = SCUNIT_MALLOC(size);
+    if (name == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    snprintf(name, size, "%s.%s", suiteName, testName);
+    SCUnitFlakyRecord* record = findRecord(name);
+    SCUNIT_FREE(name);
+    if (record == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    bool hadFailed = (record->newRuns > 0) ? record->newHasFailed : record->hasFailed;
+    bool hasRun = (record->runs > 0) || (record->newRuns > 0);
+    record->newRuns++;
+    if (isFlaky || (hasRun && (hasFailed != hadFailed))) {
+        record->newFlips++;
+    }
+    record->newHasFailed = hasFailed;
+    *runs = record->runs + record->newRuns;
+    *flips = record->flips + record->newFlips;
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitError scunit_flaky_save() {
+    const char* historyPath = scunit_getFlakyHistoryFile();
+    if (historyPath == nullptr) {
+        return SCUNIT_ERROR_NONE;
+    }
+    int fd = open(historyPath, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return SCUNIT_ERROR_OPENING_STREAM_FAILED;
+    }
+    // The lock is released when the file is closed.
+    if (flock(fd, LOCK_EX) != 0) {
+        close(fd);
+        return SCUNIT_ERROR_OPENING_STREAM_FAILED;
+    }
+    FILE* file = fdopen(fd, "r+");
+    if (file == nullptr) {
+        close(fd);
+        return SCUNIT_ERROR_OPENING_STREAM_FAILED;
+    }
+    SCUnitError error = readHistory(file);
+    if (error != SCUNIT_ERROR_NONE) {
+        goto failed;
+    }
+    rewind(file);
+    if (ftruncate(fd, 0) != 0) {
+        error = SCUNIT_ERROR_WRITING_STREAM_FAILED;
+        goto failed;
+    }
+    for (int64_t i = 0; i < recordCount; i++) {
+        const SCUnitFlakyRecord* record = &records[i];
+        if ((record->runs == 0) && (record->newRuns == 0)) {
+            continue;
+        }
+        bool hasFailed = (record->newRuns > 0) ? record->newHasFailed : record->hasFailed;
+        if (fprintf(
+                file,
+                "%s\t%" PRId64 "\t%" PRId64 "\t%s\n",
+                record->name,
+                record->runs + record->newRuns,
+                record->flips + record->newFlips,
+                hasFailed ? "fail" : "pass"
+            ) < 0) {
+            error = SCUNIT_ERROR_WRITING_STREAM_FAILED;
+            goto failed;
+        }
+    }
+    // Everything is saved now, so the runs are only counted once if this function is called again.
+    for (int64_t i = 0; i < recordCount; i++) {
+        records[i].runs += records[i].newRuns;
+        records[i].flips += records[i].newFlips;
+        records[i].hasFailed = (records[i].newRuns > 0)
+            ? records[i].newHasFailed
+            : records[i].hasFailed;
+        records[i].newRuns = 0;
+        records[i].newFlips = 0;
+    }
+failed:
+    if ((fclose(file) == EOF) && (error == SCUNIT_ERROR_NONE)) {
+        error = SCUNIT_ERROR_CLOSING_STREAM_FAILED;
+    }
+    return error;
+}
+
+void scunit_flaky_unload() {
+    for (int64_t i = 0; i < recordCount; i++) {
+        SCUNIT_FREE(records[i].name);
+    }
+    SCUNIT_FREE(records);
+    records = nullptr;
+    recordCapacity = 0;
+    recordCount = 0;
+    SCUNIT_FREE(buckets);
+    buckets = nullptr;
+    bucketCount = 0;
+    for (int64_t i = 0; i < patternCount; i++) {
+        SCUNIT_FREE(patterns[i].suitePattern);
+    }
+    SCUNIT_FREE(patterns);
+    patterns = nullptr;
+    patternCapacity = 0;
+    patternCount = 0;
+}
\ No newline at end of file
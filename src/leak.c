@@ -0,0 +1,255 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <SCUnit/leak.h>
+#include <SCUnit/memory.h>
+
+/** @brief Size used for initially allocating an array of identifiers. */
+static constexpr int64_t INITIAL_CAPACITY = 64;
+
+/** @brief Growth factor used for resizing an array of identifiers. */
+static constexpr int64_t GROWTH_FACTOR = 2;
+
+/** @brief Represents a sorted array of identifiers (file descriptors or thread IDs). */
+typedef struct Identifiers {
+
+    /**
+     * @brief Identifiers in ascending order.
+     *
+     * @note This is a dynamically resized array with storage for `capacity` elements.
+     */
+    int64_t* values;
+
+    /** @brief Number of identifiers. */
+    int64_t count;
+
+    /** @brief Capacity of the array of identifiers. */
+    int64_t capacity;
+
+} Identifiers;
+
+/** @brief File descriptors open before the current test. */
+static Identifiers fileDescriptorsBefore;
+
+/** @brief Threads running before the current test. */
+static Identifiers threadsBefore;
+
+/** @brief File descriptors open after the current test. */
+static Identifiers fileDescriptorsAfter;
+
+/** @brief Threads running after the current test. */
+static Identifiers threadsAfter;
+
+/**
+ * @brief Compares two identifiers.
+ *
+ * @param[in] first  First identifier to compare.
+ * @param[in] second Second identifier to compare.
+ * @return A negative value, zero or a positive value if the first identifier is less than, equal
+ *         to or greater than the second one.
+ */
+static int compareIdentifiers(const void* first, const void* second) {
+    int64_t firstIdentifier = *(const int64_t*) first;
+    int64_t secondIdentifier = *(const int64_t*) second;
+    return (firstIdentifier > secondIdentifier) - (firstIdentifier < secondIdentifier);
+}
+
+/**
+ * @brief Reads the numeric entries of a directory in `/proc` into a sorted array of identifiers.
+ *
+ * @note The file descriptor of the directory stream itself is left out, since it only exists
+ * while reading.
+ *
+ * @param[in]  path        A null-terminated string for the path of the directory.
+ * @param[out] identifiers Identifiers to read the entries into.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_READING_STREAM_FAILED` if reading the directory failed and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+static SCUnitError readIdentifiers(const char* path, Identifiers* identifiers) {
+    DIR* directory = opendir(path);
+    if (directory == nullptr) {
+        return SCUNIT_ERROR_READING_STREAM_FAILED;
+    }
+    int directoryFd = dirfd(directory);
+    identifiers->count = 0;
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != nullptr) {
+        char* end;
+        int64_t identifier = strtoll(entry->d_name, &end, 10);
+        if ((*entry->d_name == '.') || (*end != '\0') || (identifier == directoryFd)) {
+            continue;
+        }
+        if (identifiers->count == identifiers->capacity) {
+            int64_t newCapacity = (identifiers->capacity > 0)
+                ? identifiers->capacity * GROWTH_FACTOR
+                : INITIAL_CAPACITY;
+            int64_t* newValues = SCUNIT_REALLOC(identifiers->values, newCapacity * sizeof(int64_t));
+            if (newValues == nullptr) {
+                error = SCUNIT_ERROR_OUT_OF_MEMORY;
+                goto failed;
+            }
+            identifiers->values = newValues;
+            identifiers->capacity = newCapacity;
+        }
+        identifiers->values[identifiers->count++] = identifier;
+    }
+    qsort(identifiers->values, identifiers->count, sizeof(int64_t), compareIdentifiers);
+failed:
+    closedir(directory);
+    return error;
+}
+
+/**
+ * @brief Appends a description of a leaked file descriptor to a given `SCUnitContext`.
+ *
+ * @param[in, out] context        `SCUnitContext` to append the description to.
+ * @param[in]      fileDescriptor Leaked file descriptor.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendFileDescriptor(SCUnitContext* context, int64_t fileDescriptor) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/fd/%" PRId64, fileDescriptor);
+    char target[256];
+    ssize_t length = readlink(path, target, sizeof(target) - 1);
+    if (length < 0) {
+        return scunit_context_appendMessage(context, "    %" PRId64 "\n", fileDescriptor);
+    }
+    target[length] = '\0';
+    return scunit_context_appendMessage(
+        context,
+        "    %" PRId64 " -> %s\n",
+        fileDescriptor,
+        target
+    );
+}
+
+/**
+ * @brief Appends a description of a leaked thread to a given `SCUnitContext`.
+ *
+ * @param[in, out] context  `SCUnitContext` to append the description to.
+ * @param[in]      threadId ID of the leaked thread.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendThread(SCUnitContext* context, int64_t threadId) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/self/task/%" PRId64 "/comm", threadId);
+    char name[64] = "";
+    FILE* file = fopen(path, "r");
+    if (file != nullptr) {
+        if (fgets(name, sizeof(name), file) != nullptr) {
+            name[strcspn(name, "\n")] = '\0';
+        }
+        fclose(file);
+    }
+    return scunit_context_appendMessage(context, "    %" PRId64 " (%s)\n", threadId, name);
+}
+
+/**
+ * @brief Reports the identifiers present after a test but not before it to a given
+ * `SCUnitContext`.
+ *
+ * @note Both arrays are sorted, so they are compared in a single linear pass.
+ *
+ * @param[in, out] context `SCUnitContext` to report the leaks to.
+ * @param[in]      before  Identifiers present before the test.
+ * @param[in]      after   Identifiers present after the test.
+ * @param[in]      noun    A null-terminated string for the plural noun describing the identifiers.
+ * @param[in]      append  Function appending a description of a single leaked identifier.
+ * @param[out]     isLeak  Whether any identifiers were leaked (left untouched otherwise).
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError reportLeaks(
+    SCUnitContext* context,
+    const Identifiers* before,
+    const Identifiers* after,
+    const char* noun,
+    SCUnitError (*append)(SCUnitContext* context, int64_t identifier),
+    bool* isLeak
+) {
+    bool isReported = false;
+    int64_t j = 0;
+    for (int64_t i = 0; i < after->count; i++) {
+        while ((j < before->count) && (before->values[j] < after->values[i])) {
+            j++;
+        }
+        if ((j < before->count) && (before->values[j] == after->values[i])) {
+            continue;
+        }
+        SCUnitError error;
+        if (!isReported) {
+            error = scunit_context_appendMessage(context, "\n  Leaked %s:\n\n", noun);
+            if (error != SCUNIT_ERROR_NONE) {
+                return error;
+            }
+            isReported = true;
+            *isLeak = true;
+        }
+        error = append(context, after->values[i]);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitError scunit_leak_snapshot() {
+    SCUnitError error = readIdentifiers("/proc/self/fd", &fileDescriptorsBefore);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return readIdentifiers("/proc/self/task", &threadsBefore);
+}
+
+SCUnitError scunit_leak_check(SCUnitContext* context) {
+    SCUnitError error = readIdentifiers("/proc/self/fd", &fileDescriptorsAfter);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    error = readIdentifiers("/proc/self/task", &threadsAfter);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    bool isLeak = false;
+    error = reportLeaks(
+        context,
+        &fileDescriptorsBefore,
+        &fileDescriptorsAfter,
+        "file descriptors",
+        appendFileDescriptor,
+        &isLeak
+    );
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    error = reportLeaks(context, &threadsBefore, &threadsAfter, "threads", appendThread, &isLeak);
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    if (!isLeak) {
+        return SCUNIT_ERROR_NONE;
+    }
+    error = scunit_context_appendMessage(context, "\n");
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+}
+
+/** @brief Frees the snapshots once the process exits. */
+[[gnu::destructor]]
+static void freeSnapshots() {
+    SCUNIT_FREE(fileDescriptorsBefore.values);
+    SCUNIT_FREE(threadsBefore.values);
+    SCUNIT_FREE(fileDescriptorsAfter.values);
+    SCUNIT_FREE(threadsAfter.values);
+}
\ No newline at end of file
@@ -0,0 +1,251 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <SCUnit/limit.h>
+
+/** @brief Number of nanoseconds per second. */
+static constexpr int64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
+/** @brief Number of bytes per mebibyte. */
+static constexpr double BYTES_PER_MEBIBYTE = 1024.0 * 1024.0;
+
+/** @brief Resources of `setrlimit()` corresponding to each `SCUnitLimit`. */
+static const int RESOURCES[] = { RLIMIT_AS, RLIMIT_CPU, RLIMIT_NOFILE };
+
+/** @brief Global values of each `SCUnitLimit`, which apply to every test. */
+static int64_t globalLimits[SCUNIT_LIMIT_FILE_DESCRIPTORS + 1];
+
+/** @brief Values of each `SCUnitLimit` for the current test. */
+static int64_t testLimits[SCUNIT_LIMIT_FILE_DESCRIPTORS + 1];
+
+/** @brief Original limits of each resource, saved before it is limited for the first time. */
+static struct rlimit originalLimits[SCUNIT_LIMIT_FILE_DESCRIPTORS + 1];
+
+/** @brief Whether each resource is currently limited by SCUnit. */
+static bool isLimited[SCUNIT_LIMIT_FILE_DESCRIPTORS + 1];
+
+/** @brief CPU time consumed by the process before the current test (in nanoseconds). */
+static int64_t cpuTimeBefore;
+
+/** @brief Peak address space of the process before the current test (in bytes). */
+static int64_t peakAddressSpaceBefore;
+
+/**
+ * @brief Returns the CPU time consumed by the process so far.
+ *
+ * @note This is the same time `RLIMIT_CPU` is enforced against.
+ *
+ * @return The CPU time consumed by the process so far (in nanoseconds).
+ */
+static int64_t getCPUTime() {
+    struct timespec time;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) < 0) {
+        return 0;
+    }
+    return (((int64_t) time.tv_sec) * NANOSECONDS_PER_SECOND) + time.tv_nsec;
+}
+
+/**
+ * @brief Returns the peak address space of the process so far.
+ *
+ * @return The peak address space of the process so far (in bytes) or zero if it is unknown.
+ */
+static int64_t getPeakAddressSpace() {
+    FILE* status = fopen("/proc/self/status", "r");
+    if (status == nullptr) {
+        return 0;
+    }
+    char line[256];
+    int64_t peak = 0;
+    while (fgets(line, sizeof(line), status) != nullptr) {
+        if (sscanf(line, "VmPeak: %" SCNd64 " kB", &peak) == 1) {
+            break;
+        }
+    }
+    fclose(status);
+    return peak * 1024;
+}
+
+/**
+ * @brief Returns the number of file descriptors open in the process.
+ *
+ * @return The number of file descriptors open in the process or `-1` if it is unknown.
+ */
+static int64_t countFileDescriptors() {
+    DIR* directory = opendir("/proc/self/fd");
+    if (directory == nullptr) {
+        return -1;
+    }
+    int64_t count = 0;
+    struct dirent* entry;
+    while ((entry = readdir(directory)) != nullptr) {
+        if (entry->d_name[0] != '.') {
+            count++;
+        }
+    }
+    closedir(directory);
+    // The directory stream itself holds a file descriptor while counting.
+    return count - 1;
+}
+
+/**
+ * @brief Applies the value of a given `SCUnitLimit` for the current test using `setrlimit()`.
+ *
+ * @note Soft limits are clamped to the hard limit of the process, which cannot be raised without
+ * privileges. If the resource is unlimited, its original soft limit is restored.
+ *
+ * @param[in] limit `SCUnitLimit` to apply.
+ * @return `SCUNIT_ERROR_SETTING_RESOURCE_LIMIT_FAILED` if applying the limit failed, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError applyLimit(SCUnitLimit limit) {
+    int64_t value = testLimits[limit];
+    if ((value == 0) && !isLimited[limit]) {
+        return SCUNIT_ERROR_NONE;
+    }
+    if (!isLimited[limit] && (getrlimit(RESOURCES[limit], &originalLimits[limit]) < 0)) {
+        return SCUNIT_ERROR_SETTING_RESOURCE_LIMIT_FAILED;
+    }
+    struct rlimit newLimit = originalLimits[limit];
+    if (value > 0) {
+        // `RLIMIT_CPU` counts the CPU time of the whole process in seconds, so the budget of the
+        // test is added to what the process has consumed before it.
+        rlim_t softLimit = (limit == SCUNIT_LIMIT_CPU_TIME)
+            ? (rlim_t) ((cpuTimeBefore + value + NANOSECONDS_PER_SECOND - 1)
+                / NANOSECONDS_PER_SECOND)
+            : (rlim_t) value;
+        if ((newLimit.rlim_max == RLIM_INFINITY) || (softLimit < newLimit.rlim_max)) {
+            newLimit.rlim_cur = softLimit;
+        }
+        else {
+            newLimit.rlim_cur = newLimit.rlim_max;
+        }
+    }
+    if (setrlimit(RESOURCES[limit], &newLimit) < 0) {
+        return SCUNIT_ERROR_SETTING_RESOURCE_LIMIT_FAILED;
+    }
+    isLimited[limit] = (value > 0);
+    return SCUNIT_ERROR_NONE;
+}
+
+int64_t scunit_limit_get(SCUnitLimit limit) {
+    if ((limit < SCUNIT_LIMIT_ADDRESS_SPACE) || (limit > SCUNIT_LIMIT_FILE_DESCRIPTORS)) {
+        return 0;
+    }
+    return globalLimits[limit];
+}
+
+SCUnitError scunit_limit_set(SCUnitLimit limit, int64_t value) {
+    if ((limit < SCUNIT_LIMIT_ADDRESS_SPACE) || (limit > SCUNIT_LIMIT_FILE_DESCRIPTORS)
+            || (value < 0)) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    globalLimits[limit] = value;
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitError scunit_limit_setForTest(SCUnitLimit limit, int64_t value) {
+    if ((limit < SCUNIT_LIMIT_ADDRESS_SPACE) || (limit > SCUNIT_LIMIT_FILE_DESCRIPTORS)
+            || (value < 0)) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    testLimits[limit] = value;
+    return applyLimit(limit);
+}
+
+SCUnitError scunit_limit_begin() {
+    memcpy(testLimits, globalLimits, sizeof(testLimits));
+    cpuTimeBefore = getCPUTime();
+    peakAddressSpaceBefore = getPeakAddressSpace();
+    for (SCUnitLimit limit = SCUNIT_LIMIT_ADDRESS_SPACE; limit <= SCUNIT_LIMIT_FILE_DESCRIPTORS;
+            limit++) {
+        SCUnitError error = applyLimit(limit);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitError scunit_limit_end(SCUnitContext* context) {
+    int64_t cpuTime = getCPUTime() - cpuTimeBefore;
+    // Lift the limits before observing the usage, since opening `/proc` may itself fail while the
+    // limits are in place (e. g. if all file descriptors are exhausted).
+    int64_t limits[SCUNIT_LIMIT_FILE_DESCRIPTORS + 1];
+    memcpy(limits, testLimits, sizeof(limits));
+    memset(testLimits, 0, sizeof(testLimits));
+    for (SCUnitLimit limit = SCUNIT_LIMIT_ADDRESS_SPACE; limit <= SCUNIT_LIMIT_FILE_DESCRIPTORS;
+            limit++) {
+        SCUnitError error = applyLimit(limit);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    bool isViolated = false;
+    bool isReported = false;
+    if ((limits[SCUNIT_LIMIT_CPU_TIME] > 0) && (cpuTime > limits[SCUNIT_LIMIT_CPU_TIME])) {
+        error = scunit_context_appendMessage(
+            context,
+            "\n  CPU time limit exceeded: used %.3F s of %.3F s.\n",
+            ((double) cpuTime) / NANOSECONDS_PER_SECOND,
+            ((double) limits[SCUNIT_LIMIT_CPU_TIME]) / NANOSECONDS_PER_SECOND
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        isViolated = true;
+        isReported = true;
+    }
+    if (limits[SCUNIT_LIMIT_FILE_DESCRIPTORS] > 0) {
+        // The number of open file descriptors can never exceed the limit, so reaching it means
+        // that the test ran out of them.
+        int64_t fileDescriptors = countFileDescriptors();
+        if (fileDescriptors >= limits[SCUNIT_LIMIT_FILE_DESCRIPTORS]) {
+            error = scunit_context_appendMessage(
+                context,
+                "\n  File descriptor limit reached: %" PRId64 " of %" PRId64
+                    " open after the test.\n",
+                fileDescriptors,
+                limits[SCUNIT_LIMIT_FILE_DESCRIPTORS]
+            );
+            if (error != SCUNIT_ERROR_NONE) {
+                return error;
+            }
+            isViolated = true;
+            isReported = true;
+        }
+    }
+    if (limits[SCUNIT_LIMIT_ADDRESS_SPACE] > 0) {
+        // Allocations beyond the limit simply fail, so the usage can never be observed above it.
+        // If the test failed and grew the address space of the process, the peak is reported
+        // instead, since exhausting the address space is a likely cause of the failure.
+        int64_t peakAddressSpace = getPeakAddressSpace();
+        if ((isViolated || (scunit_context_getResult(context) == SCUNIT_RESULT_FAIL))
+                && (peakAddressSpace > peakAddressSpaceBefore)) {
+            error = scunit_context_appendMessage(
+                context,
+                "\n  Address space peaked at %.1F MiB of %.1F MiB.\n",
+                ((double) peakAddressSpace) / BYTES_PER_MEBIBYTE,
+                ((double) limits[SCUNIT_LIMIT_ADDRESS_SPACE]) / BYTES_PER_MEBIBYTE
+            );
+            if (error != SCUNIT_ERROR_NONE) {
+                return error;
+            }
+            isReported = true;
+        }
+    }
+    if (!isReported) {
+        return SCUNIT_ERROR_NONE;
+    }
+    error = scunit_context_appendMessage(context, "\n");
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    return isViolated ? scunit_context_setResult(context, SCUNIT_RESULT_FAIL) : SCUNIT_ERROR_NONE;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <inttypes.h>
+#include <SCUnit/mock.h>
+
+/**
+ * @brief Mocks activated during the current test, forming a singly linked list.
+ *
+ * @note This list acts as the dispatch table of the current test: Only the mocks in it route calls
+ * to their fake implementations, while all other mocks forward calls to the real functions.
+ */
+static SCUnitMock* activeMocks;
+
+void scunit_mock_activate(SCUnitMock* mock) {
+    if (mock->active) {
+        return;
+    }
+    mock->active = true;
+    mock->next = activeMocks;
+    activeMocks = mock;
+}
+
+SCUnitError scunit_mock_verify(SCUnitContext* context) {
+    for (const SCUnitMock* mock = activeMocks; mock != nullptr; mock = mock->next) {
+        if ((mock->expectedCalls < 0) || (mock->calls == mock->expectedCalls)) {
+            continue;
+        }
+        SCUnitError error = scunit_context_appendMessage(
+            context,
+            "\n  Expectation failed in %s:%" PRId64 ":\n\n",
+            mock->file,
+            mock->line
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        error = scunit_context_appendFileContext(context, mock->file, mock->line);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        error = scunit_context_appendMessage(
+            context,
+            "\n  Expected %s to be called %" PRId64 " time(s), but it was called %" PRId64
+                " time(s).\n\n",
+            mock->name,
+            mock->expectedCalls,
+            mock->calls
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        error = scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+void scunit_mock_reset() {
+    SCUnitMock* mock = activeMocks;
+    activeMocks = nullptr;
+    while (mock != nullptr) {
+        // Resetting a mock clears its link, so the next one must be retrieved beforehand.
+        SCUnitMock* next = mock->next;
+        mock->reset(mock);
+        mock = next;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include <dlfcn.h>
+#include <string.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/module.h>
+#include <SCUnit/scunit.h>
+
+struct SCUnitModule {
+
+    /**
+     * @brief Path this `SCUnitModule` was loaded from.
+     *
+     * @note This is a dynamically allocated string managed by this `SCUnitModule`.
+     */
+    char* path;
+
+    /** @brief Handle of the shared object returned by `dlopen()`. */
+    void* handle;
+
+    /**
+     * @brief Suites registered while loading this `SCUnitModule`.
+     *
+     * @note This is a dynamically allocated array with storage for `suiteCount` elements, except if
+     * `suiteCount` is zero, in which case it is a `nullptr`.
+     */
+    SCUnitSuite** suites;
+
+    /** @brief Number of suites registered while loading this `SCUnitModule`. */
+    int64_t suiteCount;
+
+};
+
+SCUnitModule* scunit_module_load(const char* path, SCUnitError* error) {
+    SCUnitModule* module = SCUNIT_MALLOC(sizeof(SCUnitModule));
+    if (module == nullptr) {
+        *error = SCUNIT_ERROR_OUT_OF_MEMORY;
+        goto moduleAllocationFailed;
+    }
+    *module = (SCUnitModule) { };
+    module->path = strdup(path);
+    if (module->path == nullptr) {
+        *error = SCUNIT_ERROR_OUT_OF_MEMORY;
+        goto pathAllocationFailed;
+    }
+    // Suites of a module are registered by its constructors while `dlopen()` is executed, so all
+    // suites appended to the registry in the meantime belong to this module.
+    int64_t firstSuite = scunit_getSuiteCount();
+    module->handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (module->handle == nullptr) {
+        *error = SCUNIT_ERROR_LOADING_MODULE_FAILED;
+        goto loadingFailed;
+    }
+    module->suiteCount = scunit_getSuiteCount() - firstSuite;
+    if (module->suiteCount > 0) {
+        module->suites = SCUNIT_MALLOC(module->suiteCount * sizeof(SCUnitSuite*));
+        if (module->suites == nullptr) {
+            // We cannot simply keep the module loaded without tracking its suites, since they would
+            // otherwise reference unloaded code once the module is unloaded.
+            for (int64_t i = 0; i < module->suiteCount; i++) {
+                SCUnitSuite* suite = scunit_getSuite(firstSuite);
+                scunit_unregisterSuite(suite);
+                scunit_suite_free(suite);
+            }
+            *error = SCUNIT_ERROR_OUT_OF_MEMORY;
+            goto suitesAllocationFailed;
+        }
+        for (int64_t i = 0; i < module->suiteCount; i++) {
+            module->suites[i] = scunit_getSuite(firstSuite + i);
+        }
+    }
+    *error = SCUNIT_ERROR_NONE;
+    return module;
+suitesAllocationFailed:
+    dlclose(module->handle);
+loadingFailed:
+    SCUNIT_FREE(module->path);
+pathAllocationFailed:
+    SCUNIT_FREE(module);
+moduleAllocationFailed:
+    return nullptr;
+}
+
+const char* scunit_module_getPath(const SCUnitModule* module) {
+    return module->path;
+}
+
+int64_t scunit_module_getSuiteCount(const SCUnitModule* module) {
+    return module->suiteCount;
+}
+
+SCUnitSuite* scunit_module_getSuite(const SCUnitModule* module, int64_t index) {
+    return ((index >= 0) && (index < module->suiteCount)) ? module->suites[index] : nullptr;
+}
+
+SCUnitError scunit_module_unload(SCUnitModule* module) {
+    if (module == nullptr) {
+        return SCUNIT_ERROR_NONE;
+    }
+    // The suites reference test functions (and possibly names) inside the shared object, so they
+    // must be unregistered and deallocated before the shared object is actually unloaded.
+    for (int64_t i = 0; i < module->suiteCount; i++) {
+        scunit_unregisterSuite(module->suites[i]);
+        scunit_suite_free(module->suites[i]);
+    }
+    SCUnitError error = (dlclose(module->handle) == 0)
+        ? SCUNIT_ERROR_NONE
+        : SCUNIT_ERROR_UNLOADING_MODULE_FAILED;
+    SCUNIT_FREE(module->suites);
+    SCUNIT_FREE(module->path);
+    SCUNIT_FREE(module);
+    return error;
+}
\ No newline at end of file
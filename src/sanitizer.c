@@ -0,0 +1,359 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/sanitizer.h>
+
+/**
+ * @brief Redirects all reports of the sanitizer runtime to a file with a given path prefix.
+ *
+ * @note This function is part of the common interface of all sanitizer runtimes. It is declared
+ * weak, so that it is a `nullptr` unless the test executable is built with a sanitizer. The
+ * runtime appends the process ID to the prefix and only creates the file on the first report.
+ *
+ * @param[in] path A null-terminated string for the path prefix of the report file.
+ */
+[[gnu::weak]]
+void __sanitizer_set_report_path(const char* path);
+
+/**
+ * @brief Registers a function called right before a sanitizer runtime terminates the process.
+ *
+ * @note This function is part of the common interface of all sanitizer runtimes. It is declared
+ * weak, so that it is a `nullptr` unless the test executable is built with a sanitizer.
+ *
+ * @param[in] callback Function to call before the process is terminated.
+ */
+[[gnu::weak]]
+void __sanitizer_set_death_callback(void (*callback)());
+
+/**
+ * @brief Retrieves the details of the report UndefinedBehaviorSanitizer is currently producing.
+ *
+ * @note This function is part of the interface of the UndefinedBehaviorSanitizer runtime. It is
+ * declared weak, so that it is a `nullptr` unless the test executable is built with it.
+ *
+ * @param[out] issueKind     Kind of the issue (e. g. `signed-integer-overflow`).
+ * @param[out] message       Message of the report.
+ * @param[out] file          Source file the issue occurred in.
+ * @param[out] line          Line the issue occurred at.
+ * @param[out] column        Column the issue occurred at.
+ * @param[out] memoryAddress Memory address involved in the issue (if any).
+ */
+[[gnu::weak]]
+void __ubsan_get_current_report_data(
+    const char** issueKind,
+    const char** message,
+    const char** file,
+    unsigned int* line,
+    unsigned int* column,
+    char** memoryAddress
+);
+
+/** @brief Size of the chunks in which reports are read (in bytes). */
+static constexpr int64_t CHUNK_SIZE = 4096;
+
+/** @brief Template for the name of the temporary directory the report file is created in. */
+static constexpr char DIRECTORY_TEMPLATE[] = "scunit-sanitizer-XXXXXX";
+
+/**
+ * @brief Path of the temporary directory the report file is created in.
+ *
+ * @note The paths are stored in static buffers, since they are still needed when a sanitizer
+ * runtime terminates the process, at which point memory must no longer be allocated.
+ */
+static char directoryPath[PATH_MAX];
+
+/** @brief Path prefix of the report file passed to the sanitizer runtime. */
+static char reportPrefix[PATH_MAX];
+
+/** @brief Path of the report file written by the sanitizer runtime. */
+static char reportPath[PATH_MAX];
+
+/** @brief Whether the reports of the sanitizer runtime are redirected to the report file. */
+static bool isEnabled;
+
+/**
+ * @brief File descriptor of the report file or `-1` if it was not opened yet.
+ *
+ * @note The runtime only creates the file on the first report, so it is opened lazily.
+ */
+static int reportFd = -1;
+
+/** @brief Offset up to which the reports have already been attached to a test. */
+static int64_t attachedOffset;
+
+/**
+ * @brief Reports of UndefinedBehaviorSanitizer that were not attached to a test yet.
+ *
+ * @note UndefinedBehaviorSanitizer writes its reports to `stderr` regardless of the report file,
+ * so they are collected using the `__ubsan_on_report()` hook instead. This is a dynamically
+ * allocated string.
+ */
+static char* undefinedBehaviorReports;
+
+/** @brief Length of the reports of UndefinedBehaviorSanitizer not attached to a test yet. */
+static int64_t undefinedBehaviorReportsLength;
+
+/** @brief Whether an out-of-memory condition occurred while collecting a report. */
+static bool isOutOfMemory;
+
+/** @brief Name of the current suite or a `nullptr` if no suite is currently being executed. */
+static const char* currentSuiteName;
+
+/** @brief Name of the current test or a `nullptr` if no test is currently being executed. */
+static const char* currentTestName;
+
+/**
+ * @brief Opens the report file if it was not opened yet and exists by now.
+ *
+ * @return `true` if the report file is open, otherwise `false`.
+ */
+static bool openReports() {
+    if (reportFd < 0) {
+        reportFd = open(reportPath, O_RDONLY);
+    }
+    return reportFd >= 0;
+}
+
+/**
+ * @brief Writes a given buffer completely to a file descriptor, retrying after short writes.
+ *
+ * @note This function is async-signal-safe. Errors are ignored on purpose, since it is only used
+ * while the process is terminating and there is nowhere left to report them to.
+ *
+ * @param[in] fd     File descriptor to write to.
+ * @param[in] buffer Buffer to write.
+ * @param[in] size   Size of the buffer (in bytes).
+ */
+static void writeAll(int fd, const void* buffer, size_t size) {
+    const char* current = buffer;
+    while (size > 0) {
+        ssize_t written = write(fd, current, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        current += written;
+        size -= (size_t) written;
+    }
+}
+
+/**
+ * @brief Writes the unattached reports and the current test to `stderr` right before a sanitizer
+ * runtime terminates the process.
+ *
+ * @note Everything but the flushing of `stdout` is written using `write()` directly, since the
+ * process may be in a fragile state (e. g. with a corrupted heap).
+ */
+static void reportDeath() {
+    fflush(stdout);
+    if (openReports()) {
+        char chunk[CHUNK_SIZE];
+        ssize_t length;
+        while ((length = pread(reportFd, chunk, sizeof(chunk), attachedOffset)) > 0) {
+            writeAll(STDERR_FILENO, chunk, (size_t) length);
+            attachedOffset += length;
+        }
+    }
+    // The destructor removing the report file is never called if the process is terminated.
+    unlink(reportPath);
+    rmdir(directoryPath);
+    if (currentSuiteName == nullptr) {
+        return;
+    }
+    static const char prefix[] = "\nA sanitizer terminated the process while executing ";
+    writeAll(STDERR_FILENO, prefix, sizeof(prefix) - 1);
+    writeAll(STDERR_FILENO, currentSuiteName, strlen(currentSuiteName));
+    if (currentTestName != nullptr) {
+        writeAll(STDERR_FILENO, ".", 1);
+        writeAll(STDERR_FILENO, currentTestName, strlen(currentTestName));
+    }
+    writeAll(STDERR_FILENO, ".\n", 2);
+}
+
+/**
+ * @brief Redirects the reports of the sanitizer runtime (if any) to a file in a new temporary
+ * directory.
+ *
+ * @note The runtime is set up before any suites are registered, so that every report produced by
+ * a test can be attributed to it. Like the temporary directories of tests, the directory is created
+ * in `$TMPDIR` (or `/tmp` if it is not set). The option `--temp-dir` has no effect on it, since
+ * it is only parsed later.
+ */
+[[gnu::constructor(101)]]
+static void redirectReports() {
+    if (__sanitizer_set_report_path == nullptr) {
+        return;
+    }
+    const char* root = getenv("TMPDIR");
+    if ((root == nullptr) || (*root == '\0')) {
+        root = "/tmp";
+    }
+    int length = snprintf(directoryPath, sizeof(directoryPath), "%s/%s", root, DIRECTORY_TEMPLATE);
+    if ((length < 0) || (length >= (int) sizeof(directoryPath))
+            || (mkdtemp(directoryPath) == nullptr)) {
+        return;
+    }
+    int prefixLength = snprintf(reportPrefix, sizeof(reportPrefix), "%s/report", directoryPath);
+    int pathLength = snprintf(
+        reportPath,
+        sizeof(reportPath),
+        "%s.%ld",
+        reportPrefix,
+        (long) getpid()
+    );
+    if ((prefixLength >= (int) sizeof(reportPrefix)) || (pathLength >= (int) sizeof(reportPath))) {
+        rmdir(directoryPath);
+        return;
+    }
+    __sanitizer_set_report_path(reportPrefix);
+    if (__sanitizer_set_death_callback != nullptr) {
+        __sanitizer_set_death_callback(reportDeath);
+    }
+    isEnabled = true;
+}
+
+/** @brief Removes the report file and its temporary directory once the process exits normally. */
+[[gnu::destructor]]
+static void removeReports() {
+    if (!isEnabled) {
+        return;
+    }
+    if (reportFd >= 0) {
+        close(reportFd);
+    }
+    unlink(reportPath);
+    rmdir(directoryPath);
+}
+
+/**
+ * @brief Collects the report UndefinedBehaviorSanitizer is currently producing.
+ *
+ * @note This function overrides a weak hook of the UndefinedBehaviorSanitizer runtime, which
+ * calls it for every report.
+ */
+void __ubsan_on_report() {
+    if (__ubsan_get_current_report_data == nullptr) {
+        return;
+    }
+    const char* issueKind;
+    const char* message;
+    const char* file;
+    unsigned int line;
+    unsigned int column;
+    char* memoryAddress;
+    __ubsan_get_current_report_data(&issueKind, &message, &file, &line, &column, &memoryAddress);
+    const char* format = "%s:%u:%u: runtime error: %s\n";
+    int length = snprintf(nullptr, 0, format, file, line, column, message);
+    if (length < 0) {
+        return;
+    }
+    char* newReports = SCUNIT_REALLOC(
+        undefinedBehaviorReports,
+        undefinedBehaviorReportsLength + length + 1
+    );
+    if (newReports == nullptr) {
+        isOutOfMemory = true;
+        return;
+    }
+    undefinedBehaviorReports = newReports;
+    snprintf(
+        undefinedBehaviorReports + undefinedBehaviorReportsLength,
+        length + 1,
+        format,
+        file,
+        line,
+        column,
+        message
+    );
+    undefinedBehaviorReportsLength += length;
+}
+
+bool scunit_sanitizer_isEnabled() {
+    return isEnabled || (__ubsan_get_current_report_data != nullptr);
+}
+
+void scunit_sanitizer_setCurrentTest(const char* suiteName, const char* testName) {
+    currentSuiteName = suiteName;
+    currentTestName = testName;
+}
+
+SCUnitError scunit_sanitizer_attachReports(SCUnitContext* context) {
+    if (isOutOfMemory) {
+        isOutOfMemory = false;
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    // Without a sanitizer runtime, there is never anything to attach.
+    if (!isEnabled && (undefinedBehaviorReportsLength == 0)) {
+        return SCUNIT_ERROR_NONE;
+    }
+    char* text = nullptr;
+    int64_t length = 0;
+    if (isEnabled && openReports()) {
+        ssize_t readBytes;
+        do {
+            char* newText = SCUNIT_REALLOC(text, length + CHUNK_SIZE);
+            if (newText == nullptr) {
+                SCUNIT_FREE(text);
+                return SCUNIT_ERROR_OUT_OF_MEMORY;
+            }
+            text = newText;
+            readBytes = pread(reportFd, text + length, CHUNK_SIZE, attachedOffset + length);
+            if (readBytes < 0) {
+                SCUNIT_FREE(text);
+                return SCUNIT_ERROR_READING_STREAM_FAILED;
+            }
+            length += readBytes;
+        }
+        while (readBytes > 0);
+        attachedOffset += length;
+    }
+    char* newText = SCUNIT_REALLOC(text, length + undefinedBehaviorReportsLength + 1);
+    if (newText == nullptr) {
+        SCUNIT_FREE(text);
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    text = newText;
+    if (undefinedBehaviorReportsLength > 0) {
+        memcpy(text + length, undefinedBehaviorReports, undefinedBehaviorReportsLength);
+        length += undefinedBehaviorReportsLength;
+        undefinedBehaviorReportsLength = 0;
+    }
+    text[length] = '\0';
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    if (length == 0) {
+        goto finished;
+    }
+    error = scunit_context_appendMessage(context, "\n  Sanitizer report:\n\n");
+    if (error != SCUNIT_ERROR_NONE) {
+        goto finished;
+    }
+    // Indent every line of the reports to match the other messages of the test.
+    for (char* line = text; *line != '\0';) {
+        char* end = strchr(line, '\n');
+        int lineLength = (int) ((end != nullptr) ? (end - line) : (int64_t) strlen(line));
+        error = scunit_context_appendMessage(context, "  %.*s\n", lineLength, line);
+        if (error != SCUNIT_ERROR_NONE) {
+            goto finished;
+        }
+        line += lineLength + ((end != nullptr) ? 1 : 0);
+    }
+    error = scunit_context_appendMessage(context, "\n");
+    if (error != SCUNIT_ERROR_NONE) {
+        goto finished;
+    }
+    error = scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+finished:
+    SCUNIT_FREE(text);
+    return error;
+}
\ No newline at end of file
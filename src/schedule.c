@@ -0,0 +1,478 @@
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/optimize.h>
+#include <SCUnit/random.h>
+#include <SCUnit/schedule.h>
+
+/** @brief Represents an enumeration of the states of a thread of an `SCUnitSchedule`. */
+typedef enum SCUnitThreadState {
+
+    /** @brief Indicates that the thread can be chosen to run. */
+    SCUNIT_THREAD_STATE_RUNNABLE,
+
+    /** @brief Indicates that the thread is blocked on an `SCUnitMutex`. */
+    SCUNIT_THREAD_STATE_BLOCKED,
+
+    /** @brief Indicates that the thread has finished. */
+    SCUNIT_THREAD_STATE_FINISHED
+
+} SCUnitThreadState;
+
+/** @brief Represents a single thread of an `SCUnitSchedule`. */
+typedef struct SCUnitThread {
+
+    /** @brief `SCUnitSchedule` the thread belongs to. */
+    SCUnitSchedule* schedule;
+
+    /** @brief Index of the thread within its `SCUnitSchedule`. */
+    int64_t index;
+
+    /** @brief `SCUnitThreadFunction` executed as the thread. */
+    SCUnitThreadFunction function;
+
+    /** @brief Argument passed to the function. */
+    void* argument;
+
+    /** @brief Handle of the underlying POSIX thread. */
+    pthread_t handle;
+
+    /** @brief Current state of the thread. */
+    SCUnitThreadState state;
+
+    /** @brief `SCUnitMutex` the thread is blocked on (only valid if it is blocked). */
+    const SCUnitMutex* blockedOn;
+
+    /** @brief Priority of the thread (only used by the PCT strategy). */
+    int64_t priority;
+
+} SCUnitThread;
+
+struct SCUnitSchedule {
+
+    /** @brief `SCUnitScheduleStrategy` used to choose the next thread to run. */
+    SCUnitScheduleStrategy strategy;
+
+    /** @brief `SCUnitRandom` driving all decisions of this `SCUnitSchedule`. */
+    SCUnitRandom* random;
+
+    /** @brief Depth of the PCT strategy. */
+    int64_t depth;
+
+    /** @brief Estimated number of steps (scheduling points) of a run. */
+    int64_t steps;
+
+    /**
+     * @brief Threads of this `SCUnitSchedule`.
+     *
+     * @note This is a dynamically allocated array managed by this `SCUnitSchedule`.
+     */
+    SCUnitThread* threads;
+
+    /** @brief Number of threads of this `SCUnitSchedule`. */
+    int64_t threadCount;
+
+    /** @brief Capacity of the array of threads. */
+    int64_t threadCapacity;
+
+    /**
+     * @brief Steps at which the priority of the running thread is lowered (`depth - 1` in total).
+     *
+     * @note This is a dynamically allocated array managed by this `SCUnitSchedule`.
+     */
+    int64_t* changePoints;
+
+    /** @brief Number of steps taken so far during the current run. */
+    int64_t step;
+
+    /** @brief Index of the thread allowed to run or `-1` if no thread is allowed to run. */
+    int64_t current;
+
+    /** @brief Whether the current run is over, either because all threads finished or blocked. */
+    bool isOver;
+
+    /** @brief Whether all remaining threads were blocked during the current run. */
+    bool isDeadlocked;
+
+    /** @brief `SCUnitContext` passed to the threads during the current run. */
+    SCUnitContext* context;
+
+    /** @brief Mutex protecting the scheduling state of this `SCUnitSchedule`. */
+    pthread_mutex_t mutex;
+
+    /** @brief Condition variable signaled whenever the scheduling state changes. */
+    pthread_cond_t changed;
+
+};
+
+/** @brief Initial capacity for the threads of an `SCUnitSchedule`. */
+static constexpr int64_t INITIAL_CAPACITY = 4;
+
+/** @brief Growth factor used for resizing the threads of an `SCUnitSchedule`. */
+static constexpr int64_t GROWTH_FACTOR = 2;
+
+/** @brief Default depth of the PCT strategy. */
+static constexpr int64_t DEFAULT_DEPTH = 3;
+
+/** @brief Default estimated number of steps of a run. */
+static constexpr int64_t DEFAULT_STEPS = 1000;
+
+/** @brief Thread of an `SCUnitSchedule` the current thread is or a `nullptr` if there is none. */
+static thread_local SCUnitThread* currentThread;
+
+SCUnitSchedule* scunit_schedule_new(
+    SCUnitScheduleStrategy strategy,
+    uint64_t seed,
+    SCUnitError* error
+) {
+    *error = SCUNIT_ERROR_OUT_OF_MEMORY;
+    SCUnitSchedule* schedule = SCUNIT_MALLOC(sizeof(SCUnitSchedule));
+    if (schedule == nullptr) {
+        return nullptr;
+    }
+    *schedule = (SCUnitSchedule) {
+        .strategy = strategy,
+        .random = scunit_random_withSeed(seed),
+        .depth = DEFAULT_DEPTH,
+        .steps = DEFAULT_STEPS,
+        .current = -1
+    };
+    if (schedule->random == nullptr) {
+        goto randomAllocationFailed;
+    }
+    int result = pthread_mutex_init(&schedule->mutex, nullptr);
+    if (result != 0) {
+        goto mutexInitializationFailed;
+    }
+    result = pthread_cond_init(&schedule->changed, nullptr);
+    if (result != 0) {
+        goto conditionInitializationFailed;
+    }
+    *error = SCUNIT_ERROR_NONE;
+    return schedule;
+conditionInitializationFailed:
+    pthread_mutex_destroy(&schedule->mutex);
+mutexInitializationFailed:
+    *error = (result == ENOMEM)
+        ? SCUNIT_ERROR_OUT_OF_MEMORY
+        : SCUNIT_ERROR_INITIALIZING_SCHEDULE_FAILED;
+    scunit_random_free(schedule->random);
+randomAllocationFailed:
+    SCUNIT_FREE(schedule);
+    return nullptr;
+}
+
+uint64_t scunit_schedule_getSeed(const SCUnitSchedule* schedule) {
+    return scunit_random_getSeed(schedule->random);
+}
+
+SCUnitError scunit_schedule_setDepth(SCUnitSchedule* schedule, int64_t depth) {
+    if (depth < 1) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    schedule->depth = depth;
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitError scunit_schedule_setSteps(SCUnitSchedule* schedule, int64_t steps) {
+    if (steps < 1) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    schedule->steps = steps;
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitError scunit_schedule_addThread(
+    SCUnitSchedule* schedule,
+    SCUnitThreadFunction function,
+    void* argument
+) {
+    if (schedule->threadCount == schedule->threadCapacity) {
+        int64_t newCapacity = (schedule->threadCapacity > 0)
+            ? schedule->threadCapacity * GROWTH_FACTOR
+            : INITIAL_CAPACITY;
+        SCUnitThread* newThreads = SCUNIT_REALLOC(
+            schedule->threads,
+            newCapacity * sizeof(SCUnitThread)
+        );
+        if (newThreads == nullptr) {
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+        schedule->threads = newThreads;
+        schedule->threadCapacity = newCapacity;
+    }
+    schedule->threads[schedule->threadCount] = (SCUnitThread) {
+        .schedule = schedule,
+        .index = schedule->threadCount,
+        .function = function,
+        .argument = argument
+    };
+    schedule->threadCount++;
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Chooses the next thread to run for a given `SCUnitSchedule`.
+ *
+ * @attention This function is for internal purposes only and must be called with the mutex of
+ * the `SCUnitSchedule` held. Waiting threads still need to be signaled afterwards.
+ *
+ * @param[in, out] schedule `SCUnitSchedule` to choose the next thread for.
+ */
+static void chooseNextThread(SCUnitSchedule* schedule) {
+    schedule->step++;
+    if ((schedule->strategy == SCUNIT_SCHEDULE_STRATEGY_PCT) && (schedule->current >= 0)) {
+        // Lowering the priority of the running thread at a change point lets a different thread
+        // overtake it, which is exactly one ordering constraint. Later change points use lower
+        // priorities, so that the constraints are applied in order.
+        for (int64_t i = 0; i < schedule->depth - 1; i++) {
+            if (schedule->changePoints[i] == schedule->step) {
+                schedule->threads[schedule->current].priority = schedule->depth - 2 - i;
+            }
+        }
+    }
+    int64_t runnableThreads = 0;
+    int64_t chosen = -1;
+    for (int64_t i = 0; i < schedule->threadCount; i++) {
+        const SCUnitThread* thread = &schedule->threads[i];
+        if (thread->state != SCUNIT_THREAD_STATE_RUNNABLE) {
+            continue;
+        }
+        runnableThreads++;
+        if (schedule->strategy == SCUNIT_SCHEDULE_STRATEGY_PCT) {
+            if ((chosen < 0) || (thread->priority > schedule->threads[chosen].priority)) {
+                chosen = i;
+            }
+        }
+        // Reservoir sampling chooses a uniformly random runnable thread in a single pass.
+        else if (scunit_random_int64(schedule->random, 1, runnableThreads) == 1) {
+            chosen = i;
+        }
+    }
+    schedule->current = chosen;
+    if (chosen < 0) {
+        schedule->isOver = true;
+        for (int64_t i = 0; i < schedule->threadCount; i++) {
+            if (schedule->threads[i].state != SCUNIT_THREAD_STATE_FINISHED) {
+                schedule->isDeadlocked = true;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Waits until a given thread is allowed to run again.
+ *
+ * @note If the `SCUnitSchedule` deadlocked in the meantime, the thread is terminated using
+ * `pthread_exit()`, since it would never be allowed to run again.
+ *
+ * @attention This function is for internal purposes only and must be called with the mutex of
+ * the `SCUnitSchedule` held. The mutex is released before returning.
+ *
+ * @param[in, out] thread Thread to wait for.
+ */
+static void waitForTurn(SCUnitThread* thread) {
+    SCUnitSchedule* schedule = thread->schedule;
+    while ((schedule->current != thread->index) && !schedule->isDeadlocked) {
+        pthread_cond_wait(&schedule->changed, &schedule->mutex);
+    }
+    bool isDeadlocked = schedule->isDeadlocked;
+    pthread_mutex_unlock(&schedule->mutex);
+    if (isDeadlocked) {
+        pthread_exit(nullptr);
+    }
+}
+
+/**
+ * @brief Hands over control from the current thread to the next one and waits for its turn.
+ *
+ * @param[in, out] thread Current thread.
+ */
+static void switchThreads(SCUnitThread* thread) {
+    SCUnitSchedule* schedule = thread->schedule;
+    pthread_mutex_lock(&schedule->mutex);
+    chooseNextThread(schedule);
+    pthread_cond_broadcast(&schedule->changed);
+    waitForTurn(thread);
+}
+
+[[gnu::noinline]]
+void scunit_schedule_callThread(
+    SCUnitThreadFunction function,
+    SCUnitContext* context,
+    void* argument
+) {
+    function(context, argument);
+    // Keeps the call from becoming a tail call, which would remove this frame from backtraces.
+    scunit_clobberMemory();
+}
+
+/**
+ * @brief Entry point of every POSIX thread created by an `SCUnitSchedule`.
+ *
+ * @param[in, out] argument Thread to execute.
+ * @return Always a `nullptr`.
+ */
+static void* executeThread(void* argument) {
+    SCUnitThread* thread = argument;
+    SCUnitSchedule* schedule = thread->schedule;
+    currentThread = thread;
+    pthread_mutex_lock(&schedule->mutex);
+    waitForTurn(thread);
+    scunit_schedule_callThread(thread->function, schedule->context, thread->argument);
+    pthread_mutex_lock(&schedule->mutex);
+    thread->state = SCUNIT_THREAD_STATE_FINISHED;
+    chooseNextThread(schedule);
+    pthread_cond_broadcast(&schedule->changed);
+    pthread_mutex_unlock(&schedule->mutex);
+    return nullptr;
+}
+
+SCUnitError scunit_schedule_run(SCUnitSchedule* schedule, SCUnitContext* context) {
+    // Reseeding makes every run of the same schedule replay the same interleaving.
+    scunit_random_setSeed(schedule->random, scunit_random_getSeed(schedule->random));
+    int64_t changePointCount = schedule->depth - 1;
+    if (changePointCount > 0) {
+        int64_t* newChangePoints = SCUNIT_REALLOC(
+            schedule->changePoints,
+            changePointCount * sizeof(int64_t)
+        );
+        if (newChangePoints == nullptr) {
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+        schedule->changePoints = newChangePoints;
+        for (int64_t i = 0; i < changePointCount; i++) {
+            schedule->changePoints[i] = scunit_random_int64(schedule->random, 1, schedule->steps);
+        }
+    }
+    // Initial priorities are a random permutation of the values above all change point priorities.
+    for (int64_t i = 0; i < schedule->threadCount; i++) {
+        SCUnitThread* thread = &schedule->threads[i];
+        thread->state = SCUNIT_THREAD_STATE_RUNNABLE;
+        thread->blockedOn = nullptr;
+        thread->priority = changePointCount + i;
+    }
+    for (int64_t i = schedule->threadCount - 1; i > 0; i--) {
+        int64_t j = scunit_random_int64(schedule->random, 0, i);
+        int64_t priority = schedule->threads[i].priority;
+        schedule->threads[i].priority = schedule->threads[j].priority;
+        schedule->threads[j].priority = priority;
+    }
+    schedule->step = 0;
+    schedule->current = -1;
+    schedule->isOver = false;
+    schedule->isDeadlocked = false;
+    schedule->context = context;
+    SCUnitResult previousResult = scunit_context_getResult(context);
+    SCUnitError error = SCUNIT_ERROR_NONE;
+    int64_t createdThreads = 0;
+    for (; createdThreads < schedule->threadCount; createdThreads++) {
+        SCUnitThread* thread = &schedule->threads[createdThreads];
+        if (pthread_create(&thread->handle, nullptr, executeThread, thread) != 0) {
+            error = SCUNIT_ERROR_CREATING_THREAD_FAILED;
+            break;
+        }
+    }
+    pthread_mutex_lock(&schedule->mutex);
+    if (error != SCUNIT_ERROR_NONE) {
+        // Threads that were already created are waiting for their first turn, which they only get
+        // if the run is aborted as if it deadlocked.
+        schedule->isOver = true;
+        schedule->isDeadlocked = true;
+    }
+    else {
+        chooseNextThread(schedule);
+    }
+    pthread_cond_broadcast(&schedule->changed);
+    while (!schedule->isOver) {
+        pthread_cond_wait(&schedule->changed, &schedule->mutex);
+    }
+    bool isDeadlocked = schedule->isDeadlocked;
+    pthread_mutex_unlock(&schedule->mutex);
+    for (int64_t i = 0; i < createdThreads; i++) {
+        pthread_join(schedule->threads[i].handle, nullptr);
+    }
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    if (isDeadlocked) {
+        error = scunit_context_appendMessage(
+            context,
+            "\n  Deadlock detected, all remaining threads were blocked (schedule seed %" PRIu64
+                ").\n\n",
+            scunit_schedule_getSeed(schedule)
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        error = scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+        return (error != SCUNIT_ERROR_NONE) ? error : SCUNIT_ERROR_DEADLOCK_DETECTED;
+    }
+    if ((previousResult != SCUNIT_RESULT_FAIL)
+            && (scunit_context_getResult(context) == SCUNIT_RESULT_FAIL)) {
+        return scunit_context_appendMessage(
+            context,
+            "  Failed in schedule seed %" PRIu64 ".\n\n",
+            scunit_schedule_getSeed(schedule)
+        );
+    }
+    return SCUNIT_ERROR_NONE;
+}
+
+void scunit_schedule_free(SCUnitSchedule* schedule) {
+    if (schedule != nullptr) {
+        pthread_cond_destroy(&schedule->changed);
+        pthread_mutex_destroy(&schedule->mutex);
+        scunit_random_free(schedule->random);
+        SCUNIT_FREE(schedule->changePoints);
+        SCUNIT_FREE(schedule->threads);
+        SCUNIT_FREE(schedule);
+    }
+}
+
+void scunit_yield() {
+    SCUnitThread* thread = currentThread;
+    if (thread != nullptr) {
+        switchThreads(thread);
+    }
+}
+
+void scunit_mutex_lock(SCUnitMutex* mutex) {
+    SCUnitThread* thread = currentThread;
+    if (thread == nullptr) {
+        while (atomic_exchange(&mutex->isLocked, true)) {
+            sched_yield();
+        }
+        return;
+    }
+    // Locking is a scheduling point of its own, so that other threads may acquire the mutex first.
+    switchThreads(thread);
+    while (atomic_exchange(&mutex->isLocked, true)) {
+        pthread_mutex_lock(&thread->schedule->mutex);
+        thread->state = SCUNIT_THREAD_STATE_BLOCKED;
+        thread->blockedOn = mutex;
+        pthread_mutex_unlock(&thread->schedule->mutex);
+        switchThreads(thread);
+    }
+}
+
+void scunit_mutex_unlock(SCUnitMutex* mutex) {
+    atomic_store(&mutex->isLocked, false);
+    SCUnitThread* thread = currentThread;
+    if (thread == nullptr) {
+        return;
+    }
+    SCUnitSchedule* schedule = thread->schedule;
+    pthread_mutex_lock(&schedule->mutex);
+    for (int64_t i = 0; i < schedule->threadCount; i++) {
+        SCUnitThread* other = &schedule->threads[i];
+        if ((other->state == SCUNIT_THREAD_STATE_BLOCKED) && (other->blockedOn == mutex)) {
+            other->state = SCUNIT_THREAD_STATE_RUNNABLE;
+            other->blockedOn = nullptr;
+        }
+    }
+    pthread_mutex_unlock(&schedule->mutex);
+    switchThreads(thread);
+}
\ No newline at end of file
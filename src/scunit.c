@@ -1,8 +1,15 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <errno.h>
+#include <fnmatch.h>
 #include <getopt.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 #include <SCUnit/scunit.h>
 
 /** @brief Represents a structure containing the configuration settings of SCUnit. */
@@ -14,17 +21,117 @@ typedef struct SCUnitConfig {
     /** @brief Current order in which suites and tests are executed. */
     SCUnitOrder order;
 
+    /**
+     * @brief Current filter used to select the tests to execute.
+     *
+     * @note This is a dynamically allocated string or a `nullptr` if no filter was set, in which
+     * case all tests are selected.
+     */
+    char* filter;
+
+    /**
+     * @brief Copy of the current filter, split into a suite and test pattern.
+     *
+     * @note This is a dynamically allocated string or a `nullptr` if no filter was set.
+     * `suitePattern` and `testPattern` point into this buffer (or to a static string).
+     */
+    char* patterns;
+
+    /** @brief Shell wildcard pattern matched against the names of suites. */
+    const char* suitePattern;
+
+    /** @brief Shell wildcard pattern matched against the names of tests. */
+    const char* testPattern;
+
+    /**
+     * @brief File descriptor to write a machine-readable summary to after executing the suites,
+     * or a negative value if no such summary should be written.
+     */
+    int resultFd;
+
+    /** @brief Whether crashing tests are caught and recovered from instead of ending the run. */
+    bool catchSignals;
+
+    /** @brief Whether file descriptors and threads leaked by tests are detected. */
+    bool detectLeaks;
+
+    /**
+     * @brief Root directory the temporary directories of tests are created in.
+     *
+     * @note This is a dynamically allocated string or a `nullptr` if no root directory was set, in
+     * which case `$TMPDIR` (or `/tmp` if it is not set) is used.
+     */
+    char* temporaryDirectoryRoot;
+
+    /** @brief Whether the temporary directories of failed tests are kept for debugging. */
+    bool keepTemporaryOnFailure;
+
+    /**
+     * @brief Directory relative paths of test data files are resolved against.
+     *
+     * @note This is a dynamically allocated string or a `nullptr` if no data directory was set, in
+     * which case the current working directory is used.
+     */
+    char* dataDirectory;
+
+    /** @brief Minimum time the timed loop of a benchmark runs for per input size (in ns). */
+    int64_t benchmarkMinTime;
+
+    /** @brief Format the results of benchmarks are reported in. */
+    SCUnitBenchmarkFormat benchmarkFormat;
+
+    /**
+     * @brief Paths of the two builds of a library compared by benchmarks.
+     *
+     * @note These are dynamically allocated strings or `nullptr`s if no libraries are compared.
+     */
+    char* benchmarkLibraries[2];
+
+    /** @brief Number of times a failed test is executed again before it is considered failed. */
+    int64_t retries;
+
+    /**
+     * @brief Path of the file the outcomes of tests are recorded in to track their flip rates.
+     *
+     * @note This is a dynamically allocated string or a `nullptr` if no history is recorded.
+     */
+    char* flakyHistoryFile;
+
+    /**
+     * @brief Path of the file listing the quarantined tests.
+     *
+     * @note This is a dynamically allocated string or a `nullptr` if no tests are quarantined.
+     */
+    char* quarantineFile;
+
 } SCUnitConfig;
 
 /** @brief Represents a long command line option. */
 typedef struct option SCUnitLongOption;
 
+/** @brief Represents an enumeration of the formats suites and tests can be listed in. */
+typedef enum SCUnitListFormat {
+
+    /** @brief Indicates that suites and tests are not listed. */
+    SCUNIT_LIST_FORMAT_NONE,
+
+    /** @brief Indicates that tests are listed one per line, together with their source location. */
+    SCUNIT_LIST_FORMAT_TEXT,
+
+    /** @brief Indicates that suites and tests are listed as a single JSON object. */
+    SCUNIT_LIST_FORMAT_JSON
+
+} SCUnitListFormat;
+
 /** @brief Version information of SCUnit. */
 static constexpr SCUnitVersion VERSION = { .major = 0, .minor = 3, .patch = 0 };
 
 /** @brief Growth factor used for resizing the array of suites. */
 static constexpr int64_t GROWTH_FACTOR = 2;
 
+/** @brief Number of nanoseconds per second. */
+static constexpr int64_t NANOSECONDS_PER_SECOND = 1'000'000'000;
+
 /**
  * @brief Supported short command line options.
  *
@@ -43,13 +150,46 @@ static const SCUnitLongOption LONG_OPTIONS[] = {
     { "color", required_argument, nullptr, 0 },
     { "order", required_argument, nullptr, 0 },
     { "seed", required_argument, nullptr, 0 },
+    { "filter", required_argument, nullptr, 0 },
+    { "list-tests", optional_argument, nullptr, 0 },
+    { "result-fd", required_argument, nullptr, 0 },
+    { "catch-signals", no_argument, nullptr, 0 },
+    { "detect-leaks", no_argument, nullptr, 0 },
+    { "temp-dir", required_argument, nullptr, 0 },
+    { "keep-temp-on-failure", no_argument, nullptr, 0 },
+    { "data-dir", required_argument, nullptr, 0 },
+    { "limit-as", required_argument, nullptr, 0 },
+    { "limit-cpu", required_argument, nullptr, 0 },
+    { "limit-fds", required_argument, nullptr, 0 },
+    { "benchmark-min-time", required_argument, nullptr, 0 },
+    { "benchmark-format", required_argument, nullptr, 0 },
+    { "ab", required_argument, nullptr, 0 },
+    { "retries", required_argument, nullptr, 0 },
+    { "flaky-history", required_argument, nullptr, 0 },
+    { "quarantine", required_argument, nullptr, 0 },
     { nullptr, no_argument, nullptr, 0 }
 };
 
 /** @brief SCUnit configuration settings. */
 static SCUnitConfig config = {
     .coloredOutput = SCUNIT_COLORED_OUTPUT_ALWAYS,
-    .order = SCUNIT_ORDER_SEQUENTIAL
+    .order = SCUNIT_ORDER_SEQUENTIAL,
+    .filter = nullptr,
+    .patterns = nullptr,
+    .suitePattern = "*",
+    .testPattern = "*",
+    .resultFd = -1,
+    .catchSignals = false,
+    .detectLeaks = false,
+    .temporaryDirectoryRoot = nullptr,
+    .keepTemporaryOnFailure = false,
+    .dataDirectory = nullptr,
+    .benchmarkMinTime = 100'000'000,
+    .benchmarkFormat = SCUNIT_BENCHMARK_FORMAT_TEXT,
+    .benchmarkLibraries = { nullptr, nullptr },
+    .retries = 0,
+    .flakyHistoryFile = nullptr,
+    .quarantineFile = nullptr
 };
 
 /**
@@ -108,6 +248,22 @@ SCUnitError scunit_setColoredOutput(SCUnitColoredOutput coloredOutput) {
     return SCUNIT_ERROR_NONE;
 }
 
+bool scunit_getCatchSignals() {
+    return config.catchSignals;
+}
+
+void scunit_setCatchSignals(bool catchSignals) {
+    config.catchSignals = catchSignals;
+}
+
+bool scunit_getDetectLeaks() {
+    return config.detectLeaks;
+}
+
+void scunit_setDetectLeaks(bool detectLeaks) {
+    config.detectLeaks = detectLeaks;
+}
+
 SCUnitOrder scunit_getOrder() {
     return config.order;
 }
@@ -120,6 +276,291 @@ SCUnitError scunit_setOrder(SCUnitOrder order) {
     return SCUNIT_ERROR_NONE;
 }
 
+const char* scunit_getFilter() {
+    return (config.filter != nullptr) ? config.filter : "*";
+}
+
+SCUnitError scunit_setFilter(const char* filter) {
+    char* newFilter = strdup(filter);
+    if (newFilter == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    char* newPatterns = strdup(filter);
+    if (newPatterns == nullptr) {
+        SCUNIT_FREE(newFilter);
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    SCUNIT_FREE(config.filter);
+    SCUNIT_FREE(config.patterns);
+    config.filter = newFilter;
+    config.patterns = newPatterns;
+    // Names of suites never contain a '.' when defined using the macros, so we simply split the
+    // filter at the first one.
+    char* separator = strchr(newPatterns, '.');
+    if (separator != nullptr) {
+        *separator = '\0';
+    }
+    config.suitePattern = newPatterns;
+    config.testPattern = (separator != nullptr) ? separator + 1 : "*";
+    return SCUNIT_ERROR_NONE;
+}
+
+const char* scunit_getTemporaryDirectoryRoot() {
+    if (config.temporaryDirectoryRoot != nullptr) {
+        return config.temporaryDirectoryRoot;
+    }
+    const char* root = getenv("TMPDIR");
+    return ((root != nullptr) && (*root != '\0')) ? root : "/tmp";
+}
+
+SCUnitError scunit_setTemporaryDirectoryRoot(const char* root) {
+    char* newRoot = strdup(root);
+    if (newRoot == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    SCUNIT_FREE(config.temporaryDirectoryRoot);
+    config.temporaryDirectoryRoot = newRoot;
+    return SCUNIT_ERROR_NONE;
+}
+
+bool scunit_getKeepTemporaryOnFailure() {
+    return config.keepTemporaryOnFailure;
+}
+
+void scunit_setKeepTemporaryOnFailure(bool keepTemporaryOnFailure) {
+    config.keepTemporaryOnFailure = keepTemporaryOnFailure;
+}
+
+int64_t scunit_getBenchmarkMinTime() {
+    return config.benchmarkMinTime;
+}
+
+SCUnitError scunit_setBenchmarkMinTime(int64_t minTime) {
+    if (minTime <= 0) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    config.benchmarkMinTime = minTime;
+    return SCUNIT_ERROR_NONE;
+}
+
+SCUnitBenchmarkFormat scunit_getBenchmarkFormat() {
+    return config.benchmarkFormat;
+}
+
+SCUnitError scunit_setBenchmarkFormat(SCUnitBenchmarkFormat format) {
+    if ((format < SCUNIT_BENCHMARK_FORMAT_TEXT) || (format > SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON)) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    config.benchmarkFormat = format;
+    return SCUNIT_ERROR_NONE;
+}
+
+const char* scunit_getBenchmarkLibrary(int64_t index) {
+    return ((index >= 0) && (index < 2)) ? config.benchmarkLibraries[index] : nullptr;
+}
+
+SCUnitError scunit_setBenchmarkLibraries(const char* first, const char* second) {
+    if ((first == nullptr) != (second == nullptr)) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    char* newFirst = nullptr;
+    char* newSecond = nullptr;
+    if (first != nullptr) {
+        newFirst = strdup(first);
+        newSecond = strdup(second);
+        if ((newFirst == nullptr) || (newSecond == nullptr)) {
+            SCUNIT_FREE(newFirst);
+            SCUNIT_FREE(newSecond);
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    SCUNIT_FREE(config.benchmarkLibraries[0]);
+    SCUNIT_FREE(config.benchmarkLibraries[1]);
+    config.benchmarkLibraries[0] = newFirst;
+    config.benchmarkLibraries[1] = newSecond;
+    return SCUNIT_ERROR_NONE;
+}
+
+const char* scunit_getDataDirectory() {
+    return (config.dataDirectory != nullptr) ? config.dataDirectory : ".";
+}
+
+SCUnitError scunit_setDataDirectory(const char* directory) {
+    char* newDirectory = strdup(directory);
+    if (newDirectory == nullptr) {
+        return SCUNIT_ERROR_OUT_OF_MEMORY;
+    }
+    SCUNIT_FREE(config.dataDirectory);
+    config.dataDirectory = newDirectory;
+    return SCUNIT_ERROR_NONE;
+}
+
+int64_t scunit_getRetries() {
+    return config.retries;
+}
+
+SCUnitError scunit_setRetries(int64_t retries) {
+    if (retries < 0) {
+        return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    }
+    config.retries = retries;
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Replaces a given dynamically allocated path with a copy of another one.
+ *
+ * @param[in, out] target Dynamically allocated path to replace (or a `nullptr`).
+ * @param[in]      path   A null-terminated string for the new path or a `nullptr`.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * otherwise `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError replacePath(char** target, const char* path) {
+    char* newPath = nullptr;
+    if (path != nullptr) {
+        newPath = strdup(path);
+        if (newPath == nullptr) {
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+    }
+    SCUNIT_FREE(*target);
+    *target = newPath;
+    return SCUNIT_ERROR_NONE;
+}
+
+const char* scunit_getFlakyHistoryFile() {
+    return config.flakyHistoryFile;
+}
+
+SCUnitError scunit_setFlakyHistoryFile(const char* path) {
+    return replacePath(&config.flakyHistoryFile, path);
+}
+
+const char* scunit_getQuarantineFile() {
+    return config.quarantineFile;
+}
+
+SCUnitError scunit_setQuarantineFile(const char* path) {
+    return replacePath(&config.quarantineFile, path);
+}
+
+bool scunit_isTestSelected(const char* suiteName, const char* testName) {
+    return (fnmatch(config.suitePattern, suiteName, 0) == 0)
+        && (fnmatch(config.testPattern, testName, 0) == 0);
+}
+
+/**
+ * @brief Determines if at least one test of a given `SCUnitSuite` is selected by the current
+ * filter.
+ *
+ * @param[in] suite `SCUnitSuite` to examine.
+ * @return `true` if at least one test of the given `SCUnitSuite` is selected, otherwise `false`.
+ */
+static bool isSuiteSelected(const SCUnitSuite* suite) {
+    const char* suiteName = scunit_suite_getName(suite);
+    if (fnmatch(config.suitePattern, suiteName, 0) != 0) {
+        return false;
+    }
+    int64_t testCount = scunit_suite_getTestCount(suite);
+    for (int64_t i = 0; i < testCount; i++) {
+        if (fnmatch(config.testPattern, scunit_suite_getTestName(suite, i), 0) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Writes a given string as a JSON string literal (including the quotes) to `stdout`.
+ *
+ * @param[in] string A null-terminated string to write.
+ */
+static void printJsonString(const char* string) {
+    putchar('"');
+    for (const unsigned char* c = (const unsigned char*) string; *c != '\0'; c++) {
+        if ((*c == '"') || (*c == '\\')) {
+            scunit_printf("\\%c", *c);
+        }
+        else if (*c < 0x20) {
+            scunit_printf("\\u%04x", *c);
+        }
+        else {
+            putchar(*c);
+        }
+    }
+    putchar('"');
+}
+
+/**
+ * @brief Lists all suites and tests selected by the current filter on `stdout`.
+ *
+ * @note Suites and tests are listed in the order they would be executed in sequentially, together
+ * with the source location of every test. Nothing is executed, not even any setup or teardown
+ * functions, so listing is cheap even for a large number of tests.
+ *
+ * In the text format, every test is listed on a separate line as `<suite>.<test>` followed by a
+ * tab and its source location (`<file>:<line>`, if known). The JSON format consists of a single
+ * object of the form `{"suites":[{"name":...,"tests":[{"name":...,"file":...,"line":...}]}]}`,
+ * where `file` and `line` are omitted if unknown.
+ *
+ * @param[in] format `SCUnitListFormat` to list the suites and tests in.
+ */
+static void listTests(SCUnitListFormat format) {
+    bool json = format == SCUNIT_LIST_FORMAT_JSON;
+    if (json) {
+        fputs("{\"suites\":[", stdout);
+    }
+    bool firstSuite = true;
+    for (int64_t i = registeredSuites - 1; i >= 0; i--) {
+        const SCUnitSuite* suite = suites[i];
+        const char* suiteName = scunit_suite_getName(suite);
+        if (!isSuiteSelected(suite)) {
+            continue;
+        }
+        if (json) {
+            fputs(firstSuite ? "{\"name\":" : ",{\"name\":", stdout);
+            printJsonString(suiteName);
+            fputs(",\"tests\":[", stdout);
+        }
+        bool firstTest = true;
+        for (int64_t j = scunit_suite_getTestCount(suite) - 1; j >= 0; j--) {
+            const char* testName = scunit_suite_getTestName(suite, j);
+            // The suite is already known to be selected, so only the test pattern is left to check.
+            if (fnmatch(config.testPattern, testName, 0) != 0) {
+                continue;
+            }
+            const char* file = scunit_suite_getTestFile(suite, j);
+            int64_t line = scunit_suite_getTestLine(suite, j);
+            if (json) {
+                fputs(firstTest ? "{\"name\":" : ",{\"name\":", stdout);
+                printJsonString(testName);
+                if (file != nullptr) {
+                    fputs(",\"file\":", stdout);
+                    printJsonString(file);
+                }
+                if (line > 0) {
+                    printf(",\"line\":%" PRId64, line);
+                }
+                putchar('}');
+            }
+            else if (file != nullptr) {
+                printf("%s.%s\t%s:%" PRId64 "\n", suiteName, testName, file, line);
+            }
+            else {
+                printf("%s.%s\n", suiteName, testName);
+            }
+            firstTest = false;
+        }
+        if (json) {
+            fputs("]}", stdout);
+        }
+        firstSuite = false;
+    }
+    if (json) {
+        fputs("]}\n", stdout);
+    }
+}
+
 SCUnitError scunit_registerSuite(SCUnitSuite* suite) {
     if (registeredSuites >= capacity) {
         int64_t newCapacity = (capacity == 0) ? 1 : capacity * GROWTH_FACTOR;
@@ -134,9 +575,31 @@ SCUnitError scunit_registerSuite(SCUnitSuite* suite) {
     return SCUNIT_ERROR_NONE;
 }
 
+SCUnitError scunit_unregisterSuite(const SCUnitSuite* suite) {
+    for (int64_t i = 0; i < registeredSuites; i++) {
+        if (suites[i] == suite) {
+            memmove(&suites[i], &suites[i + 1], (registeredSuites - 1 - i) * sizeof(SCUnitSuite*));
+            registeredSuites--;
+            return SCUNIT_ERROR_NONE;
+        }
+    }
+    return SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+}
+
+int64_t scunit_getSuiteCount() {
+    return registeredSuites;
+}
+
+SCUnitSuite* scunit_getSuite(int64_t index) {
+    return ((index >= 0) && (index < registeredSuites)) ? suites[index] : nullptr;
+}
+
 void scunit_parseArguments(int argc, char** argv) {
     // Disable error messages of `getopt_long()`.
     opterr = 0;
+    // Listing is deferred until all options are parsed, so that the filter is respected regardless
+    // of the order of the options.
+    SCUnitListFormat listFormat = SCUNIT_LIST_FORMAT_NONE;
     int option;
     int optionIndex;
     while ((option = getopt_long(argc, argv, SHORT_OPTIONS, LONG_OPTIONS, &optionIndex)) != -1) {
@@ -155,7 +618,58 @@ void scunit_parseArguments(int argc, char** argv) {
                     "                               Parsed as a uint64_t in octal, hexadecimal or "
                     "decimal notation.\n"
                     "                               Only has an effect if '--order=random' is "
-                    "specified.\n",
+                    "specified.\n"
+                    "  --filter=<suite>[.<test>]    Only execute the tests matching the given "
+                    "wildcard patterns.\n"
+                    "  --list-tests[={text|json}]   List the selected tests and their source "
+                    "locations without\n"
+                    "                               executing them and exit (default = text).\n"
+                    "  --result-fd=<fd>             Write a machine-readable summary to the given "
+                    "file descriptor\n"
+                    "                               instead of printing the regular one.\n"
+                    "  --catch-signals              Recover from tests crashing with a signal and "
+                    "continue with\n"
+                    "                               the next test instead of ending the run.\n"
+                    "  --detect-leaks               Fail tests leaking file descriptors or "
+                    "threads.\n"
+                    "  --temp-dir=<path>            Create the temporary directories of tests "
+                    "in the given\n"
+                    "                               directory (e. g. '/dev/shm' for a tmpfs).\n"
+                    "  --keep-temp-on-failure       Keep the temporary directories of failed tests "
+                    "for debugging.\n"
+                    "  --data-dir=<path>            Resolve relative paths of test data files "
+                    "against the given\n"
+                    "                               directory (default = current directory).\n"
+                    "  --limit-as=<size>[K|M|G]     Limit the address space of the process during "
+                    "each test.\n"
+                    "  --limit-cpu=<seconds>        Limit the CPU time consumed by each test.\n"
+                    "  --limit-fds=<count>          Limit the number of file descriptors open "
+                    "during each test.\n"
+                    "  --benchmark-min-time=<seconds>\n"
+                    "                               Run the timed loop of each benchmark for at "
+                    "least the given\n"
+                    "                               time per input size (default = 0.1).\n"
+                    "  --benchmark-format={text|gbench-json}\n"
+                    "                               Also write the results of benchmarks to stdout "
+                    "as Google\n"
+                    "                               Benchmark JSON, moving all other output to "
+                    "stderr\n"
+                    "                               (default = text).\n"
+                    "  --ab=<first>,<second>        Compare two builds of a library in every "
+                    "benchmark, executing\n"
+                    "                               its body with each one in a random interleaved "
+                    "order.\n"
+                    "  --retries=<count>            Execute a failed test again up to the given "
+                    "number of times and\n"
+                    "                               report it as flaky if it passes "
+                    "(default = 0).\n"
+                    "  --flaky-history=<file>       Record the outcomes of tests in the given file "
+                    "to track how\n"
+                    "                               often they flip between passing and failing.\n"
+                    "  --quarantine=<file>          Do not fail the run because of the tests "
+                    "matching the patterns\n"
+                    "                               (one '<suite>[.<test>]' per line) in the given "
+                    "file.\n",
                     argv[0]
                 );
                 exit(EXIT_SUCCESS);
@@ -221,141 +735,319 @@ void scunit_parseArguments(int argc, char** argv) {
                     }
                     scunit_random_setSeed(random, seed);
                 }
-                break;
-            case 1:
-                scunit_fprintf(
-                    stderr,
-                    "Unexpected argument '%s'.\n"
-                    "Try option '-h' or '--help' for more information.\n",
-                    optarg
-                );
-                exit(EXIT_FAILURE);
-            case ':':
-                scunit_fprintf(
-                    stderr,
-                    "Missing argument for option '%s'.\n"
-                    "Try option '-h' or '--help' for more information.\n",
-                    argv[optind - 1]
-                );
-                exit(EXIT_FAILURE);
-            case '?':
-                scunit_fprintf(stderr, "Unknown option '");
-                if (optopt == 0) {
-                    scunit_fprintf(stderr, "%s", argv[optind - 1]);
+                else if (strcmp(optionName, "filter") == 0) {
+                    SCUnitError error = scunit_setFilter(optarg);
+                    if (error != SCUNIT_ERROR_NONE) {
+                        scunit_fprintfc(
+                            stderr,
+                            SCUNIT_COLOR_DARK_RED,
+                            SCUNIT_COLOR_DARK_DEFAULT,
+                            "An unexpected error occurred while setting the filter (code %d).\n",
+                            error
+                        );
+                        exit(EXIT_FAILURE);
+                    }
                 }
-                else {
-                    scunit_fprintf(stderr, "-%c", optopt);
+                else if (strcmp(optionName, "list-tests") == 0) {
+                    if ((optarg == nullptr) || (strcmp(optarg, "text") == 0)) {
+                        listFormat = SCUNIT_LIST_FORMAT_TEXT;
+                    }
+                    else if (strcmp(optarg, "json") == 0) {
+                        listFormat = SCUNIT_LIST_FORMAT_JSON;
+                    }
+                    else {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
                 }
-                scunit_fprintf(
-                    stderr,
-                    "'.\n"
-                    "Try option '-h' or '--help' for more information.\n"
-                );
-                exit(EXIT_FAILURE);
-        }
-    }
-}
-
-int scunit_executeSuites() {
-    int exitCode = EXIT_SUCCESS;
-    // Suites can be executed in a sequential or random order. This means that we may need to
-    // shuffle the indices of the suites. If no suites are registered, `suiteIndices` is a `nullptr`
-    // since allocating an array of size zero results in implementation-defined behavior (which we
-    // try to avoid).
-    int64_t* suiteIndices = nullptr;
-    if (registeredSuites > 0) {
-        suiteIndices = SCUNIT_MALLOC(registeredSuites * sizeof(int64_t));
-        if (suiteIndices == nullptr) {
-            scunit_fprintfc(
-                stderr,
-                SCUNIT_COLOR_DARK_RED,
-                SCUNIT_COLOR_DARK_DEFAULT,
-                "An unexpected error occurred while preparing the execution of the suites "
-                "(code %d).\n",
-                SCUNIT_ERROR_OUT_OF_MEMORY
-            );
-            exitCode = EXIT_FAILURE;
-            goto suiteIndicesAllocationFailed;
-        }
-    }
-    // We initialize the indices of the suites in the order they were registered using
-    // `[[gnu::constructor]]`, which is apparently in reversed order.
-    for (int64_t i = 0; i < registeredSuites; i++) {
-        suiteIndices[i] = registeredSuites - 1 - i;
-    }
-    if (config.order == SCUNIT_ORDER_RANDOM) {
-        for (int64_t i = registeredSuites - 1; i > 0; i--) {
-            int64_t j = scunit_random_int64(random, 0, i);
-            int64_t temp = suiteIndices[i];
-            suiteIndices[i] = suiteIndices[j];
-            suiteIndices[j] = temp;
-        }
-    }
-    int64_t failedSuites = 0;
-    SCUnitSummary summary = { };
-    SCUnitTimer* timer = scunit_timer_new();
-    if (timer == nullptr) {
-        scunit_fprintfc(
-            stderr,
-            SCUNIT_COLOR_DARK_RED,
-            SCUNIT_COLOR_DARK_DEFAULT,
-            "An unexpected error occurred while preparing the execution of the suites (code %d).\n",
-            SCUNIT_ERROR_OUT_OF_MEMORY
-        );
-        exitCode = EXIT_FAILURE;
-        goto timerAllocationFailed;
-    }
-    SCUnitError error = scunit_timer_start(timer);
-    if (error != SCUNIT_ERROR_NONE) {
-        scunit_fprintfc(
-            stderr,
-            SCUNIT_COLOR_DARK_RED,
-            SCUNIT_COLOR_DARK_DEFAULT,
-            "An unexpected error occurred while executing the suites (code %d).\n",
-            error
-        );
-        exitCode = EXIT_FAILURE;
-        goto failed;
-    }
-    for (int64_t i = 0; i < registeredSuites; i++) {
-        const SCUnitSuite* suite = suites[suiteIndices[i]];
-        SCUnitSummary suiteSummary;
-        error = scunit_suite_execute(suite, &suiteSummary);
-        if (error != SCUNIT_ERROR_NONE) {
-            scunit_fprintfc(
-                stderr,
-                SCUNIT_COLOR_DARK_RED,
-                SCUNIT_COLOR_DARK_DEFAULT,
-                "An unexpected error occurred while executing the suite %s (code %d).\n",
-                scunit_suite_getName(suite),
-                error
-            );
-            exitCode = EXIT_FAILURE;
-            goto failed;
-        }
-        if (suiteSummary.failedTests > 0) {
-            failedSuites++;
+                else if (strcmp(optionName, "result-fd") == 0) {
+                    char* end = nullptr;
+                    errno = 0;
+                    long resultFd = strtol(optarg, &end, 10);
+                    if ((*optarg == '\0') || (*end != '\0') || (errno == ERANGE) || (resultFd < 0)
+                            || (resultFd > INT_MAX)) {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                    config.resultFd = (int) resultFd;
+                    // The output is usually captured by an orchestrator through a single pipe for
+                    // both `stdout` and `stderr`, so it must not be reordered (or lost on a crash)
+                    // by buffering.
+                    setvbuf(stdout, nullptr, _IONBF, 0);
+                }
+                else if (strcmp(optionName, "catch-signals") == 0) {
+                    config.catchSignals = true;
+                }
+                else if (strcmp(optionName, "detect-leaks") == 0) {
+                    config.detectLeaks = true;
+                }
+                else if (strcmp(optionName, "temp-dir") == 0) {
+                    SCUnitError error = scunit_setTemporaryDirectoryRoot(optarg);
+                    if (error != SCUNIT_ERROR_NONE) {
+                        scunit_fprintfc(
+                            stderr,
+                            SCUNIT_COLOR_DARK_RED,
+                            SCUNIT_COLOR_DARK_DEFAULT,
+                            "An unexpected error occurred while setting the root directory for "
+                                "temporary directories (code %d).\n",
+                            error
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                else if (strcmp(optionName, "keep-temp-on-failure") == 0) {
+                    config.keepTemporaryOnFailure = true;
+                }
+                else if (strcmp(optionName, "data-dir") == 0) {
+                    SCUnitError error = scunit_setDataDirectory(optarg);
+                    if (error != SCUNIT_ERROR_NONE) {
+                        scunit_fprintfc(
+                            stderr,
+                            SCUNIT_COLOR_DARK_RED,
+                            SCUNIT_COLOR_DARK_DEFAULT,
+                            "An unexpected error occurred while setting the data directory "
+                                "(code %d).\n",
+                            error
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                else if (strcmp(optionName, "limit-as") == 0) {
+                    char* end = nullptr;
+                    errno = 0;
+                    unsigned long long size = strtoull(optarg, &end, 10);
+                    int32_t shift = 0;
+                    switch (*end) {
+                        case 'K':
+                            shift = 10;
+                            end++;
+                            break;
+                        case 'M':
+                            shift = 20;
+                            end++;
+                            break;
+                        case 'G':
+                            shift = 30;
+                            end++;
+                            break;
+                    }
+                    if (!isdigit((unsigned char) *optarg) || (*end != '\0') || (errno == ERANGE)
+                            || (size == 0) || (size > (((uint64_t) INT64_MAX) >> shift))) {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                    scunit_limit_set(SCUNIT_LIMIT_ADDRESS_SPACE, (int64_t) (size << shift));
+                }
+                else if (strcmp(optionName, "limit-cpu") == 0) {
+                    char* end = nullptr;
+                    errno = 0;
+                    double seconds = strtod(optarg, &end);
+                    if ((*optarg == '\0') || (*end != '\0') || (errno == ERANGE) || !(seconds > 0.0)
+                            || (seconds > ((double) INT64_MAX) / NANOSECONDS_PER_SECOND)) {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                    scunit_limit_set(
+                        SCUNIT_LIMIT_CPU_TIME,
+                        (int64_t) (seconds * NANOSECONDS_PER_SECOND)
+                    );
+                }
+                else if (strcmp(optionName, "limit-fds") == 0) {
+                    char* end = nullptr;
+                    errno = 0;
+                    long count = strtol(optarg, &end, 10);
+                    if ((*optarg == '\0') || (*end != '\0') || (errno == ERANGE) || (count <= 0)) {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                    scunit_limit_set(SCUNIT_LIMIT_FILE_DESCRIPTORS, count);
+                }
+                else if (strcmp(optionName, "benchmark-min-time") == 0) {
+                    char* end = nullptr;
+                    errno = 0;
+                    double seconds = strtod(optarg, &end);
+                    if ((*optarg == '\0') || (*end != '\0') || (errno == ERANGE) || !(seconds > 0.0)
+                            || (seconds > ((double) INT64_MAX) / NANOSECONDS_PER_SECOND)
+                            || (scunit_setBenchmarkMinTime(
+                                (int64_t) (seconds * NANOSECONDS_PER_SECOND)
+                            ) != SCUNIT_ERROR_NONE)) {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                else if (strcmp(optionName, "benchmark-format") == 0) {
+                    if (strcmp(optarg, "text") == 0) {
+                        config.benchmarkFormat = SCUNIT_BENCHMARK_FORMAT_TEXT;
+                    }
+                    else if (strcmp(optarg, "gbench-json") == 0) {
+                        config.benchmarkFormat = SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON;
+                    }
+                    else {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                else if (strcmp(optionName, "ab") == 0) {
+                    char* separator = strchr(optarg, ',');
+                    if ((separator == nullptr) || (separator == optarg) || (separator[1] == '\0')
+                            || (strchr(separator + 1, ',') != nullptr)) {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                    *separator = '\0';
+                    SCUnitError error = scunit_setBenchmarkLibraries(optarg, separator + 1);
+                    *separator = ',';
+                    if (error != SCUNIT_ERROR_NONE) {
+                        scunit_fprintfc(
+                            stderr,
+                            SCUNIT_COLOR_DARK_RED,
+                            SCUNIT_COLOR_DARK_DEFAULT,
+                            "An unexpected error occurred while setting the libraries to compare "
+                                "(code %d).\n",
+                            error
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                else if (strcmp(optionName, "retries") == 0) {
+                    char* end = nullptr;
+                    errno = 0;
+                    long long retries = strtoll(optarg, &end, 10);
+                    if (!isdigit((unsigned char) *optarg) || (*end != '\0') || (errno == ERANGE)
+                            || (scunit_setRetries(retries) != SCUNIT_ERROR_NONE)) {
+                        scunit_fprintf(
+                            stderr,
+                            "Invalid argument '%s' for option '--%s'.\n"
+                            "Try option '-h' or '--help' for more information.\n",
+                            optarg,
+                            optionName
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                else if ((strcmp(optionName, "flaky-history") == 0)
+                        || (strcmp(optionName, "quarantine") == 0)) {
+                    SCUnitError error = (strcmp(optionName, "quarantine") == 0)
+                        ? scunit_setQuarantineFile(optarg)
+                        : scunit_setFlakyHistoryFile(optarg);
+                    if (error != SCUNIT_ERROR_NONE) {
+                        scunit_fprintfc(
+                            stderr,
+                            SCUNIT_COLOR_DARK_RED,
+                            SCUNIT_COLOR_DARK_DEFAULT,
+                            "An unexpected error occurred while setting the file for option "
+                                "'--%s' (code %d).\n",
+                            optionName,
+                            error
+                        );
+                        exit(EXIT_FAILURE);
+                    }
+                }
+                break;
+            case 1:
+                scunit_fprintf(
+                    stderr,
+                    "Unexpected argument '%s'.\n"
+                    "Try option '-h' or '--help' for more information.\n",
+                    optarg
+                );
+                exit(EXIT_FAILURE);
+            case ':':
+                scunit_fprintf(
+                    stderr,
+                    "Missing argument for option '%s'.\n"
+                    "Try option '-h' or '--help' for more information.\n",
+                    argv[optind - 1]
+                );
+                exit(EXIT_FAILURE);
+            case '?':
+                scunit_fprintf(stderr, "Unknown option '");
+                if (optopt == 0) {
+                    scunit_fprintf(stderr, "%s", argv[optind - 1]);
+                }
+                else {
+                    scunit_fprintf(stderr, "-%c", optopt);
+                }
+                scunit_fprintf(
+                    stderr,
+                    "'.\n"
+                    "Try option '-h' or '--help' for more information.\n"
+                );
+                exit(EXIT_FAILURE);
         }
-        summary.passedTests += suiteSummary.passedTests;
-        summary.skippedTests += suiteSummary.skippedTests;
-        summary.failedTests += suiteSummary.failedTests;
     }
-    error = scunit_timer_stop(timer);
-    if (error != SCUNIT_ERROR_NONE) {
-        scunit_fprintfc(
-            stderr,
-            SCUNIT_COLOR_DARK_RED,
-            SCUNIT_COLOR_DARK_DEFAULT,
-            "An unexpected error occurred while executing the suites (code %d).\n",
-            error
-        );
-        exitCode = EXIT_FAILURE;
-        goto failed;
+    if (listFormat != SCUNIT_LIST_FORMAT_NONE) {
+        listTests(listFormat);
+        exit(EXIT_SUCCESS);
     }
+}
+
+/**
+ * @brief Prints the human-readable summary of executing the suites to `stdout`.
+ *
+ * @param[in] selectedSuites Number of executed suites.
+ * @param[in] failedSuites   Number of executed suites with at least one failed test.
+ * @param[in] summary        `SCUnitSummary` accumulated over all executed suites.
+ * @param[in] timer          Stopped `SCUnitTimer` that measured the execution of the suites.
+ */
+static void printSummary(
+    int64_t selectedSuites,
+    int64_t failedSuites,
+    SCUnitSummary summary,
+    const SCUnitTimer* timer
+) {
     scunit_printf("--- ");
     scunit_printfc(SCUNIT_COLOR_DARK_CYAN, SCUNIT_COLOR_DARK_DEFAULT, "Summary");
     scunit_printf(" ---\n\nSuites: ");
-    int64_t passedSuites = registeredSuites - failedSuites;
+    int64_t passedSuites = selectedSuites - failedSuites;
     scunit_printfc(
         (passedSuites > 0) ? SCUNIT_COLOR_DARK_GREEN : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
@@ -367,7 +1059,7 @@ int scunit_executeSuites() {
         (passedSuites > 0) ? SCUNIT_COLOR_DARK_GREEN : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
         "%.2F%%",
-        (registeredSuites > 0) ? (((double) passedSuites) / registeredSuites) * 100.0 : 0.0
+        (selectedSuites > 0) ? (((double) passedSuites) / selectedSuites) * 100.0 : 0.0
     );
     scunit_printf("), ");
     scunit_printfc(
@@ -381,9 +1073,9 @@ int scunit_executeSuites() {
         (failedSuites > 0) ? SCUNIT_COLOR_DARK_RED : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
         "%.2F%%",
-        (registeredSuites > 0) ? (((double) failedSuites) / registeredSuites) * 100.0 : 0.0
+        (selectedSuites > 0) ? (((double) failedSuites) / selectedSuites) * 100.0 : 0.0
     );
-    scunit_printf("), %" PRId64 " Total\nTests: ", registeredSuites);
+    scunit_printf("), %" PRId64 " Total\nTests: ", selectedSuites);
     scunit_printfc(
         (summary.passedTests > 0) ? SCUNIT_COLOR_DARK_GREEN : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
@@ -391,7 +1083,8 @@ int scunit_executeSuites() {
         summary.passedTests
     );
     scunit_printf("Passed (");
-    int64_t totalTests = summary.passedTests + summary.skippedTests + summary.failedTests;
+    int64_t totalTests = summary.passedTests + summary.skippedTests + summary.failedTests
+        + summary.flakyTests + summary.quarantinedTests;
     scunit_printfc(
         (summary.passedTests > 0) ? SCUNIT_COLOR_DARK_GREEN : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
@@ -426,10 +1119,48 @@ int scunit_executeSuites() {
         "%.2F%%",
         (totalTests > 0) ? (((double) summary.failedTests) / totalTests) * 100.0 : 0.0
     );
+    scunit_printf(")");
+    // Flaky and quarantined tests only occur if retries or a quarantine file are used, so they are
+    // left out of the summary otherwise.
+    if (summary.flakyTests > 0) {
+        scunit_printf(", ");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_MAGENTA,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%" PRId64 " ",
+            summary.flakyTests
+        );
+        scunit_printf("Flaky (");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_MAGENTA,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%.2F%%",
+            (((double) summary.flakyTests) / totalTests) * 100.0
+        );
+        scunit_printf(")");
+    }
+    if (summary.quarantinedTests > 0) {
+        scunit_printf(", ");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_BLUE,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%" PRId64 " ",
+            summary.quarantinedTests
+        );
+        scunit_printf("Quarantined (");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_BLUE,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%.2F%%",
+            (((double) summary.quarantinedTests) / totalTests) * 100.0
+        );
+        scunit_printf(")");
+    }
+    SCUnitError error;
     SCUnitMeasurement wallTimeMeasurement = scunit_timer_getWallTime(timer, &error);
     SCUnitMeasurement cpuTimeMeasurement = scunit_timer_getCPUTime(timer, &error);
     scunit_printf(
-        "), %" PRId64 " Total\nWall: %.3F %s, CPU: %.3F %s\n",
+        ", %" PRId64 " Total\nWall: %.3F %s, CPU: %.3F %s\n",
         totalTests,
         wallTimeMeasurement.time,
         wallTimeMeasurement.timeUnitString,
@@ -443,7 +1174,202 @@ int scunit_executeSuites() {
             scunit_random_getSeed(random)
         );
     }
+}
+
+int scunit_executeSuites() {
+    int exitCode = EXIT_SUCCESS;
+    // Suites can be executed in a sequential or random order. This means that we may need to
+    // shuffle the indices of the suites. If no suites are registered, `suiteIndices` is a `nullptr`
+    // since allocating an array of size zero results in implementation-defined behavior (which we
+    // try to avoid).
+    int64_t* suiteIndices = nullptr;
+    if (registeredSuites > 0) {
+        suiteIndices = SCUNIT_MALLOC(registeredSuites * sizeof(int64_t));
+        if (suiteIndices == nullptr) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while preparing the execution of the suites "
+                "(code %d).\n",
+                SCUNIT_ERROR_OUT_OF_MEMORY
+            );
+            exitCode = EXIT_FAILURE;
+            goto suiteIndicesAllocationFailed;
+        }
+    }
+    // We initialize the indices of the suites in the order they were registered using
+    // `[[gnu::constructor]]`, which is apparently in reversed order. Suites without any tests
+    // selected by the current filter are left out entirely.
+    int64_t selectedSuites = 0;
+    for (int64_t i = registeredSuites - 1; i >= 0; i--) {
+        if (isSuiteSelected(suites[i])) {
+            suiteIndices[selectedSuites++] = i;
+        }
+    }
+    if (config.order == SCUNIT_ORDER_RANDOM) {
+        for (int64_t i = selectedSuites - 1; i > 0; i--) {
+            int64_t j = scunit_random_int64(random, 0, i);
+            int64_t temp = suiteIndices[i];
+            suiteIndices[i] = suiteIndices[j];
+            suiteIndices[j] = temp;
+        }
+    }
+    int64_t failedSuites = 0;
+    SCUnitSummary summary = { };
+    SCUnitTimer* timer = scunit_timer_new();
+    if (timer == nullptr) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while preparing the execution of the suites (code %d).\n",
+            SCUNIT_ERROR_OUT_OF_MEMORY
+        );
+        exitCode = EXIT_FAILURE;
+        goto timerAllocationFailed;
+    }
+    // The report of the benchmarks is written to the original `stdout` at the end, so everything
+    // else (including the output of the tests themselves) goes to `stderr` in the meantime.
+    int reportFd = -1;
+    if (config.benchmarkFormat == SCUNIT_BENCHMARK_FORMAT_GBENCH_JSON) {
+        fflush(stdout);
+        reportFd = dup(STDOUT_FILENO);
+        if ((reportFd < 0) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0)) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while preparing the execution of the suites "
+                "(code %d).\n",
+                SCUNIT_ERROR_WRITING_STREAM_FAILED
+            );
+            exitCode = EXIT_FAILURE;
+            goto failed;
+        }
+    }
+    SCUnitError error = scunit_flaky_load();
+    if (error != SCUNIT_ERROR_NONE) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while loading the quarantine or flaky history file "
+            "(code %d).\n",
+            error
+        );
+        exitCode = EXIT_FAILURE;
+        goto failed;
+    }
+    error = scunit_timer_start(timer);
+    if (error != SCUNIT_ERROR_NONE) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while executing the suites (code %d).\n",
+            error
+        );
+        exitCode = EXIT_FAILURE;
+        goto failed;
+    }
+    for (int64_t i = 0; i < selectedSuites; i++) {
+        const SCUnitSuite* suite = suites[suiteIndices[i]];
+        SCUnitSummary suiteSummary;
+        error = scunit_suite_execute(suite, &suiteSummary);
+        if (error != SCUNIT_ERROR_NONE) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while executing the suite %s (code %d).\n",
+                scunit_suite_getName(suite),
+                error
+            );
+            exitCode = EXIT_FAILURE;
+            goto failed;
+        }
+        if (suiteSummary.failedTests > 0) {
+            failedSuites++;
+        }
+        summary.passedTests += suiteSummary.passedTests;
+        summary.skippedTests += suiteSummary.skippedTests;
+        summary.failedTests += suiteSummary.failedTests;
+        summary.flakyTests += suiteSummary.flakyTests;
+        summary.quarantinedTests += suiteSummary.quarantinedTests;
+    }
+    error = scunit_flaky_save();
+    if (error != SCUNIT_ERROR_NONE) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while saving the flaky history file (code %d).\n",
+            error
+        );
+        exitCode = EXIT_FAILURE;
+        goto failed;
+    }
+    error = scunit_timer_stop(timer);
+    if (error != SCUNIT_ERROR_NONE) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while executing the suites (code %d).\n",
+            error
+        );
+        exitCode = EXIT_FAILURE;
+        goto failed;
+    }
+    if (config.resultFd >= 0) {
+        // Flush the regular output first, so that it is complete once a reader of the summary
+        // (e. g. an orchestrating process) sees the summary.
+        fflush(stdout);
+        int result = dprintf(
+            config.resultFd,
+            "%" PRId64 " %" PRId64 " %" PRId64 " %" PRId64 " %" PRId64 "\n",
+            summary.passedTests,
+            summary.skippedTests,
+            summary.failedTests,
+            summary.flakyTests,
+            summary.quarantinedTests
+        );
+        if (result < 0) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while writing the summary (code %d).\n",
+                SCUNIT_ERROR_WRITING_STREAM_FAILED
+            );
+            exitCode = EXIT_FAILURE;
+        }
+    }
+    else {
+        printSummary(selectedSuites, failedSuites, summary, timer);
+    }
+    if (reportFd >= 0) {
+        fflush(stdout);
+        error = (dup2(reportFd, STDOUT_FILENO) >= 0)
+            ? scunit_benchmark_writeReport(stdout)
+            : SCUNIT_ERROR_WRITING_STREAM_FAILED;
+        if (error != SCUNIT_ERROR_NONE) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while writing the results of the benchmarks "
+                "(code %d).\n",
+                error
+            );
+            exitCode = EXIT_FAILURE;
+        }
+    }
 failed:
+    if (reportFd >= 0) {
+        close(reportFd);
+    }
     scunit_timer_free(timer);
 timerAllocationFailed:
     SCUNIT_FREE(suiteIndices);
@@ -461,5 +1387,14 @@ static void deinit() {
         scunit_suite_free(suites[i]);
     }
     SCUNIT_FREE(suites);
+    SCUNIT_FREE(config.filter);
+    SCUNIT_FREE(config.patterns);
+    SCUNIT_FREE(config.temporaryDirectoryRoot);
+    SCUNIT_FREE(config.dataDirectory);
+    SCUNIT_FREE(config.benchmarkLibraries[0]);
+    SCUNIT_FREE(config.benchmarkLibraries[1]);
+    SCUNIT_FREE(config.flakyHistoryFile);
+    SCUNIT_FREE(config.quarantineFile);
+    scunit_flaky_unload();
     scunit_random_free(random);
 }
\ No newline at end of file
@@ -1,8 +1,18 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <inttypes.h>
 #include <string.h>
+#include <SCUnit/clock.h>
+#include <SCUnit/crash.h>
+#include <SCUnit/flaky.h>
+#include <SCUnit/leak.h>
+#include <SCUnit/limit.h>
 #include <SCUnit/memory.h>
+#include <SCUnit/mock.h>
+#include <SCUnit/optimize.h>
 #include <SCUnit/print.h>
 #include <SCUnit/random.h>
+#include <SCUnit/sanitizer.h>
 #include <SCUnit/scunit.h>
 #include <SCUnit/suite.h>
 #include <SCUnit/timer.h>
@@ -20,6 +30,16 @@ typedef struct SCUnitTest {
     /** @brief Test function to be executed. */
     SCUnitTestFunction testFunction;
 
+    /**
+     * @brief Source file this `SCUnitTest` is defined in or a `nullptr` if unknown.
+     *
+     * @note This is a reference to a string with static storage duration (usually `__FILE__`).
+     */
+    const char* file;
+
+    /** @brief Line this `SCUnitTest` is defined at or zero if unknown. */
+    int64_t line;
+
 } SCUnitTest;
 
 struct SCUnitSuite {
@@ -106,6 +126,22 @@ const char* scunit_suite_getName(const SCUnitSuite* suite) {
     return suite->name;
 }
 
+int64_t scunit_suite_getTestCount(const SCUnitSuite* suite) {
+    return suite->registeredTests;
+}
+
+const char* scunit_suite_getTestName(const SCUnitSuite* suite, int64_t index) {
+    return ((index >= 0) && (index < suite->registeredTests)) ? suite->tests[index].name : nullptr;
+}
+
+const char* scunit_suite_getTestFile(const SCUnitSuite* suite, int64_t index) {
+    return ((index >= 0) && (index < suite->registeredTests)) ? suite->tests[index].file : nullptr;
+}
+
+int64_t scunit_suite_getTestLine(const SCUnitSuite* suite, int64_t index) {
+    return ((index >= 0) && (index < suite->registeredTests)) ? suite->tests[index].line : 0;
+}
+
 void scunit_suite_setSuiteSetup(SCUnitSuite* suite, SCUnitSuiteSetup suiteSetup) {
     suite->suiteSetup = suiteSetup;
 }
@@ -126,6 +162,16 @@ SCUnitError scunit_suite_registerTest(
     SCUnitSuite* suite,
     const char* name,
     SCUnitTestFunction testFunction
+) {
+    return scunit_suite_registerTestAt(suite, name, testFunction, nullptr, 0);
+}
+
+SCUnitError scunit_suite_registerTestAt(
+    SCUnitSuite* suite,
+    const char* name,
+    SCUnitTestFunction testFunction,
+    const char* file,
+    int64_t line
 ) {
     if (suite->registeredTests >= suite->capacity) {
         int64_t newCapacity = (suite->capacity == 0) ? 1 : suite->capacity * GROWTH_FACTOR;
@@ -142,13 +188,91 @@ SCUnitError scunit_suite_registerTest(
     }
     suite->tests[suite->registeredTests++] = (SCUnitTest) {
         .name = nameCopy,
-        .testFunction = testFunction
+        .testFunction = testFunction,
+        .file = file,
+        .line = line
     };
     return SCUNIT_ERROR_NONE;
 }
 
+[[gnu::noinline]]
+void scunit_suite_callTest(SCUnitTestFunction testFunction, SCUnitContext* context) {
+    testFunction(context);
+    // Keeps the call from becoming a tail call, which would remove this frame from backtraces.
+    scunit_clobberMemory();
+}
+
+/**
+ * @brief Executes the function of a given test, passing through it once more for every section
+ * left early.
+ *
+ * @note A section left by returning from the test early (e. g. due to a failed assertion) is ended
+ * and the test is passed through again, skipping the sections already executed. Tests without
+ * sections are therefore only passed through once.
+ *
+ * @param[in]      test    Test to execute.
+ * @param[in, out] context `SCUnitContext` to pass to the test.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_TIMER_FAILED` if measuring a section failed and `SCUNIT_ERROR_NONE`
+ *         otherwise.
+ */
+static SCUnitError executePasses(const SCUnitTest* test, SCUnitContext* context) {
+    bool hasPendingSections;
+    do {
+        scunit_context_rewindSections(context);
+        scunit_suite_callTest(test->testFunction, context);
+        SCUnitError error = scunit_context_closeSections(context, &hasPendingSections);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+    }
+    while (hasPendingSections);
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Executes the function of a given test, recovering from a crash if signals are caught.
+ *
+ * @note The recovery point must be set in a stack frame that is still active while the test
+ * function is executed, which is why this is a separate function instead of being part of
+ * `scunit_crash_install()`. A section the crash occurred in is ended, but the test is not passed
+ * through again, since its state cannot be trusted anymore.
+ *
+ * @param[in]      test    Test to execute.
+ * @param[in, out] context `SCUnitContext` to pass to the test.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *         `SCUNIT_ERROR_INSTALLING_SIGNAL_HANDLERS_FAILED` if installing the signal handlers
+ *         failed, `SCUNIT_ERROR_TIMER_FAILED` if measuring a section failed and
+ *         `SCUNIT_ERROR_NONE` otherwise.
+ */
+static SCUnitError executeTest(const SCUnitTest* test, SCUnitContext* context) {
+    if (!scunit_getCatchSignals()) {
+        return executePasses(test, context);
+    }
+    SCUnitError error = scunit_crash_install();
+    if (error != SCUNIT_ERROR_NONE) {
+        return error;
+    }
+    sigjmp_buf recoveryPoint;
+    if (sigsetjmp(recoveryPoint, 1) != 0) {
+        // The handler already cleared the recovery point before jumping back.
+        error = scunit_crash_appendReport(context);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        bool hasPendingSections;
+        return scunit_context_closeSections(context, &hasPendingSections);
+    }
+    scunit_crash_setRecoveryPoint(&recoveryPoint);
+    error = executePasses(test, context);
+    scunit_crash_setRecoveryPoint(nullptr);
+    return error;
+}
+
 SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summary) {
     SCUnitError error = SCUNIT_ERROR_NONE;
+    // Message of the first failure of the current test, kept while it is retried.
+    char* firstMessage = nullptr;
     // Tests can be executed in a sequential or random order. This means that we may need to shuffle
     // the indices of the tests. If no tests are registered, `testIndices` is a `nullptr` since
     // allocating an array of size zero results in implementation-defined behavior (which we try to
@@ -162,12 +286,16 @@ SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summar
         }
     }
     // We initialize the indices of the tests in the order they were registered using
-    // `[[gnu::constructor]]`, which is apparently in reversed order.
-    for (int64_t i = 0; i < suite->registeredTests; i++) {
-        testIndices[i] = suite->registeredTests - 1 - i;
+    // `[[gnu::constructor]]`, which is apparently in reversed order. Tests not selected by the
+    // current filter are left out entirely.
+    int64_t selectedTests = 0;
+    for (int64_t i = suite->registeredTests - 1; i >= 0; i--) {
+        if (scunit_isTestSelected(suite->name, suite->tests[i].name)) {
+            testIndices[selectedTests++] = i;
+        }
     }
     if (scunit_getOrder() == SCUNIT_ORDER_RANDOM) {
-        for (int64_t i = suite->registeredTests - 1; i > 0; i--) {
+        for (int64_t i = selectedTests - 1; i > 0; i--) {
             int64_t j = scunit_random_int64(random, 0, i);
             int64_t temp = testIndices[i];
             testIndices[i] = testIndices[j];
@@ -200,43 +328,153 @@ SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summar
     if (suite->suiteSetup != nullptr) {
         suite->suiteSetup();
     }
-    for (int64_t i = 0; i < suite->registeredTests; i++) {
-        if (suite->testSetup != nullptr) {
-            suite->testSetup();
-        }
+    for (int64_t i = 0; i < selectedTests; i++) {
         const SCUnitTest* test = &suite->tests[testIndices[i]];
-        scunit_printf("(%" PRId64 "/%" PRId64 ") Executing test ", i + 1, suite->registeredTests);
-        scunit_printfc(SCUNIT_COLOR_DARK_CYAN, SCUNIT_COLOR_DARK_DEFAULT, "%s", test->name);
-        scunit_printf("... ");
-        // Reuse the context for every test to avoid some unnecessary memory allocations.
-        scunit_context_reset(context);
-        error = scunit_timer_start(testTimer);
-        if (error != SCUNIT_ERROR_NONE) {
-            goto failed;
-        }
-        test->testFunction(context);
-        error = scunit_timer_stop(testTimer);
-        if (error != SCUNIT_ERROR_NONE) {
-            goto failed;
+        scunit_sanitizer_setCurrentTest(suite->name, test->name);
+        // A failed test is executed again (including its setup and teardown functions) until it
+        // passes or no retries are left. Only the message of the first failure is kept, since the
+        // failures of the retries are usually the same.
+        int64_t attempt = 0;
+        while (true) {
+            // The snapshot is taken before the setup function and compared after the teardown
+            // function, so that resources acquired in the setup and released in the teardown do not
+            // count as leaks.
+            if (scunit_getDetectLeaks()) {
+                error = scunit_leak_snapshot();
+                if (error != SCUNIT_ERROR_NONE) {
+                    goto failed;
+                }
+            }
+            if (suite->testSetup != nullptr) {
+                suite->testSetup();
+            }
+            if (attempt == 0) {
+                scunit_printf("(%" PRId64 "/%" PRId64 ") Executing test ", i + 1, selectedTests);
+                scunit_printfc(SCUNIT_COLOR_DARK_CYAN, SCUNIT_COLOR_DARK_DEFAULT, "%s", test->name);
+                scunit_printf("... ");
+            }
+            // Reuse the context for every test to avoid some unnecessary memory allocations.
+            scunit_context_reset(context);
+            error = scunit_limit_begin();
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            error = scunit_timer_start(testTimer);
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            error = executeTest(test, context);
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            error = scunit_timer_stop(testTimer);
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            error = scunit_limit_end(context);
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            if (suite->testTeardown != nullptr) {
+                suite->testTeardown();
+            }
+            if (scunit_getDetectLeaks()) {
+                error = scunit_leak_check(context);
+                if (error != SCUNIT_ERROR_NONE) {
+                    goto failed;
+                }
+            }
+            // Expectations of mocks are only verified if the test passed so far, since a test that
+            // failed or was skipped early usually leaves them unmet anyway. Mocks and the virtual
+            // clock are always reset, so they never leak into the next test.
+            if (scunit_context_getResult(context) == SCUNIT_RESULT_PASS) {
+                error = scunit_mock_verify(context);
+            }
+            scunit_mock_reset();
+            scunit_clock_reset();
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            // Sanitizer reports fail a test regardless of its result so far, even if it was
+            // skipped.
+            error = scunit_sanitizer_attachReports(context);
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            // The temporary directory is only removed once the result of the test is final, since
+            // it is kept if the test failed and temporary directories are kept on failure.
+            error = scunit_context_removeTemporaryDirectory(context);
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+            if ((scunit_context_getResult(context) != SCUNIT_RESULT_FAIL)
+                    || (attempt >= scunit_getRetries())) {
+                break;
+            }
+            if (attempt == 0) {
+                firstMessage = strdup(scunit_context_getMessage(context));
+                if (firstMessage == nullptr) {
+                    error = SCUNIT_ERROR_OUT_OF_MEMORY;
+                    goto failed;
+                }
+            }
+            attempt++;
         }
         SCUnitResult result = scunit_context_getResult(context);
+        bool isFlaky = (attempt > 0) && (result == SCUNIT_RESULT_PASS);
+        bool isQuarantined = (result == SCUNIT_RESULT_FAIL)
+            && scunit_flaky_isQuarantined(suite->name, test->name);
+        int64_t runs = 0;
+        int64_t flips = 0;
+        if (result != SCUNIT_RESULT_SKIP) {
+            error = scunit_flaky_record(
+                suite->name,
+                test->name,
+                result == SCUNIT_RESULT_FAIL,
+                isFlaky,
+                &runs,
+                &flips
+            );
+            if (error != SCUNIT_ERROR_NONE) {
+                goto failed;
+            }
+        }
+        // Quarantined tests are reported like passed ones, so that their output does not end up
+        // between real failures.
+        FILE* stream = ((result == SCUNIT_RESULT_FAIL) && !isQuarantined) ? stderr : stdout;
         switch (result) {
             case SCUNIT_RESULT_PASS:
-                scunit_printfc(SCUNIT_COLOR_DARK_BLACK, SCUNIT_COLOR_DARK_GREEN, " PASS ");
-                summary->passedTests++;
+                if (isFlaky) {
+                    scunit_printfc(SCUNIT_COLOR_DARK_BLACK, SCUNIT_COLOR_DARK_MAGENTA, " FLAKY ");
+                    summary->flakyTests++;
+                }
+                else {
+                    scunit_printfc(SCUNIT_COLOR_DARK_BLACK, SCUNIT_COLOR_DARK_GREEN, " PASS ");
+                    summary->passedTests++;
+                }
                 break;
             case SCUNIT_RESULT_SKIP:
                 scunit_printfc(SCUNIT_COLOR_DARK_BLACK, SCUNIT_COLOR_DARK_YELLOW, " SKIP ");
                 summary->skippedTests++;
                 break;
             case SCUNIT_RESULT_FAIL:
-                scunit_fprintfc(
-                    stderr,
-                    SCUNIT_COLOR_DARK_BLACK,
-                    SCUNIT_COLOR_DARK_RED,
-                    " FAIL "
-                );
-                summary->failedTests++;
+                if (isQuarantined) {
+                    scunit_printfc(
+                        SCUNIT_COLOR_DARK_BLACK,
+                        SCUNIT_COLOR_DARK_BLUE,
+                        " QUARANTINED "
+                    );
+                    summary->quarantinedTests++;
+                }
+                else {
+                    scunit_fprintfc(
+                        stderr,
+                        SCUNIT_COLOR_DARK_BLACK,
+                        SCUNIT_COLOR_DARK_RED,
+                        " FAIL "
+                    );
+                    summary->failedTests++;
+                }
                 break;
             default:
                 scunit_fprintfc(
@@ -251,24 +489,61 @@ SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summar
         SCUnitMeasurement wallTimeMeasurement = scunit_timer_getWallTime(testTimer, &error);
         SCUnitMeasurement cpuTimeMeasurement = scunit_timer_getCPUTime(testTimer, &error);
         scunit_fprintf(
-            (result == SCUNIT_RESULT_FAIL) ? stderr : stdout,
+            stream,
             " [Wall: %.3F %s, CPU: %.3F %s]\n",
             wallTimeMeasurement.time,
             wallTimeMeasurement.timeUnitString,
             cpuTimeMeasurement.time,
             cpuTimeMeasurement.timeUnitString
         );
+        // Every part of the details of a test ends with an empty line, so only the first one needs
+        // an empty line before it.
         const char* message = scunit_context_getMessage(context);
+        bool hasDetails = false;
+        if (isFlaky && (*firstMessage != '\0')) {
+            scunit_printf("%s", firstMessage);
+            hasDetails = true;
+        }
         if (*message != '\0') {
-            scunit_fprintf((result == SCUNIT_RESULT_FAIL) ? stderr : stdout, "%s", message);
+            scunit_fprintf(stream, "%s", message);
+            hasDetails = true;
         }
-        else if (i == (suite->registeredTests - 1)) {
-            scunit_printf("\n");
+        if (isFlaky) {
+            scunit_printf(
+                "%s  Flaky: passed on retry %" PRId64 " of %" PRId64 " (flip rate: %.2F%% over %"
+                    PRId64 " %s).\n\n",
+                hasDetails ? "" : "\n",
+                attempt,
+                scunit_getRetries(),
+                (((double) flips) / runs) * 100.0,
+                runs,
+                (runs == 1) ? "run" : "runs"
+            );
+            hasDetails = true;
+        }
+        if ((result == SCUNIT_RESULT_FAIL) && (attempt > 0)) {
+            scunit_fprintf(
+                stream,
+                "%s  Failed on all %" PRId64 " attempts.\n\n",
+                hasDetails ? "" : "\n",
+                attempt + 1
+            );
+            hasDetails = true;
+        }
+        if (isQuarantined) {
+            scunit_printf(
+                "%s  Quarantined: this failure does not fail the run.\n\n",
+                hasDetails ? "" : "\n"
+            );
+            hasDetails = true;
         }
-        if (suite->testTeardown != nullptr) {
-            suite->testTeardown();
+        if (!hasDetails && (i == (selectedTests - 1))) {
+            scunit_printf("\n");
         }
+        SCUNIT_FREE(firstMessage);
+        firstMessage = nullptr;
     }
+    scunit_sanitizer_setCurrentTest(suite->name, nullptr);
     if (suite->suiteTeardown != nullptr) {
         suite->suiteTeardown();
     }
@@ -290,8 +565,8 @@ SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summar
         (summary->passedTests > 0) ? SCUNIT_COLOR_DARK_GREEN : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
         "%.2F%%",
-        (suite->registeredTests > 0)
-            ? (((double) summary->passedTests) / suite->registeredTests) * 100.0
+        (selectedTests > 0)
+            ? (((double) summary->passedTests) / selectedTests) * 100.0
             : 0.0
     );
     scunit_printf("), ");
@@ -306,8 +581,8 @@ SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summar
         (summary->skippedTests > 0) ? SCUNIT_COLOR_DARK_YELLOW : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
         "%.2F%%",
-        (suite->registeredTests > 0)
-            ? (((double) summary->skippedTests) / suite->registeredTests) * 100.0
+        (selectedTests > 0)
+            ? (((double) summary->skippedTests) / selectedTests) * 100.0
             : 0.0
     );
     scunit_printf("), ");
@@ -322,19 +597,57 @@ SCUnitError scunit_suite_execute(const SCUnitSuite* suite, SCUnitSummary* summar
         (summary->failedTests > 0) ? SCUNIT_COLOR_DARK_RED : SCUNIT_COLOR_DARK_DEFAULT,
         SCUNIT_COLOR_DARK_DEFAULT,
         "%.2F%%",
-        (suite->registeredTests > 0)
-            ? (((double) summary->failedTests) / suite->registeredTests) * 100.0
+        (selectedTests > 0)
+            ? (((double) summary->failedTests) / selectedTests) * 100.0
             : 0.0
     );
+    scunit_printf(")");
+    // Flaky and quarantined tests only occur if retries or a quarantine file are used, so they are
+    // left out of the summary otherwise.
+    if (summary->flakyTests > 0) {
+        scunit_printf(", ");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_MAGENTA,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%" PRId64 " ",
+            summary->flakyTests
+        );
+        scunit_printf("Flaky (");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_MAGENTA,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%.2F%%",
+            (((double) summary->flakyTests) / selectedTests) * 100.0
+        );
+        scunit_printf(")");
+    }
+    if (summary->quarantinedTests > 0) {
+        scunit_printf(", ");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_BLUE,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%" PRId64 " ",
+            summary->quarantinedTests
+        );
+        scunit_printf("Quarantined (");
+        scunit_printfc(
+            SCUNIT_COLOR_DARK_BLUE,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "%.2F%%",
+            (((double) summary->quarantinedTests) / selectedTests) * 100.0
+        );
+        scunit_printf(")");
+    }
     scunit_printf(
-        "), %" PRId64 " Total\nWall: %.3F %s, CPU: %.3F %s\n\n",
-        suite->registeredTests,
+        ", %" PRId64 " Total\nWall: %.3F %s, CPU: %.3F %s\n\n",
+        selectedTests,
         wallTimeMeasurement.time,
         wallTimeMeasurement.timeUnitString,
         cpuTimeMeasurement.time,
         cpuTimeMeasurement.timeUnitString
     );
 failed:
+    SCUNIT_FREE(firstMessage);
     scunit_context_free(context);
 contextAllocationFailed:
     scunit_timer_free(testTimer);
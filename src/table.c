@@ -0,0 +1,620 @@
+#include <inttypes.h>
+#include <string.h>
+#include <SCUnit/data.h>
+#include <SCUnit/memory.h>
+#include <SCUnit/optimize.h>
+#include <SCUnit/table.h>
+
+/** @brief Size used for initially allocating an array of fields. */
+static constexpr int64_t INITIAL_CAPACITY = 16;
+
+/** @brief Growth factor used for resizing an array of fields. */
+static constexpr int64_t GROWTH_FACTOR = 2;
+
+/** @brief Maximum number of failed rows after which no further rows are executed. */
+static constexpr int64_t MAX_FAILED_ROWS = 10;
+
+/** @brief Maximum number of characters of a row included in the report of a failed row. */
+static constexpr int64_t MAX_DISPLAYED_LENGTH = 96;
+
+/** @brief Represents a dynamically resized array of fields. */
+typedef struct Fields {
+
+    /**
+     * @brief Fields of the array.
+     *
+     * @note This is a dynamically resized array with storage for `capacity` elements.
+     */
+    SCUnitField* items;
+
+    /** @brief Number of fields. */
+    int64_t count;
+
+    /** @brief Capacity of the array of fields. */
+    int64_t capacity;
+
+} Fields;
+
+struct SCUnitRow {
+
+    /** @brief Number of this `SCUnitRow`, starting at one. */
+    int64_t number;
+
+    /** @brief Names of the fields (the header of a CSV file or the keys of a JSON object). */
+    Fields names;
+
+    /** @brief Values of the fields. */
+    Fields values;
+
+};
+
+/**
+ * @brief Appends a field to a given array of fields.
+ *
+ * @param[in, out] fields Array of fields to append the field to.
+ * @param[in]      text   Pointer to the first character of the field.
+ * @param[in]      length Length of the field (in characters).
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendField(Fields* fields, const char* text, int64_t length) {
+    if (fields->count == fields->capacity) {
+        int64_t newCapacity = (fields->capacity > 0)
+            ? fields->capacity * GROWTH_FACTOR
+            : INITIAL_CAPACITY;
+        SCUnitField* newItems = SCUNIT_REALLOC(fields->items, newCapacity * sizeof(SCUnitField));
+        if (newItems == nullptr) {
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+        fields->items = newItems;
+        fields->capacity = newCapacity;
+    }
+    fields->items[fields->count++] = (SCUnitField) { .text = text, .length = length };
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Determines whether a character is whitespace between JSON tokens or at the end of a line.
+ *
+ * @param[in] character Character to examine.
+ * @return `true` if the character is whitespace, otherwise `false`.
+ */
+static bool isWhitespace(char character) {
+    return (character == ' ') || (character == '\t') || (character == '\r');
+}
+
+/**
+ * @brief Skips whitespace starting at a given position.
+ *
+ * @param[in] cursor Position to start at.
+ * @param[in] end    End of the row.
+ * @return The position of the first character that is not whitespace.
+ */
+static const char* skipWhitespace(const char* cursor, const char* end) {
+    while ((cursor < end) && isWhitespace(*cursor)) {
+        cursor++;
+    }
+    return cursor;
+}
+
+/**
+ * @brief Finds the end of the row starting at a given position.
+ *
+ * @note Line breaks are found using `memchr()`, which is vectorized by common C libraries, so the
+ * bytes between them are never inspected one by one. In a CSV file, a line break inside a quoted
+ * field does not end the row, which is tracked by counting the quotes in each line.
+ *
+ * @param[in]      begin Start of the row.
+ * @param[in]      end   End of the file.
+ * @param[in]      isCsv Whether the file is a CSV file.
+ * @param[in, out] lines Number of the current line, incremented for every line break in the row.
+ * @return The position of the line break ending the row or `end` if it is the last one.
+ */
+static const char* findRowEnd(const char* begin, const char* end, bool isCsv, int64_t* lines) {
+    const char* cursor = begin;
+    bool isQuoted = false;
+    while (true) {
+        const char* newline = memchr(cursor, '\n', end - cursor);
+        if (newline == nullptr) {
+            return end;
+        }
+        if (!isCsv) {
+            return newline;
+        }
+        for (const char* quote = memchr(cursor, '"', newline - cursor); quote != nullptr;
+                quote = memchr(quote + 1, '"', newline - (quote + 1))) {
+            isQuoted = !isQuoted;
+        }
+        if (!isQuoted) {
+            return newline;
+        }
+        (*lines)++;
+        cursor = newline + 1;
+    }
+}
+
+/**
+ * @brief Splits a row of a CSV file into its fields.
+ *
+ * @param[in]  begin       Start of the row.
+ * @param[in]  end         End of the row (excluding the line break).
+ * @param[out] fields      Array of fields to append the fields to.
+ * @param[out] isMalformed Whether the row is malformed.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError splitCsvRow(
+    const char* begin,
+    const char* end,
+    Fields* fields,
+    bool* isMalformed
+) {
+    const char* cursor = begin;
+    while (true) {
+        const char* fieldBegin = cursor;
+        const char* fieldEnd;
+        if ((cursor < end) && (*cursor == '"')) {
+            fieldBegin++;
+            const char* quote = fieldBegin;
+            while (true) {
+                quote = memchr(quote, '"', end - quote);
+                if (quote == nullptr) {
+                    *isMalformed = true;
+                    return SCUNIT_ERROR_NONE;
+                }
+                if ((quote + 1 < end) && (quote[1] == '"')) {
+                    quote += 2;
+                    continue;
+                }
+                break;
+            }
+            fieldEnd = quote;
+            cursor = quote + 1;
+            if ((cursor < end) && (*cursor != ',')) {
+                *isMalformed = true;
+                return SCUNIT_ERROR_NONE;
+            }
+        }
+        else {
+            const char* comma = memchr(cursor, ',', end - cursor);
+            fieldEnd = (comma != nullptr) ? comma : end;
+            cursor = fieldEnd;
+        }
+        SCUnitError error = appendField(fields, fieldBegin, fieldEnd - fieldBegin);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        if (cursor == end) {
+            return SCUNIT_ERROR_NONE;
+        }
+        // Skip the comma separating this field from the next one.
+        cursor++;
+    }
+}
+
+/**
+ * @brief Finds the closing quote of a JSON string.
+ *
+ * @param[in] quote Position of the opening quote.
+ * @param[in] end   End of the row.
+ * @return The position of the closing quote on success, otherwise a `nullptr`.
+ */
+static const char* findClosingQuote(const char* quote, const char* end) {
+    const char* cursor = quote + 1;
+    while (true) {
+        const char* candidate = memchr(cursor, '"', end - cursor);
+        if (candidate == nullptr) {
+            return nullptr;
+        }
+        // A quote preceded by an odd number of backslashes is escaped.
+        int64_t backslashes = 0;
+        while ((candidate - backslashes - 1 > quote) && (candidate[-backslashes - 1] == '\\')) {
+            backslashes++;
+        }
+        if ((backslashes % 2) == 0) {
+            return candidate;
+        }
+        cursor = candidate + 1;
+    }
+}
+
+/**
+ * @brief Scans a single JSON value.
+ *
+ * @note Strings are returned without their quotes, nested arrays and objects as raw text
+ * (including their brackets) and all other values as they appear in the row.
+ *
+ * @param[in]  cursor Start of the value.
+ * @param[in]  end    End of the row.
+ * @param[out] field  Field to store the value in.
+ * @return The position after the value on success, otherwise a `nullptr` if it is malformed.
+ */
+static const char* scanJsonValue(const char* cursor, const char* end, SCUnitField* field) {
+    if (cursor == end) {
+        return nullptr;
+    }
+    if (*cursor == '"') {
+        const char* quote = findClosingQuote(cursor, end);
+        if (quote == nullptr) {
+            return nullptr;
+        }
+        *field = (SCUnitField) { .text = cursor + 1, .length = quote - cursor - 1 };
+        return quote + 1;
+    }
+    if ((*cursor == '{') || (*cursor == '[')) {
+        int64_t depth = 0;
+        for (const char* position = cursor; position < end; position++) {
+            if (*position == '"') {
+                position = findClosingQuote(position, end);
+                if (position == nullptr) {
+                    return nullptr;
+                }
+            }
+            else if ((*position == '{') || (*position == '[')) {
+                depth++;
+            }
+            else if (((*position == '}') || (*position == ']')) && (--depth == 0)) {
+                *field = (SCUnitField) { .text = cursor, .length = position + 1 - cursor };
+                return position + 1;
+            }
+        }
+        return nullptr;
+    }
+    const char* position = cursor;
+    while ((position < end) && (*position != ',') && (*position != '}') && (*position != ']')
+            && !isWhitespace(*position)) {
+        position++;
+    }
+    if (position == cursor) {
+        return nullptr;
+    }
+    *field = (SCUnitField) { .text = cursor, .length = position - cursor };
+    return position;
+}
+
+/**
+ * @brief Splits a row of a JSONL file (a flat JSON object) into its keys and values.
+ *
+ * @param[in]  begin       Start of the row.
+ * @param[in]  end         End of the row (excluding the line break).
+ * @param[out] names       Array of fields to append the keys to.
+ * @param[out] values      Array of fields to append the values to.
+ * @param[out] isMalformed Whether the row is malformed.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError splitJsonRow(
+    const char* begin,
+    const char* end,
+    Fields* names,
+    Fields* values,
+    bool* isMalformed
+) {
+    const char* cursor = skipWhitespace(begin, end);
+    if ((cursor == end) || (*cursor != '{')) {
+        goto malformed;
+    }
+    cursor = skipWhitespace(cursor + 1, end);
+    if ((cursor < end) && (*cursor == '}')) {
+        cursor++;
+        goto closed;
+    }
+    while (true) {
+        if ((cursor == end) || (*cursor != '"')) {
+            goto malformed;
+        }
+        SCUnitField name;
+        cursor = scanJsonValue(cursor, end, &name);
+        if (cursor == nullptr) {
+            goto malformed;
+        }
+        cursor = skipWhitespace(cursor, end);
+        if ((cursor == end) || (*cursor != ':')) {
+            goto malformed;
+        }
+        SCUnitField value;
+        cursor = scanJsonValue(skipWhitespace(cursor + 1, end), end, &value);
+        if (cursor == nullptr) {
+            goto malformed;
+        }
+        SCUnitError error = appendField(names, name.text, name.length);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        error = appendField(values, value.text, value.length);
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        cursor = skipWhitespace(cursor, end);
+        if ((cursor < end) && (*cursor == ',')) {
+            cursor = skipWhitespace(cursor + 1, end);
+            continue;
+        }
+        if ((cursor < end) && (*cursor == '}')) {
+            cursor++;
+            break;
+        }
+        goto malformed;
+    }
+closed:
+    if (skipWhitespace(cursor, end) == end) {
+        return SCUNIT_ERROR_NONE;
+    }
+malformed:
+    *isMalformed = true;
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Determines whether a path ends with a given extension.
+ *
+ * @param[in] path      A null-terminated string for the path to examine.
+ * @param[in] extension A null-terminated string for the extension (including the dot).
+ * @return `true` if the path ends with the extension, otherwise `false`.
+ */
+static bool hasExtension(const char* path, const char* extension) {
+    size_t pathLength = strlen(path);
+    size_t extensionLength = strlen(extension);
+    return (pathLength >= extensionLength)
+        && (strcmp(path + pathLength - extensionLength, extension) == 0);
+}
+
+[[gnu::noinline]]
+void scunit_table_callRow(
+    SCUnitRowFunction function,
+    SCUnitContext* context,
+    const SCUnitRow* row
+) {
+    function(context, row);
+    // Keeps the call from becoming a tail call, which would remove this frame from backtraces.
+    scunit_clobberMemory();
+}
+
+/**
+ * @brief Appends a report of a failed or malformed row to a given `SCUnitContext`.
+ *
+ * @note The report follows the messages of the row itself, such as failed assertions. It is only
+ * preceded by an empty line if there are none.
+ *
+ * @param[in, out] context     `SCUnitContext` to append the report to.
+ * @param[in]      description A null-terminated string describing the row (e. g. `"Row"`).
+ * @param[in]      number      Number of the row.
+ * @param[in]      line        Number of the line the row starts in.
+ * @param[in]      path        A null-terminated string for the path of the test data file.
+ * @param[in]      begin       Start of the row.
+ * @param[in]      end         End of the row (excluding the line break).
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred, otherwise
+ *         `SCUNIT_ERROR_NONE`.
+ */
+static SCUnitError appendRow(
+    SCUnitContext* context,
+    const char* description,
+    int64_t number,
+    int64_t line,
+    const char* path,
+    const char* begin,
+    const char* end
+) {
+    int64_t length = end - begin;
+    bool isTruncated = (length > MAX_DISPLAYED_LENGTH);
+    return scunit_context_appendMessage(
+        context,
+        "%s  %s %" PRId64 " (line %" PRId64 ") of %s:\n\n    %.*s%s\n\n",
+        (scunit_context_getMessage(context)[0] == '\0') ? "\n" : "",
+        description,
+        number,
+        line,
+        path,
+        (int) (isTruncated ? MAX_DISPLAYED_LENGTH : length),
+        begin,
+        isTruncated ? "..." : ""
+    );
+}
+
+SCUnitError scunit_table_execute(
+    SCUnitContext* context,
+    const char* path,
+    SCUnitRowFunction function
+) {
+    SCUnitError error;
+    SCUnitData data = scunit_data_map(path, &error);
+    if (error == SCUNIT_ERROR_OUT_OF_MEMORY) {
+        return error;
+    }
+    if (error != SCUNIT_ERROR_NONE) {
+        error = scunit_context_appendMessage(
+            context,
+            "\n  Mapping the test data file %s failed (code %d).\n\n",
+            path,
+            error
+        );
+        if (error != SCUNIT_ERROR_NONE) {
+            return error;
+        }
+        return scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+    }
+    bool isCsv = hasExtension(path, ".csv");
+    bool isHeader = isCsv;
+    SCUnitRow row = { .number = 0 };
+    int64_t failedRows = 0;
+    int64_t skippedRows = 0;
+    int64_t line = 1;
+    const char* cursor = data.bytes;
+    const char* end = cursor + data.size;
+    while (cursor < end) {
+        int64_t rowLine = line;
+        const char* rowEnd = findRowEnd(cursor, end, isCsv, &line);
+        const char* next = (rowEnd < end) ? rowEnd + 1 : end;
+        line++;
+        const char* rowBegin = cursor;
+        cursor = next;
+        while ((rowEnd > rowBegin) && (rowEnd[-1] == '\r')) {
+            rowEnd--;
+        }
+        if (skipWhitespace(rowBegin, rowEnd) == rowEnd) {
+            continue;
+        }
+        bool isMalformed = false;
+        if (isHeader) {
+            error = splitCsvRow(rowBegin, rowEnd, &row.names, &isMalformed);
+            if (error != SCUNIT_ERROR_NONE) {
+                goto finished;
+            }
+            if (isMalformed) {
+                error = appendRow(context, "Malformed header", 0, rowLine, path, rowBegin, rowEnd);
+                if (error != SCUNIT_ERROR_NONE) {
+                    goto finished;
+                }
+                failedRows++;
+                break;
+            }
+            isHeader = false;
+            continue;
+        }
+        row.number++;
+        row.values.count = 0;
+        if (isCsv) {
+            error = splitCsvRow(rowBegin, rowEnd, &row.values, &isMalformed);
+        }
+        else {
+            row.names.count = 0;
+            error = splitJsonRow(rowBegin, rowEnd, &row.names, &row.values, &isMalformed);
+        }
+        if (error != SCUNIT_ERROR_NONE) {
+            goto finished;
+        }
+        if (isMalformed) {
+            error = appendRow(
+                context,
+                "Malformed row",
+                row.number,
+                rowLine,
+                path,
+                rowBegin,
+                rowEnd
+            );
+            if (error != SCUNIT_ERROR_NONE) {
+                goto finished;
+            }
+            failedRows++;
+        }
+        else {
+            // Every row starts out passing, so that its own result can be told apart from the
+            // results of the rows before it.
+            scunit_context_setResult(context, SCUNIT_RESULT_PASS);
+            scunit_table_callRow(function, context, &row);
+            SCUnitResult result = scunit_context_getResult(context);
+            if (result == SCUNIT_RESULT_FAIL) {
+                error = appendRow(context, "Row", row.number, rowLine, path, rowBegin, rowEnd);
+                if (error != SCUNIT_ERROR_NONE) {
+                    goto finished;
+                }
+                failedRows++;
+            }
+            else if (result == SCUNIT_RESULT_SKIP) {
+                skippedRows++;
+            }
+        }
+        if (failedRows == MAX_FAILED_ROWS) {
+            error = scunit_context_appendMessage(
+                context,
+                "  Stopped after %" PRId64 " failed rows.\n\n",
+                failedRows
+            );
+            if (error != SCUNIT_ERROR_NONE) {
+                goto finished;
+            }
+            break;
+        }
+    }
+    if (failedRows > 0) {
+        error = scunit_context_setResult(context, SCUNIT_RESULT_FAIL);
+    }
+    else if (row.number == 0) {
+        error = scunit_context_appendMessage(
+            context,
+            "\n  The test data file %s contains no rows.\n\n",
+            path
+        );
+        if (error == SCUNIT_ERROR_NONE) {
+            error = scunit_context_setResult(context, SCUNIT_RESULT_SKIP);
+        }
+    }
+    else {
+        error = scunit_context_setResult(
+            context,
+            (skippedRows == row.number) ? SCUNIT_RESULT_SKIP : SCUNIT_RESULT_PASS
+        );
+    }
+finished:
+    SCUNIT_FREE(row.names.items);
+    SCUNIT_FREE(row.values.items);
+    return error;
+}
+
+int64_t scunit_row_getNumber(const SCUnitRow* row) {
+    return row->number;
+}
+
+int64_t scunit_row_getFieldCount(const SCUnitRow* row) {
+    return row->values.count;
+}
+
+SCUnitField scunit_row_getFieldAt(const SCUnitRow* row, int64_t index) {
+    if ((index < 0) || (index >= row->values.count)) {
+        return (SCUnitField) { .text = nullptr, .length = 0 };
+    }
+    return row->values.items[index];
+}
+
+SCUnitField scunit_row_getField(const SCUnitRow* row, const char* name) {
+    int64_t count = (row->names.count < row->values.count) ? row->names.count : row->values.count;
+    for (int64_t i = 0; i < count; i++) {
+        if (scunit_field_equals(row->names.items[i], name)) {
+            return row->values.items[i];
+        }
+    }
+    return (SCUnitField) { .text = nullptr, .length = 0 };
+}
+
+bool scunit_field_equals(SCUnitField field, const char* string) {
+    return (field.text != nullptr) && (strlen(string) == (size_t) field.length)
+        && (memcmp(field.text, string, field.length) == 0);
+}
+
+int64_t scunit_field_toInteger(SCUnitField field, SCUnitError* error) {
+    *error = SCUNIT_ERROR_ARGUMENT_OUT_OF_RANGE;
+    if ((field.text == nullptr) || (field.length == 0)) {
+        return 0;
+    }
+    int64_t i = 0;
+    bool isNegative = (field.text[0] == '-');
+    if ((field.text[0] == '-') || (field.text[0] == '+')) {
+        i++;
+    }
+    if (i == field.length) {
+        return 0;
+    }
+    // Accumulate the negated value, since the magnitude of `INT64_MIN` does not fit into an
+    // `int64_t`.
+    int64_t value = 0;
+    for (; i < field.length; i++) {
+        char character = field.text[i];
+        if ((character < '0') || (character > '9')) {
+            return 0;
+        }
+        int64_t digit = character - '0';
+        if (value < ((INT64_MIN + digit) / 10)) {
+            return 0;
+        }
+        value = (value * 10) - digit;
+    }
+    if (!isNegative) {
+        if (value == INT64_MIN) {
+            return 0;
+        }
+        value = -value;
+    }
+    *error = SCUNIT_ERROR_NONE;
+    return value;
+}
\ No newline at end of file
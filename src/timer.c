@@ -1,5 +1,8 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdint.h>
 #include <time.h>
+#include <SCUnit/clock.h>
 #include <SCUnit/memory.h>
 #include <SCUnit/timer.h>
 
@@ -77,8 +80,8 @@ SCUnitError scunit_timer_start(SCUnitTimer* timer) {
     }
     SCUnitTimespec wallTimeStart;
     SCUnitTimespec cpuTimeStart;
-    if ((clock_gettime(CLOCK_MONOTONIC, &wallTimeStart) < 0)
-            || (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTimeStart) < 0)) {
+    if ((scunit_clock_getRealTime(CLOCK_MONOTONIC, &wallTimeStart) < 0)
+            || (scunit_clock_getRealTime(CLOCK_PROCESS_CPUTIME_ID, &cpuTimeStart) < 0)) {
         return SCUNIT_ERROR_TIMER_FAILED;
     }
     timer->wallTimeStartSeconds = timespecToSeconds(wallTimeStart);
@@ -93,8 +96,8 @@ SCUnitError scunit_timer_restart(SCUnitTimer* timer) {
     }
     SCUnitTimespec wallTimeStart;
     SCUnitTimespec cpuTimeStart;
-    if ((clock_gettime(CLOCK_MONOTONIC, &wallTimeStart) < 0)
-            || (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTimeStart) < 0)) {
+    if ((scunit_clock_getRealTime(CLOCK_MONOTONIC, &wallTimeStart) < 0)
+            || (scunit_clock_getRealTime(CLOCK_PROCESS_CPUTIME_ID, &cpuTimeStart) < 0)) {
         return SCUNIT_ERROR_TIMER_FAILED;
     }
     timer->wallTimeStartSeconds = timespecToSeconds(wallTimeStart);
@@ -108,8 +111,8 @@ SCUnitError scunit_timer_stop(SCUnitTimer* timer) {
     }
     SCUnitTimespec wallTimeEnd;
     SCUnitTimespec cpuTimeEnd;
-    if ((clock_gettime(CLOCK_MONOTONIC, &wallTimeEnd) < 0)
-            || (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuTimeEnd) < 0)) {
+    if ((scunit_clock_getRealTime(CLOCK_MONOTONIC, &wallTimeEnd) < 0)
+            || (scunit_clock_getRealTime(CLOCK_PROCESS_CPUTIME_ID, &cpuTimeEnd) < 0)) {
         return SCUNIT_ERROR_TIMER_FAILED;
     }
     timer->wallTimeEndSeconds = timespecToSeconds(wallTimeEnd);
@@ -189,6 +192,12 @@ SCUnitMeasurement scunit_timer_getCPUTime(const SCUnitTimer* timer, SCUnitError*
     return cpuTimeMeasurement;
 }
 
+SCUnitMeasurement scunit_timer_toMeasurement(double seconds) {
+    SCUnitMeasurement measurement = { .time = seconds };
+    adjustMeasurement(&measurement);
+    return measurement;
+}
+
 void scunit_timer_free(SCUnitTimer* timer) {
     SCUNIT_FREE(timer);
 }
\ No newline at end of file
@@ -0,0 +1,1391 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <SCUnit/scunit.h>
+#include "summary.h"
+
+/** @brief File name suffix identifying modules when loading all modules of a directory. */
+static const char* const MODULE_SUFFIX = ".so";
+
+/** @brief Growth factor used for resizing the array of loaded modules. */
+static constexpr int64_t GROWTH_FACTOR = 2;
+
+/**
+ * @brief Modules loaded by the runner.
+ *
+ * @note This is a dynamically resized array with storage for `capacity` elements and
+ * `loadedModules` loaded modules, except if `capacity` is zero, in which case it is a `nullptr`.
+ */
+static SCUnitModule** modules;
+
+/** @brief Capacity for loading modules. */
+static int64_t capacity;
+
+/** @brief Number of loaded modules. */
+static int64_t loadedModules;
+
+/**
+ * @brief Loads a module from a given path and appends it to the loaded modules.
+ *
+ * @attention If an unexpected error occurs while loading the module, an error message is printed
+ * to `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] path A null-terminated string for the path of the module to load.
+ */
+static void loadModule(const char* path) {
+    if (loadedModules >= capacity) {
+        int64_t newCapacity = (capacity == 0) ? 1 : capacity * GROWTH_FACTOR;
+        SCUnitModule** newModules = SCUNIT_REALLOC(modules, newCapacity * sizeof(SCUnitModule*));
+        if (newModules == nullptr) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while loading the module %s (code %d).\n",
+                path,
+                SCUNIT_ERROR_OUT_OF_MEMORY
+            );
+            exit(EXIT_FAILURE);
+        }
+        modules = newModules;
+        capacity = newCapacity;
+    }
+    SCUnitError error;
+    SCUnitModule* module = scunit_module_load(path, &error);
+    if (module == nullptr) {
+        const char* reason = (error == SCUNIT_ERROR_LOADING_MODULE_FAILED) ? dlerror() : nullptr;
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while loading the module %s (code %d).\n",
+            path,
+            error
+        );
+        if (reason != nullptr) {
+            scunit_fprintf(stderr, "%s\n", reason);
+        }
+        exit(EXIT_FAILURE);
+    }
+    modules[loadedModules++] = module;
+}
+
+/**
+ * @brief Determines whether a directory entry names a module.
+ *
+ * @param[in] entry Directory entry to examine.
+ * @return A nonzero value if the name of the entry ends with `MODULE_SUFFIX`, otherwise zero.
+ */
+static int isModule(const struct dirent* entry) {
+    size_t length = strlen(entry->d_name);
+    size_t suffixLength = strlen(MODULE_SUFFIX);
+    return (length > suffixLength)
+        && (strcmp(entry->d_name + length - suffixLength, MODULE_SUFFIX) == 0);
+}
+
+/**
+ * @brief Loads all modules contained in a given directory (non-recursively).
+ *
+ * @note Modules are loaded in alphabetical order to produce a reproducible order of suites.
+ *
+ * @attention If an unexpected error occurs while loading the modules, an error message is printed
+ * to `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] directory A null-terminated string for the path of the directory.
+ */
+static void loadDirectory(const char* directory) {
+    struct dirent** entries;
+    int count = scandir(directory, &entries, isModule, alphasort);
+    if (count < 0) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while reading the directory %s (code %d).\n",
+            directory,
+            SCUNIT_ERROR_READING_STREAM_FAILED
+        );
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < count; i++) {
+        // `dlopen()` only searches the library path for names without a slash, so we always
+        // construct a path containing the directory.
+        size_t size = strlen(directory) + 1 + strlen(entries[i]->d_name) + 1;
+        char* path = SCUNIT_MALLOC(size);
+        if (path == nullptr) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while loading the module %s (code %d).\n",
+                entries[i]->d_name,
+                SCUNIT_ERROR_OUT_OF_MEMORY
+            );
+            exit(EXIT_FAILURE);
+        }
+        snprintf(path, size, "%s/%s", directory, entries[i]->d_name);
+        loadModule(path);
+        SCUNIT_FREE(path);
+        free(entries[i]);
+    }
+    free(entries);
+}
+
+/**
+ * @brief Loads a module or all modules of a directory, depending on the type of a given path.
+ *
+ * @param[in] path A null-terminated string for the path of a module or directory.
+ */
+static void loadPath(const char* path) {
+    struct stat status;
+    if ((stat(path, &status) == 0) && S_ISDIR(status.st_mode)) {
+        loadDirectory(path);
+    }
+    else if (strchr(path, '/') == nullptr) {
+        // Prevent `dlopen()` from searching the library path for a module in the current directory.
+        size_t size = strlen(path) + 3;
+        char* relativePath = SCUNIT_MALLOC(size);
+        if (relativePath == nullptr) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while loading the module %s (code %d).\n",
+                path,
+                SCUNIT_ERROR_OUT_OF_MEMORY
+            );
+            exit(EXIT_FAILURE);
+        }
+        snprintf(relativePath, size, "./%s", path);
+        loadModule(relativePath);
+        SCUNIT_FREE(relativePath);
+    }
+    else {
+        loadModule(path);
+    }
+}
+
+/** @brief Represents a dynamically resized buffer of bytes read from a pipe. */
+typedef struct SCUnitBuffer {
+
+    /**
+     * @brief Bytes stored in this `SCUnitBuffer`, always followed by a terminating `\0` byte.
+     *
+     * @note This is a dynamically allocated array with storage for `capacity` bytes, except if
+     * `capacity` is zero, in which case it is a `nullptr`.
+     */
+    char* data;
+
+    /** @brief Number of bytes stored in this `SCUnitBuffer` (excluding the terminating `\0`). */
+    int64_t length;
+
+    /** @brief Capacity of this `SCUnitBuffer` (in bytes). */
+    int64_t capacity;
+
+} SCUnitBuffer;
+
+/** @brief Represents a test executable whose suites are scheduled by the orchestrator. */
+typedef struct SCUnitBinary {
+
+    /** @brief Path of the test executable (a reference into the command line arguments). */
+    const char* path;
+
+    /** @brief Number of jobs of this test executable that are currently running. */
+    int64_t runningJobs;
+
+} SCUnitBinary;
+
+/** @brief Represents a single suite of a test executable executed in a separate process. */
+typedef struct SCUnitJob {
+
+    /** @brief Index of the `SCUnitBinary` this `SCUnitJob` belongs to. */
+    int64_t binary;
+
+    /**
+     * @brief Name of the suite executed by this `SCUnitJob`.
+     *
+     * @note This is a dynamically allocated string managed by this `SCUnitJob`.
+     */
+    char* suite;
+
+    /** @brief Number of tests selected in the suite. */
+    int64_t testCount;
+
+    /** @brief Estimated duration of this `SCUnitJob` (in seconds) used for scheduling. */
+    double estimatedSeconds;
+
+    /** @brief Point in time this `SCUnitJob` was started at (in seconds). */
+    double startSeconds;
+
+    /** @brief Measured duration of this `SCUnitJob` (in seconds), valid once it finished. */
+    double elapsedSeconds;
+
+    /** @brief Process identifier of the running test executable. */
+    pid_t pid;
+
+    /** @brief Reading end of the pipe connected to `stdout` and `stderr` of the process. */
+    int outputFd;
+
+    /** @brief Reading end of the pipe the process writes its machine-readable summary to. */
+    int resultFd;
+
+    /** @brief Output of the process, which is printed as a whole once the process finished. */
+    SCUnitBuffer output;
+
+    /** @brief Machine-readable summary written by the process. */
+    SCUnitBuffer result;
+
+    /** @brief Whether this `SCUnitJob` has already been started. */
+    bool started;
+
+} SCUnitJob;
+
+/** @brief Represents a recorded duration of a suite, used to estimate the duration of a job. */
+typedef struct SCUnitTiming {
+
+    /** @brief Path of the test executable (dynamically allocated). */
+    char* binary;
+
+    /** @brief Name of the suite (dynamically allocated). */
+    char* suite;
+
+    /** @brief Recorded duration of the suite (in seconds). */
+    double seconds;
+
+    /** @brief Whether this `SCUnitTiming` was used for (and will be replaced by) a job. */
+    bool matched;
+
+} SCUnitTiming;
+
+/** @brief Represents a simple parser for the JSON produced by the option `--list-tests=json`. */
+typedef struct SCUnitJsonParser {
+
+    /** @brief Current position of this `SCUnitJsonParser`. */
+    const char* current;
+
+} SCUnitJsonParser;
+
+/** @brief Size used for reading from a pipe at once. */
+static constexpr int64_t READ_SIZE = 4096;
+
+/** @brief File descriptor a job process writes its machine-readable summary to. */
+static constexpr int RESULT_FD = 3;
+
+/** @brief Number of nanoseconds in a single second (10^9 ns = 1 s). */
+static constexpr double NANOSECONDS_PER_SECOND = 1'000'000'000.0;
+
+/** @brief Test executables scheduled by the orchestrator. */
+static SCUnitBinary* binaries;
+
+/** @brief Number of test executables scheduled by the orchestrator. */
+static int64_t binaryCount;
+
+/**
+ * @brief Jobs scheduled by the orchestrator.
+ *
+ * @note This is a dynamically resized array with storage for `jobCapacity` elements and `jobCount`
+ * jobs.
+ */
+static SCUnitJob* jobs;
+
+/** @brief Capacity for scheduling jobs. */
+static int64_t jobCapacity;
+
+/** @brief Number of scheduled jobs. */
+static int64_t jobCount;
+
+/** @brief Recorded durations of suites, sorted by test executable and suite. */
+static SCUnitTiming* timings;
+
+/** @brief Number of recorded durations of suites. */
+static int64_t timingCount;
+
+/**
+ * @brief Prints an error message for an unexpected error to `stderr` and exits using
+ * `EXIT_FAILURE`.
+ *
+ * @param[in] action A null-terminated string describing what was done when the error occurred.
+ * @param[in] error  `SCUnitError` that occurred.
+ */
+static void fail(const char* action, SCUnitError error) {
+    scunit_fprintfc(
+        stderr,
+        SCUNIT_COLOR_DARK_RED,
+        SCUNIT_COLOR_DARK_DEFAULT,
+        "An unexpected error occurred while %s (code %d).\n",
+        action,
+        error
+    );
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * @brief Gets the current point in time of a monotonic clock (in seconds).
+ *
+ * @return The current point in time of a monotonic clock (in seconds).
+ */
+static double now() {
+    struct timespec timespec;
+    clock_gettime(CLOCK_MONOTONIC, &timespec);
+    return ((double) timespec.tv_sec) + (((double) timespec.tv_nsec) / NANOSECONDS_PER_SECOND);
+}
+
+/**
+ * @brief Reads all bytes currently available from a given file descriptor into an `SCUnitBuffer`.
+ *
+ * @param[in]      fd        File descriptor to read from.
+ * @param[in, out] buffer    `SCUnitBuffer` to append to (resized as necessary).
+ * @param[out]     endOfFile Whether the end-of-file condition was reached.
+ * @return `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ * `SCUNIT_ERROR_READING_STREAM_FAILED` if reading failed and `SCUNIT_ERROR_NONE` otherwise.
+ */
+static SCUnitError readAvailable(int fd, SCUnitBuffer* buffer, bool* endOfFile) {
+    if ((buffer->capacity - buffer->length) <= READ_SIZE) {
+        int64_t newCapacity = buffer->capacity + READ_SIZE + 1;
+        if (newCapacity < (buffer->capacity * 2)) {
+            newCapacity = buffer->capacity * 2;
+        }
+        char* newData = SCUNIT_REALLOC(buffer->data, newCapacity);
+        if (newData == nullptr) {
+            return SCUNIT_ERROR_OUT_OF_MEMORY;
+        }
+        buffer->data = newData;
+        buffer->capacity = newCapacity;
+    }
+    ssize_t count = read(fd, buffer->data + buffer->length, READ_SIZE);
+    if (count < 0) {
+        if (errno == EINTR) {
+            *endOfFile = false;
+            buffer->data[buffer->length] = '\0';
+            return SCUNIT_ERROR_NONE;
+        }
+        return SCUNIT_ERROR_READING_STREAM_FAILED;
+    }
+    buffer->length += count;
+    buffer->data[buffer->length] = '\0';
+    *endOfFile = (count == 0);
+    return SCUNIT_ERROR_NONE;
+}
+
+/**
+ * @brief Starts a test executable in a new process.
+ *
+ * @note `stdout` and `stderr` of the process are both redirected to `outputFd`. If `resultFd` is
+ * not negative, it is made available to the process as `RESULT_FD`. The original descriptors are
+ * closed in the process afterwards.
+ *
+ * @param[in] path     A null-terminated string for the path of the test executable.
+ * @param[in] args     Null-terminated array of arguments (including the program name).
+ * @param[in] outputFd Writing end of the pipe to redirect the output to.
+ * @param[in] resultFd Writing end of the pipe for the machine-readable summary or a negative value.
+ * @return The process identifier of the new process or a negative value if starting it failed.
+ */
+static pid_t spawn(const char* path, char** args, int outputFd, int resultFd) {
+    fflush(stdout);
+    fflush(stderr);
+    pid_t pid = fork();
+    if (pid == 0) {
+        if ((dup2(outputFd, STDOUT_FILENO) < 0) || (dup2(outputFd, STDERR_FILENO) < 0)
+                || ((resultFd >= 0) && (dup2(resultFd, RESULT_FD) < 0))) {
+            _exit(127);
+        }
+        // The original descriptors would otherwise stay open in the test executable (and any
+        // process it starts) for its whole lifetime, next to the copies it actually writes to.
+        if ((outputFd != STDOUT_FILENO) && (outputFd != STDERR_FILENO)
+                && ((resultFd < 0) || (outputFd != RESULT_FD))) {
+            close(outputFd);
+        }
+        if ((resultFd >= 0) && (resultFd != RESULT_FD)) {
+            close(resultFd);
+        }
+        execv(path, args);
+        // Report the failure through the redirected output, so that it shows up like any other
+        // output of the job.
+        dprintf(STDERR_FILENO, "Executing %s failed: %s\n", path, strerror(errno));
+        _exit(127);
+    }
+    return pid;
+}
+
+/**
+ * @brief Builds the arguments for a test executable.
+ *
+ * @warning The returned array is dynamically allocated and must be deallocated using
+ * `SCUNIT_FREE()`. Its elements are references to the given strings and must not be deallocated.
+ *
+ * @param[in] path           A null-terminated string for the path of the test executable.
+ * @param[in] forwarded      Options forwarded to every test executable.
+ * @param[in] forwardedCount Number of options forwarded to every test executable.
+ * @param[in] skipFilter     Whether forwarded `--filter` options should be left out.
+ * @param[in] first          An additional option or a `nullptr`.
+ * @param[in] second         An additional option or a `nullptr`.
+ * @return A null-terminated array of arguments.
+ */
+static char** buildArguments(
+    const char* path,
+    char** forwarded,
+    int forwardedCount,
+    bool skipFilter,
+    char* first,
+    char* second
+) {
+    char** args = SCUNIT_MALLOC((forwardedCount + 4) * sizeof(char*));
+    if (args == nullptr) {
+        fail("preparing a test executable", SCUNIT_ERROR_OUT_OF_MEMORY);
+    }
+    int count = 0;
+    args[count++] = (char*) path;
+    for (int i = 0; i < forwardedCount; i++) {
+        if (!skipFilter || (strncmp(forwarded[i], "--filter=", strlen("--filter=")) != 0)) {
+            args[count++] = forwarded[i];
+        }
+    }
+    if (first != nullptr) {
+        args[count++] = first;
+    }
+    if (second != nullptr) {
+        args[count++] = second;
+    }
+    args[count] = nullptr;
+    return args;
+}
+
+/**
+ * @brief Skips any whitespace at the current position of a given `SCUnitJsonParser`.
+ *
+ * @param[in, out] parser `SCUnitJsonParser` to advance.
+ */
+static void skipWhitespace(SCUnitJsonParser* parser) {
+    while ((*parser->current == ' ') || (*parser->current == '\t') || (*parser->current == '\n')
+            || (*parser->current == '\r')) {
+        parser->current++;
+    }
+}
+
+/**
+ * @brief Parses a JSON string at the current position of a given `SCUnitJsonParser`.
+ *
+ * @note Escaped code points outside of ASCII are replaced by a '?', which is sufficient for the
+ * names of suites and tests.
+ *
+ * @param[in, out] parser `SCUnitJsonParser` to advance.
+ * @param[out]     string Dynamically allocated copy of the string or a `nullptr` to only skip it.
+ * @return `true` if a valid string was parsed, otherwise `false`.
+ */
+static bool parseString(SCUnitJsonParser* parser, char** string) {
+    skipWhitespace(parser);
+    if (*parser->current != '"') {
+        return false;
+    }
+    const char* start = ++parser->current;
+    while ((*parser->current != '"') && (*parser->current != '\0')) {
+        parser->current += ((*parser->current == '\\') && (parser->current[1] != '\0')) ? 2 : 1;
+    }
+    if (*parser->current != '"') {
+        return false;
+    }
+    const char* end = parser->current++;
+    if (string == nullptr) {
+        return true;
+    }
+    char* copy = SCUNIT_MALLOC((end - start) + 1);
+    if (copy == nullptr) {
+        fail("parsing the list of tests", SCUNIT_ERROR_OUT_OF_MEMORY);
+    }
+    int64_t length = 0;
+    for (const char* c = start; c < end; c++) {
+        if (*c != '\\') {
+            copy[length++] = *c;
+            continue;
+        }
+        c++;
+        switch (*c) {
+            case 'b':
+                copy[length++] = '\b';
+                break;
+            case 'f':
+                copy[length++] = '\f';
+                break;
+            case 'n':
+                copy[length++] = '\n';
+                break;
+            case 'r':
+                copy[length++] = '\r';
+                break;
+            case 't':
+                copy[length++] = '\t';
+                break;
+            case 'u':
+                unsigned int codePoint = 0;
+                if (((end - c) < 5) || (sscanf(c + 1, "%4x", &codePoint) != 1)) {
+                    SCUNIT_FREE(copy);
+                    return false;
+                }
+                copy[length++] = (codePoint < 0x80) ? (char) codePoint : '?';
+                c += 4;
+                break;
+            default:
+                copy[length++] = *c;
+                break;
+        }
+    }
+    copy[length] = '\0';
+    *string = copy;
+    return true;
+}
+
+/**
+ * @brief Skips an arbitrary JSON value at the current position of a given `SCUnitJsonParser`.
+ *
+ * @param[in, out] parser `SCUnitJsonParser` to advance.
+ * @return `true` if a valid value was skipped, otherwise `false`.
+ */
+static bool skipValue(SCUnitJsonParser* parser) {
+    skipWhitespace(parser);
+    char opening = *parser->current;
+    if (opening == '"') {
+        return parseString(parser, nullptr);
+    }
+    if ((opening != '{') && (opening != '[')) {
+        // Numbers and literals (`true`, `false` and `null`) consist of simple characters only.
+        const char* start = parser->current;
+        while ((*parser->current != '\0') && (strchr(",]} \t\r\n", *parser->current) == nullptr)) {
+            parser->current++;
+        }
+        return parser->current != start;
+    }
+    char closing = (opening == '{') ? '}' : ']';
+    parser->current++;
+    skipWhitespace(parser);
+    if (*parser->current == closing) {
+        parser->current++;
+        return true;
+    }
+    while (true) {
+        if ((opening == '{') && (!parseString(parser, nullptr) || (skipWhitespace(parser),
+                *parser->current++ != ':'))) {
+            return false;
+        }
+        if (!skipValue(parser)) {
+            return false;
+        }
+        skipWhitespace(parser);
+        char next = *parser->current++;
+        if (next == closing) {
+            return true;
+        }
+        if (next != ',') {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Expects a given character at the current position of a given `SCUnitJsonParser`.
+ *
+ * @param[in, out] parser    `SCUnitJsonParser` to advance.
+ * @param[in]      character Character to expect.
+ * @return `true` if the character was found (and skipped), otherwise `false`.
+ */
+static bool expect(SCUnitJsonParser* parser, char character) {
+    skipWhitespace(parser);
+    if (*parser->current != character) {
+        return false;
+    }
+    parser->current++;
+    return true;
+}
+
+/**
+ * @brief Appends a new job for a suite of a test executable.
+ *
+ * @param[in] binary    Index of the `SCUnitBinary` the suite belongs to.
+ * @param[in] suite     Dynamically allocated name of the suite (ownership is transferred).
+ * @param[in] testCount Number of selected tests in the suite.
+ */
+static void addJob(int64_t binary, char* suite, int64_t testCount) {
+    if (jobCount >= jobCapacity) {
+        int64_t newCapacity = (jobCapacity == 0) ? 1 : jobCapacity * GROWTH_FACTOR;
+        SCUnitJob* newJobs = SCUNIT_REALLOC(jobs, newCapacity * sizeof(SCUnitJob));
+        if (newJobs == nullptr) {
+            fail("scheduling the suites", SCUNIT_ERROR_OUT_OF_MEMORY);
+        }
+        jobs = newJobs;
+        jobCapacity = newCapacity;
+    }
+    jobs[jobCount++] = (SCUnitJob) {
+        .binary = binary,
+        .suite = suite,
+        .testCount = testCount,
+        .outputFd = -1,
+        .resultFd = -1
+    };
+}
+
+/**
+ * @brief Parses the list of tests of a test executable and appends a job for every suite.
+ *
+ * @note Unknown members are ignored, so that additional metadata can be added to the list without
+ * breaking the orchestrator.
+ *
+ * @param[in] binary Index of the `SCUnitBinary` the list belongs to.
+ * @param[in] json   A null-terminated string containing the list of tests as JSON.
+ * @return `true` if the list was parsed successfully, otherwise `false`.
+ */
+static bool parseTestList(int64_t binary, const char* json) {
+    SCUnitJsonParser parser = { .current = json };
+    if (!expect(&parser, '{')) {
+        return false;
+    }
+    if (expect(&parser, '}')) {
+        return true;
+    }
+    do {
+        char* key = nullptr;
+        if (!parseString(&parser, &key) || !expect(&parser, ':')) {
+            SCUNIT_FREE(key);
+            return false;
+        }
+        bool isSuites = strcmp(key, "suites") == 0;
+        SCUNIT_FREE(key);
+        if (!isSuites) {
+            if (!skipValue(&parser)) {
+                return false;
+            }
+            continue;
+        }
+        if (!expect(&parser, '[')) {
+            return false;
+        }
+        if (expect(&parser, ']')) {
+            continue;
+        }
+        do {
+            if (!expect(&parser, '{')) {
+                return false;
+            }
+            char* suite = nullptr;
+            int64_t testCount = 0;
+            do {
+                char* member = nullptr;
+                if (!parseString(&parser, &member) || !expect(&parser, ':')) {
+                    SCUNIT_FREE(member);
+                    SCUNIT_FREE(suite);
+                    return false;
+                }
+                bool valid;
+                if ((strcmp(member, "name") == 0) && (suite == nullptr)) {
+                    valid = parseString(&parser, &suite);
+                }
+                else if (strcmp(member, "tests") == 0) {
+                    valid = expect(&parser, '[');
+                    if (valid && !expect(&parser, ']')) {
+                        do {
+                            valid = skipValue(&parser);
+                            testCount++;
+                        }
+                        while (valid && expect(&parser, ','));
+                        valid = valid && expect(&parser, ']');
+                    }
+                }
+                else {
+                    valid = skipValue(&parser);
+                }
+                SCUNIT_FREE(member);
+                if (!valid) {
+                    SCUNIT_FREE(suite);
+                    return false;
+                }
+            }
+            while (expect(&parser, ','));
+            if (!expect(&parser, '}') || (suite == nullptr)) {
+                SCUNIT_FREE(suite);
+                return false;
+            }
+            if (testCount > 0) {
+                addJob(binary, suite, testCount);
+            }
+            else {
+                SCUNIT_FREE(suite);
+            }
+        }
+        while (expect(&parser, ','));
+        if (!expect(&parser, ']')) {
+            return false;
+        }
+    }
+    while (expect(&parser, ','));
+    return expect(&parser, '}');
+}
+
+/**
+ * @brief Queries a test executable for its list of tests and appends a job for every suite.
+ *
+ * @attention If an unexpected error occurs while querying the test executable, an error message is
+ * printed to `stderr` and the program exits using `EXIT_FAILURE`.
+ *
+ * @param[in] binary         Index of the `SCUnitBinary` to query.
+ * @param[in] forwarded      Options forwarded to every test executable.
+ * @param[in] forwardedCount Number of options forwarded to every test executable.
+ */
+static void queryTests(int64_t binary, char** forwarded, int forwardedCount) {
+    const char* path = binaries[binary].path;
+    char** args = buildArguments(
+        path,
+        forwarded,
+        forwardedCount,
+        false,
+        "--list-tests=json",
+        nullptr
+    );
+    int fds[2];
+    if (pipe(fds) < 0) {
+        fail("querying a test executable", SCUNIT_ERROR_OPENING_STREAM_FAILED);
+    }
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    pid_t pid = spawn(path, args, fds[1], -1);
+    close(fds[1]);
+    SCUNIT_FREE(args);
+    if (pid < 0) {
+        fail("querying a test executable", SCUNIT_ERROR_OPENING_STREAM_FAILED);
+    }
+    SCUnitBuffer output = { };
+    bool endOfFile = false;
+    while (!endOfFile) {
+        SCUnitError error = readAvailable(fds[0], &output, &endOfFile);
+        if (error != SCUNIT_ERROR_NONE) {
+            fail("querying a test executable", error);
+        }
+    }
+    close(fds[0]);
+    int status;
+    while ((waitpid(pid, &status, 0) < 0) && (errno == EINTR)) { }
+    if (!WIFEXITED(status) || (WEXITSTATUS(status) != EXIT_SUCCESS)
+            || !parseTestList(binary, output.data)) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "The test executable %s did not produce a valid list of tests.\n",
+            path
+        );
+        if (output.length > 0) {
+            scunit_fprintf(stderr, "%s", output.data);
+        }
+        exit(EXIT_FAILURE);
+    }
+    SCUNIT_FREE(output.data);
+}
+
+/**
+ * @brief Compares two `SCUnitTiming`s by test executable and suite.
+ *
+ * @param[in] first  First `SCUnitTiming` to compare.
+ * @param[in] second Second `SCUnitTiming` to compare.
+ * @return A negative value, zero or a positive value if `first` is ordered before, equal to or
+ * after `second`.
+ */
+static int compareTimings(const void* first, const void* second) {
+    const SCUnitTiming* firstTiming = first;
+    const SCUnitTiming* secondTiming = second;
+    int result = strcmp(firstTiming->binary, secondTiming->binary);
+    return (result != 0) ? result : strcmp(firstTiming->suite, secondTiming->suite);
+}
+
+/**
+ * @brief Compares two `SCUnitJob`s by their estimated duration in descending order.
+ *
+ * @param[in] first  First `SCUnitJob` to compare.
+ * @param[in] second Second `SCUnitJob` to compare.
+ * @return A negative value, zero or a positive value if `first` is ordered before, equal to or
+ * after `second`.
+ */
+static int compareJobs(const void* first, const void* second) {
+    const SCUnitJob* firstJob = first;
+    const SCUnitJob* secondJob = second;
+    if (firstJob->estimatedSeconds != secondJob->estimatedSeconds) {
+        return (firstJob->estimatedSeconds > secondJob->estimatedSeconds) ? -1 : 1;
+    }
+    // Fall back to the original order for reasons of reproducibility.
+    return (firstJob->binary != secondJob->binary)
+        ? ((firstJob->binary < secondJob->binary) ? -1 : 1)
+        : strcmp(firstJob->suite, secondJob->suite);
+}
+
+/**
+ * @brief Loads the recorded durations of suites from a given file.
+ *
+ * @note Each line of the file consists of the path of a test executable, the name of a suite and
+ * its duration in seconds, separated by tabs. A missing file is treated like an empty one.
+ *
+ * @param[in] path A null-terminated string for the path of the file.
+ */
+static void loadTimings(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return;
+    }
+    char* line = nullptr;
+    size_t size = 0;
+    int64_t capacity = 0;
+    while (getline(&line, &size, file) >= 0) {
+        char* binary = strtok(line, "\t");
+        char* suite = strtok(nullptr, "\t");
+        char* seconds = strtok(nullptr, "\n");
+        if ((binary == nullptr) || (suite == nullptr) || (seconds == nullptr)) {
+            continue;
+        }
+        if (timingCount >= capacity) {
+            int64_t newCapacity = (capacity == 0) ? 1 : capacity * GROWTH_FACTOR;
+            SCUnitTiming* newTimings = SCUNIT_REALLOC(timings, newCapacity * sizeof(SCUnitTiming));
+            if (newTimings == nullptr) {
+                fail("loading the timings", SCUNIT_ERROR_OUT_OF_MEMORY);
+            }
+            timings = newTimings;
+            capacity = newCapacity;
+        }
+        SCUnitTiming timing = {
+            .binary = strdup(binary),
+            .suite = strdup(suite),
+            .seconds = strtod(seconds, nullptr)
+        };
+        if ((timing.binary == nullptr) || (timing.suite == nullptr)) {
+            fail("loading the timings", SCUNIT_ERROR_OUT_OF_MEMORY);
+        }
+        timings[timingCount++] = timing;
+    }
+    free(line);
+    fclose(file);
+    qsort(timings, timingCount, sizeof(SCUnitTiming), compareTimings);
+}
+
+/**
+ * @brief Estimates the duration of all jobs based on the recorded durations of their suites.
+ *
+ * @note Suites without a recorded duration are estimated using the average duration per test of
+ * all recorded suites (or simply their number of tests if nothing was recorded at all).
+ */
+static void estimateJobs() {
+    double recordedSeconds = 0.0;
+    int64_t recordedTests = 0;
+    for (int64_t i = 0; i < jobCount; i++) {
+        SCUnitTiming key = {
+            .binary = (char*) binaries[jobs[i].binary].path,
+            .suite = jobs[i].suite
+        };
+        SCUnitTiming* timing = (timingCount > 0)
+            ? bsearch(&key, timings, timingCount, sizeof(SCUnitTiming), compareTimings)
+            : nullptr;
+        if (timing != nullptr) {
+            timing->matched = true;
+            jobs[i].estimatedSeconds = timing->seconds;
+            recordedSeconds += timing->seconds;
+            recordedTests += jobs[i].testCount;
+        }
+        else {
+            jobs[i].estimatedSeconds = -1.0;
+        }
+    }
+    double secondsPerTest = (recordedTests > 0) ? recordedSeconds / recordedTests : 1.0;
+    for (int64_t i = 0; i < jobCount; i++) {
+        if (jobs[i].estimatedSeconds < 0.0) {
+            jobs[i].estimatedSeconds = jobs[i].testCount * secondsPerTest;
+        }
+    }
+}
+
+/**
+ * @brief Saves the measured durations of all jobs (and all other previously recorded durations)
+ * to a given file.
+ *
+ * @param[in] path A null-terminated string for the path of the file.
+ */
+static void saveTimings(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        fail("saving the timings", SCUNIT_ERROR_OPENING_STREAM_FAILED);
+    }
+    for (int64_t i = 0; i < timingCount; i++) {
+        if (!timings[i].matched) {
+            fprintf(
+                file,
+                "%s\t%s\t%.9f\n",
+                timings[i].binary,
+                timings[i].suite,
+                timings[i].seconds
+            );
+        }
+    }
+    for (int64_t i = 0; i < jobCount; i++) {
+        fprintf(
+            file,
+            "%s\t%s\t%.9f\n",
+            binaries[jobs[i].binary].path,
+            jobs[i].suite,
+            jobs[i].elapsedSeconds
+        );
+    }
+    if (fclose(file) == EOF) {
+        fail("saving the timings", SCUNIT_ERROR_CLOSING_STREAM_FAILED);
+    }
+}
+
+/**
+ * @brief Starts a given job.
+ *
+ * @param[in, out] job            `SCUnitJob` to start.
+ * @param[in]      forwarded      Options forwarded to every test executable.
+ * @param[in]      forwardedCount Number of options forwarded to every test executable.
+ * @param[in]      testPattern    A null-terminated string for the pattern selecting the tests.
+ */
+static void startJob(
+    SCUnitJob* job,
+    char** forwarded,
+    int forwardedCount,
+    const char* testPattern
+) {
+    const char* path = binaries[job->binary].path;
+    int size = snprintf(nullptr, 0, "--filter=%s.%s", job->suite, testPattern) + 1;
+    char* filter = SCUNIT_MALLOC(size);
+    char resultOption[32];
+    if (filter == nullptr) {
+        fail("starting a suite", SCUNIT_ERROR_OUT_OF_MEMORY);
+    }
+    snprintf(filter, size, "--filter=%s.%s", job->suite, testPattern);
+    snprintf(resultOption, sizeof(resultOption), "--result-fd=%d", RESULT_FD);
+    char** args = buildArguments(path, forwarded, forwardedCount, true, filter, resultOption);
+    int outputFds[2];
+    int resultFds[2];
+    if ((pipe(outputFds) < 0) || (pipe(resultFds) < 0)) {
+        fail("starting a suite", SCUNIT_ERROR_OPENING_STREAM_FAILED);
+    }
+    fcntl(outputFds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(resultFds[0], F_SETFD, FD_CLOEXEC);
+    job->startSeconds = now();
+    job->pid = spawn(path, args, outputFds[1], resultFds[1]);
+    close(outputFds[1]);
+    close(resultFds[1]);
+    SCUNIT_FREE(args);
+    SCUNIT_FREE(filter);
+    if (job->pid < 0) {
+        fail("starting a suite", SCUNIT_ERROR_OPENING_STREAM_FAILED);
+    }
+    job->outputFd = outputFds[0];
+    job->resultFd = resultFds[0];
+    job->started = true;
+    binaries[job->binary].runningJobs++;
+}
+
+/**
+ * @brief Finishes a given job whose pipes have both been closed and accounts for its results.
+ *
+ * @param[in, out] job          `SCUnitJob` to finish.
+ * @param[in, out] summary      `SCUnitSummary` to accumulate the results in.
+ * @param[in, out] failedSuites Number of failed suites to update.
+ */
+static void finishJob(SCUnitJob* job, SCUnitSummary* summary, int64_t* failedSuites) {
+    int status;
+    while ((waitpid(job->pid, &status, 0) < 0) && (errno == EINTR)) { }
+    job->elapsedSeconds = now() - job->startSeconds;
+    binaries[job->binary].runningJobs--;
+    if (job->output.length > 0) {
+        fwrite(job->output.data, 1, job->output.length, stdout);
+    }
+    SCUnitSummary jobSummary = { };
+    bool valid = (job->result.length > 0) && (sscanf(
+        job->result.data,
+        "%" SCNd64 " %" SCNd64 " %" SCNd64 " %" SCNd64 " %" SCNd64,
+        &jobSummary.passedTests,
+        &jobSummary.skippedTests,
+        &jobSummary.failedTests,
+        &jobSummary.flakyTests,
+        &jobSummary.quarantinedTests
+    ) == 5);
+    if (!valid) {
+        // The process terminated without reporting its results (e. g. because it crashed), so we
+        // consider all of its tests as failed.
+        jobSummary = (SCUnitSummary) { .failedTests = job->testCount };
+        if ((job->output.length > 0) && (job->output.data[job->output.length - 1] != '\n')) {
+            scunit_printf("\n");
+        }
+        // The message is printed to `stdout` (like the output of the job itself), so that it
+        // appears right after the output of the job instead of somewhere before it.
+        if (WIFSIGNALED(status)) {
+            scunit_printfc(
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "\nThe suite %s of %s was terminated by signal %d.\n\n",
+                job->suite,
+                binaries[job->binary].path,
+                WTERMSIG(status)
+            );
+        }
+        else {
+            scunit_printfc(
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "\nThe suite %s of %s exited with code %d without reporting its results.\n\n",
+                job->suite,
+                binaries[job->binary].path,
+                WIFEXITED(status) ? WEXITSTATUS(status) : -1
+            );
+        }
+    }
+    if (jobSummary.failedTests > 0) {
+        (*failedSuites)++;
+    }
+    summary->passedTests += jobSummary.passedTests;
+    summary->skippedTests += jobSummary.skippedTests;
+    summary->failedTests += jobSummary.failedTests;
+    summary->flakyTests += jobSummary.flakyTests;
+    summary->quarantinedTests += jobSummary.quarantinedTests;
+    SCUNIT_FREE(job->output.data);
+    SCUNIT_FREE(job->result.data);
+    job->output = (SCUnitBuffer) { };
+    job->result = (SCUnitBuffer) { };
+}
+
+/**
+ * @brief Executes the suites of multiple test executables in parallel using a pool of processes.
+ *
+ * @note Every suite of every test executable is executed as a separate job. Jobs are started in a
+ * global longest-first order (based on the durations recorded in `timingsPath`, if available),
+ * which keeps all processes busy until the very end of the run.
+ *
+ * @param[in] binaryList     A null-terminated, comma-separated list of test executables.
+ * @param[in] maxJobs        Maximum number of jobs running at the same time.
+ * @param[in] maxBinaryJobs  Maximum number of jobs of a single test executable running at the same
+ *                           time.
+ * @param[in] timingsPath    A null-terminated string for the path of the timings file or a
+ *                           `nullptr`.
+ * @param[in] forwarded      Options forwarded to every test executable.
+ * @param[in] forwardedCount Number of options forwarded to every test executable.
+ * @return `EXIT_FAILURE` if at least one test failed, otherwise `EXIT_SUCCESS`.
+ */
+static int orchestrate(
+    char* binaryList,
+    int64_t maxJobs,
+    int64_t maxBinaryJobs,
+    const char* timingsPath,
+    char** forwarded,
+    int forwardedCount
+) {
+    int64_t capacity = 1;
+    for (const char* c = binaryList; *c != '\0'; c++) {
+        capacity += (*c == ',') ? 1 : 0;
+    }
+    binaries = SCUNIT_MALLOC(capacity * sizeof(SCUnitBinary));
+    if (binaries == nullptr) {
+        fail("scheduling the suites", SCUNIT_ERROR_OUT_OF_MEMORY);
+    }
+    for (char* path = strtok(binaryList, ","); path != nullptr; path = strtok(nullptr, ",")) {
+        binaries[binaryCount++] = (SCUnitBinary) { .path = path };
+    }
+    // The test part of a forwarded filter still applies to every job, while the suite part is
+    // replaced by the suite of the job.
+    const char* testPattern = "*";
+    for (int i = 0; i < forwardedCount; i++) {
+        if (strncmp(forwarded[i], "--filter=", strlen("--filter=")) == 0) {
+            const char* separator = strchr(forwarded[i], '.');
+            testPattern = (separator != nullptr) ? separator + 1 : "*";
+        }
+    }
+    for (int64_t i = 0; i < binaryCount; i++) {
+        queryTests(i, forwarded, forwardedCount);
+    }
+    if (timingsPath != nullptr) {
+        loadTimings(timingsPath);
+    }
+    estimateJobs();
+    qsort(jobs, jobCount, sizeof(SCUnitJob), compareJobs);
+    struct rusage startUsage;
+    getrusage(RUSAGE_CHILDREN, &startUsage);
+    double startSeconds = now();
+    int64_t* running = SCUNIT_MALLOC(maxJobs * sizeof(int64_t));
+    struct pollfd* pollFds = SCUNIT_MALLOC(2 * maxJobs * sizeof(struct pollfd));
+    if ((running == nullptr) || (pollFds == nullptr)) {
+        fail("scheduling the suites", SCUNIT_ERROR_OUT_OF_MEMORY);
+    }
+    int64_t runningCount = 0;
+    int64_t firstPending = 0;
+    SCUnitSummary summary = { };
+    int64_t failedSuites = 0;
+    while ((firstPending < jobCount) || (runningCount > 0)) {
+        // Start the longest pending jobs whose test executables have not reached their limit yet.
+        for (int64_t i = firstPending; (i < jobCount) && (runningCount < maxJobs); i++) {
+            if (jobs[i].started || (binaries[jobs[i].binary].runningJobs >= maxBinaryJobs)) {
+                continue;
+            }
+            startJob(&jobs[i], forwarded, forwardedCount, testPattern);
+            running[runningCount++] = i;
+        }
+        while ((firstPending < jobCount) && jobs[firstPending].started) {
+            firstPending++;
+        }
+        nfds_t pollCount = 0;
+        for (int64_t i = 0; i < runningCount; i++) {
+            const SCUnitJob* job = &jobs[running[i]];
+            if (job->outputFd >= 0) {
+                pollFds[pollCount++] = (struct pollfd) { .fd = job->outputFd, .events = POLLIN };
+            }
+            if (job->resultFd >= 0) {
+                pollFds[pollCount++] = (struct pollfd) { .fd = job->resultFd, .events = POLLIN };
+            }
+        }
+        if ((pollCount > 0) && (poll(pollFds, pollCount, -1) < 0) && (errno != EINTR)) {
+            fail("executing the suites", SCUNIT_ERROR_READING_STREAM_FAILED);
+        }
+        for (int64_t i = 0; i < runningCount; i++) {
+            SCUnitJob* job = &jobs[running[i]];
+            for (nfds_t j = 0; j < pollCount; j++) {
+                if ((pollFds[j].revents == 0)
+                        || ((pollFds[j].fd != job->outputFd) && (pollFds[j].fd != job->resultFd))) {
+                    continue;
+                }
+                bool isOutput = pollFds[j].fd == job->outputFd;
+                bool endOfFile;
+                SCUnitError error = readAvailable(
+                    pollFds[j].fd,
+                    isOutput ? &job->output : &job->result,
+                    &endOfFile
+                );
+                if (error != SCUNIT_ERROR_NONE) {
+                    fail("executing the suites", error);
+                }
+                if (endOfFile) {
+                    close(pollFds[j].fd);
+                    *(isOutput ? &job->outputFd : &job->resultFd) = -1;
+                }
+            }
+        }
+        for (int64_t i = 0; i < runningCount; i++) {
+            SCUnitJob* job = &jobs[running[i]];
+            if ((job->outputFd < 0) && (job->resultFd < 0)) {
+                finishJob(job, &summary, &failedSuites);
+                running[i--] = running[--runningCount];
+            }
+        }
+    }
+    double wallSeconds = now() - startSeconds;
+    struct rusage endUsage;
+    getrusage(RUSAGE_CHILDREN, &endUsage);
+    double cpuSeconds = (endUsage.ru_utime.tv_sec - startUsage.ru_utime.tv_sec)
+        + (endUsage.ru_stime.tv_sec - startUsage.ru_stime.tv_sec)
+        + ((endUsage.ru_utime.tv_usec - startUsage.ru_utime.tv_usec)
+            + (endUsage.ru_stime.tv_usec - startUsage.ru_stime.tv_usec)) / 1e6;
+    scunit_printf("--- ");
+    scunit_printfc(SCUNIT_COLOR_DARK_CYAN, SCUNIT_COLOR_DARK_DEFAULT, "Summary");
+    scunit_printf(
+        " ---\n\nBinaries: %" PRId64 ", Jobs: %" PRId64 "\nSuites: ",
+        binaryCount,
+        maxJobs
+    );
+    printCount(jobCount - failedSuites, jobCount, SCUNIT_COLOR_DARK_GREEN, "Passed");
+    scunit_printf(", ");
+    printCount(failedSuites, jobCount, SCUNIT_COLOR_DARK_RED, "Failed");
+    scunit_printf(", %" PRId64 " Total\nTests: ", jobCount);
+    int64_t totalTests = summary.passedTests + summary.skippedTests + summary.failedTests
+        + summary.flakyTests + summary.quarantinedTests;
+    printCount(summary.passedTests, totalTests, SCUNIT_COLOR_DARK_GREEN, "Passed");
+    scunit_printf(", ");
+    printCount(summary.skippedTests, totalTests, SCUNIT_COLOR_DARK_YELLOW, "Skipped");
+    scunit_printf(", ");
+    printCount(summary.failedTests, totalTests, SCUNIT_COLOR_DARK_RED, "Failed");
+    if (summary.flakyTests > 0) {
+        scunit_printf(", ");
+        printCount(summary.flakyTests, totalTests, SCUNIT_COLOR_DARK_MAGENTA, "Flaky");
+    }
+    if (summary.quarantinedTests > 0) {
+        scunit_printf(", ");
+        printCount(summary.quarantinedTests, totalTests, SCUNIT_COLOR_DARK_BLUE, "Quarantined");
+    }
+    scunit_printf(", %" PRId64 " Total\nWall: ", totalTests);
+    printDuration(wallSeconds);
+    scunit_printf(", CPU: ");
+    printDuration(cpuSeconds);
+    scunit_printf("\n");
+    if (timingsPath != nullptr) {
+        saveTimings(timingsPath);
+    }
+    for (int64_t i = 0; i < jobCount; i++) {
+        SCUNIT_FREE(jobs[i].suite);
+    }
+    for (int64_t i = 0; i < timingCount; i++) {
+        SCUNIT_FREE(timings[i].binary);
+        SCUNIT_FREE(timings[i].suite);
+    }
+    SCUNIT_FREE(timings);
+    SCUNIT_FREE(pollFds);
+    SCUNIT_FREE(running);
+    SCUNIT_FREE(jobs);
+    SCUNIT_FREE(binaries);
+    return (summary.failedTests > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief Parses the argument of a runner option as a positive integer.
+ *
+ * @attention If the argument is invalid, an error message is printed to `stderr` and the program
+ * exits using `EXIT_FAILURE`.
+ *
+ * @param[in] option   A null-terminated string for the whole option (used for error messages).
+ * @param[in] argument A null-terminated string for the argument to parse.
+ * @return The parsed positive integer.
+ */
+static int64_t parsePositive(const char* option, const char* argument) {
+    char* end = nullptr;
+    errno = 0;
+    long long value = strtoll(argument, &end, 10);
+    if ((*argument == '\0') || (*end != '\0') || (errno == ERANGE) || (value < 1)) {
+        scunit_fprintf(
+            stderr,
+            "Invalid argument '%s' for option '%.*s'.\n"
+            "Try option '-h' or '--help' for more information.\n",
+            argument,
+            (int) (argument - option - 1),
+            option
+        );
+        exit(EXIT_FAILURE);
+    }
+    return value;
+}
+
+int main(int argc, char** argv) {
+    // Options are forwarded to `scunit_parseArguments()` (or the test executables in orchestrator
+    // mode), except for the runner options handled here. All other arguments name modules or
+    // directories of modules. Option arguments must therefore be attached using '='
+    // (e. g. '--seed=42').
+    char** options = SCUNIT_MALLOC(argc * sizeof(char*));
+    char** paths = SCUNIT_MALLOC(argc * sizeof(char*));
+    if ((options == nullptr) || (paths == nullptr)) {
+        fail("parsing the command line arguments", SCUNIT_ERROR_OUT_OF_MEMORY);
+    }
+    int optionCount = 0;
+    int pathCount = 0;
+    char* binaryList = nullptr;
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    int64_t maxJobs = (cpuCount > 0) ? cpuCount : 1;
+    int64_t maxBinaryJobs = INT64_MAX;
+    const char* timingsPath = nullptr;
+    options[optionCount++] = argv[0];
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--binaries=", strlen("--binaries=")) == 0) {
+            binaryList = argv[i] + strlen("--binaries=");
+        }
+        else if (strncmp(argv[i], "--jobs=", strlen("--jobs=")) == 0) {
+            maxJobs = parsePositive(argv[i], argv[i] + strlen("--jobs="));
+        }
+        else if (strncmp(argv[i], "--jobs-per-binary=", strlen("--jobs-per-binary=")) == 0) {
+            maxBinaryJobs = parsePositive(argv[i], argv[i] + strlen("--jobs-per-binary="));
+        }
+        else if (strncmp(argv[i], "--timings=", strlen("--timings=")) == 0) {
+            timingsPath = argv[i] + strlen("--timings=");
+        }
+        else if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
+            scunit_printf(
+                "Usage: %s [OPTION]... MODULE|DIRECTORY...\n"
+                "  or:  %s [OPTION]... --binaries=<binary>[,<binary>]...\n"
+                "\n"
+                "Runner options:\n"
+                "  --binaries=<binary>[,...]    Execute the suites of the given test executables "
+                "in parallel.\n"
+                "  --jobs=<n>                   Maximum number of suites executed at the same time "
+                "(default = CPUs).\n"
+                "  --jobs-per-binary=<n>        Maximum number of suites of a single test "
+                "executable executed at the\n"
+                "                               same time (default = unlimited).\n"
+                "  --timings=<file>             Read and update recorded durations of suites "
+                "used for scheduling.\n"
+                "\n",
+                argv[0],
+                argv[0]
+            );
+            options[optionCount++] = argv[i];
+        }
+        else if ((argv[i][0] == '-') && (argv[i][1] != '\0')) {
+            options[optionCount++] = argv[i];
+        }
+        else {
+            paths[pathCount++] = argv[i];
+        }
+    }
+    if (binaryList != nullptr) {
+        if (pathCount > 0) {
+            scunit_fprintf(
+                stderr,
+                "Unexpected argument '%s'.\n"
+                "Try option '-h' or '--help' for more information.\n",
+                paths[0]
+            );
+            return EXIT_FAILURE;
+        }
+        // Forwarded options are still validated here, so that mistakes are reported only once
+        // instead of by every test executable.
+        scunit_parseArguments(optionCount, options);
+        int exitCode = orchestrate(
+            binaryList,
+            maxJobs,
+            maxBinaryJobs,
+            timingsPath,
+            options + 1,
+            optionCount - 1
+        );
+        SCUNIT_FREE(paths);
+        SCUNIT_FREE(options);
+        return exitCode;
+    }
+    if (pathCount == 0) {
+        scunit_parseArguments(optionCount, options);
+        scunit_fprintf(
+            stderr,
+            "Missing module.\n"
+            "Usage: %s [OPTION]... MODULE|DIRECTORY...\n"
+            "Try option '-h' or '--help' for more information.\n",
+            argv[0]
+        );
+        return EXIT_FAILURE;
+    }
+    // Modules are loaded before the options are parsed, so that options like '--list-tests' see
+    // all of their suites.
+    for (int i = 0; i < pathCount; i++) {
+        loadPath(paths[i]);
+    }
+    scunit_parseArguments(optionCount, options);
+    int exitCode = scunit_executeSuites();
+    // Modules are independent of each other, but unloading them in reverse order mirrors the usual
+    // order of destruction of shared objects.
+    for (int64_t i = loadedModules - 1; i >= 0; i--) {
+        // The path is owned by the module and must be copied before unloading it.
+        char* path = strdup(scunit_module_getPath(modules[i]));
+        SCUnitError error = scunit_module_unload(modules[i]);
+        if (error != SCUNIT_ERROR_NONE) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while unloading the module %s (code %d).\n",
+                (path != nullptr) ? path : "?",
+                error
+            );
+            exitCode = EXIT_FAILURE;
+        }
+        SCUNIT_FREE(path);
+    }
+    SCUNIT_FREE(modules);
+    SCUNIT_FREE(paths);
+    SCUNIT_FREE(options);
+    return exitCode;
+}
\ No newline at end of file
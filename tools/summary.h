@@ -0,0 +1,52 @@
+#ifndef SCUNIT_TOOLS_SUMMARY_H
+#define SCUNIT_TOOLS_SUMMARY_H
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <SCUnit/print.h>
+
+/**
+ * @brief Prints a count together with its percentage of a total, as done in the summary.
+ *
+ * @note The functions of this header are shared by the tools, each of which is built from a single
+ * source file, so they are defined `static inline` rather than in a separate translation unit.
+ *
+ * @param[in] count Count to print.
+ * @param[in] total Total the percentage is computed of.
+ * @param[in] color `SCUnitColor` to use if `count` is greater than zero.
+ * @param[in] label A null-terminated string for the label printed after the count.
+ */
+static inline void printCount(int64_t count, int64_t total, SCUnitColor color, const char* label) {
+    SCUnitColor foreground = (count > 0) ? color : SCUNIT_COLOR_DARK_DEFAULT;
+    scunit_printfc(foreground, SCUNIT_COLOR_DARK_DEFAULT, "%" PRId64 " ", count);
+    scunit_printf("%s (", label);
+    scunit_printfc(
+        foreground,
+        SCUNIT_COLOR_DARK_DEFAULT,
+        "%.2F%%",
+        (total > 0) ? (((double) count) / total) * 100.0 : 0.0
+    );
+    scunit_printf(")");
+}
+
+/**
+ * @brief Prints a duration using an appropriate time unit.
+ *
+ * @param[in] seconds Duration to print (in seconds).
+ */
+static inline void printDuration(double seconds) {
+    if (seconds < 1e-3) {
+        scunit_printf("%.3F us", seconds * 1e6);
+    }
+    else if (seconds < 1.0) {
+        scunit_printf("%.3F ms", seconds * 1e3);
+    }
+    else if (seconds < 60.0) {
+        scunit_printf("%.3F s", seconds);
+    }
+    else {
+        scunit_printf("%.3F min", seconds / 60.0);
+    }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,788 @@
+#define _XOPEN_SOURCE 700
+
+#include <dlfcn.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <SCUnit/scunit.h>
+#include "summary.h"
+
+/**
+ * @brief Represents the header of a message exchanged between a worker and a client.
+ *
+ * @note Every message consists of this header followed by `length` bytes of payload. Workers and
+ * clients always run on the same host, so all integers are transferred in native byte order.
+ */
+typedef struct SCUnitMessageHeader {
+
+    /** @brief Type of the message (see the `MESSAGE_*` constants). */
+    uint32_t type;
+
+    /** @brief Length of the payload following this header (in bytes). */
+    uint32_t length;
+
+} SCUnitMessageHeader;
+
+/** @brief Represents a module cached by a worker between jobs. */
+typedef struct SCUnitCachedModule {
+
+    /** @brief Loaded `SCUnitModule`. */
+    SCUnitModule* module;
+
+    /** @brief Identifier of the device containing the shared object when it was loaded. */
+    dev_t device;
+
+    /** @brief Inode of the shared object when it was loaded. */
+    ino_t inode;
+
+    /** @brief Last modification of the shared object when it was loaded. */
+    struct timespec modification;
+
+} SCUnitCachedModule;
+
+/**
+ * @brief Message sent by a client to request executing the tests of a module.
+ *
+ * @note The payload consists of the path of the module and the filter selecting the tests (see
+ * `scunit_setFilter()`), both null-terminated.
+ */
+static constexpr uint32_t MESSAGE_JOB = 1;
+
+/** @brief Message sent by a client to request the worker to shut down. */
+static constexpr uint32_t MESSAGE_SHUTDOWN = 2;
+
+/** @brief Message sent by a worker containing a part of the output of a job (not terminated). */
+static constexpr uint32_t MESSAGE_OUTPUT = 3;
+
+/**
+ * @brief Message sent by a worker once a job is finished.
+ *
+ * @note The payload consists of the number of passed, skipped, failed, flaky and quarantined tests
+ * (in this order) as five `int64_t`.
+ */
+static constexpr uint32_t MESSAGE_RESULT = 4;
+
+/** @brief Message sent by a worker if a job could not be executed (payload is a description). */
+static constexpr uint32_t MESSAGE_ERROR = 5;
+
+/** @brief Maximum length of the payload of a message received by a worker (in bytes). */
+static constexpr uint32_t MAX_REQUEST_LENGTH = 2 * PATH_MAX;
+
+/** @brief Size used for sending the captured output of a job at once. */
+static constexpr int64_t CHUNK_SIZE = 65536;
+
+/** @brief Growth factor used for resizing the array of cached modules. */
+static constexpr int64_t GROWTH_FACTOR = 2;
+
+/**
+ * @brief Modules cached by the worker.
+ *
+ * @note This is a dynamically resized array with storage for `capacity` elements and
+ * `cachedModules` cached modules, except if `capacity` is zero, in which case it is a `nullptr`.
+ */
+static SCUnitCachedModule* modules;
+
+/** @brief Capacity for caching modules. */
+static int64_t capacity;
+
+/** @brief Number of cached modules. */
+static int64_t cachedModules;
+
+/** @brief File descriptor of the temporary file capturing the output of a job. */
+static int captureFd = -1;
+
+/**
+ * @brief Sends a given number of bytes over a socket, retrying until all of them are sent.
+ *
+ * @note `SIGPIPE` is suppressed, so a client disconnecting in the middle of a job does not
+ * terminate the worker.
+ *
+ * @param[in] fd     Socket to send the bytes over.
+ * @param[in] data   Bytes to send.
+ * @param[in] length Number of bytes to send.
+ * @return `true` if all bytes were sent, otherwise `false`.
+ */
+static bool sendAll(int fd, const void* data, size_t length) {
+    const char* current = data;
+    while (length > 0) {
+        ssize_t count = send(fd, current, length, MSG_NOSIGNAL);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        current += count;
+        length -= count;
+    }
+    return true;
+}
+
+/**
+ * @brief Receives a given number of bytes from a socket, retrying until all of them are received.
+ *
+ * @param[in]  fd     Socket to receive the bytes from.
+ * @param[out] data   Buffer to store the bytes in.
+ * @param[in]  length Number of bytes to receive.
+ * @return `true` if all bytes were received, otherwise `false` (including the end of the stream).
+ */
+static bool receiveAll(int fd, void* data, size_t length) {
+    char* current = data;
+    while (length > 0) {
+        ssize_t count = recv(fd, current, length, 0);
+        if (count <= 0) {
+            if ((count < 0) && (errno == EINTR)) {
+                continue;
+            }
+            return false;
+        }
+        current += count;
+        length -= count;
+    }
+    return true;
+}
+
+/**
+ * @brief Sends a message over a socket.
+ *
+ * @param[in] fd      Socket to send the message over.
+ * @param[in] type    Type of the message.
+ * @param[in] payload Payload of the message (may be a `nullptr` if `length` is zero).
+ * @param[in] length  Length of the payload (in bytes).
+ * @return `true` if the message was sent, otherwise `false`.
+ */
+static bool sendMessage(int fd, uint32_t type, const void* payload, uint32_t length) {
+    SCUnitMessageHeader header = { .type = type, .length = length };
+    return sendAll(fd, &header, sizeof(header)) && ((length == 0) || sendAll(fd, payload, length));
+}
+
+/**
+ * @brief Receives a message from a socket.
+ *
+ * @warning The payload is dynamically allocated (with an additional terminating `\0` byte for
+ * convenience) and must be deallocated using `SCUNIT_FREE()`.
+ *
+ * @param[in]  fd        Socket to receive the message from.
+ * @param[in]  maxLength Maximum length of the payload to accept (in bytes).
+ * @param[out] header    Header of the received message.
+ * @param[out] payload   Payload of the received message.
+ * @return `true` if a message was received, otherwise `false` (including the end of the stream).
+ */
+static bool receiveMessage(
+    int fd,
+    uint32_t maxLength,
+    SCUnitMessageHeader* header,
+    char** payload
+) {
+    if (!receiveAll(fd, header, sizeof(*header)) || (header->length > maxLength)) {
+        return false;
+    }
+    *payload = SCUNIT_MALLOC(header->length + 1);
+    if (*payload == nullptr) {
+        return false;
+    }
+    if (!receiveAll(fd, *payload, header->length)) {
+        SCUNIT_FREE(*payload);
+        return false;
+    }
+    (*payload)[header->length] = '\0';
+    return true;
+}
+
+/**
+ * @brief Sends a formatted error message for a job to a client.
+ *
+ * @param[in] fd     Socket of the client.
+ * @param[in] format A null-terminated format string (see `printf()`).
+ * @param[in] ...    Arguments for the format string.
+ */
+static void sendError(int fd, const char* format, ...) {
+    char message[PATH_MAX + 256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    if (length >= (int) sizeof(message)) {
+        length = sizeof(message) - 1;
+    }
+    sendMessage(fd, MESSAGE_ERROR, message, (length > 0) ? length : 0);
+}
+
+/**
+ * @brief Gets a module from the cache, loading (or reloading) it if necessary.
+ *
+ * @note A cached module is reloaded if its shared object changed on disk since it was loaded,
+ * so that a rebuilt module is never executed in an outdated version. If the dynamic loader kept
+ * the old shared object mapped (e. g. because it is still referenced), its constructors are not
+ * run again and the reloaded module registers no suites, which is reported as a failure to load
+ * it (with `errno` cleared, since neither `dlerror()` nor `errno` describe it) rather than silently
+ * executing nothing.
+ *
+ * @param[in]  path  A null-terminated string for the path of the module.
+ * @param[out] error `SCUNIT_ERROR_OUT_OF_MEMORY` if an out-of-memory condition occurred,
+ *                   `SCUNIT_ERROR_LOADING_MODULE_FAILED` if loading the module failed and
+ *                   `SCUNIT_ERROR_NONE` otherwise.
+ * @return The loaded `SCUnitModule` on success, otherwise a `nullptr`.
+ */
+static SCUnitModule* getModule(const char* path, SCUnitError* error) {
+    struct stat status;
+    if (stat(path, &status) < 0) {
+        *error = SCUNIT_ERROR_LOADING_MODULE_FAILED;
+        return nullptr;
+    }
+    int64_t index = 0;
+    while ((index < cachedModules) && (strcmp(scunit_module_getPath(modules[index].module), path)
+            != 0)) {
+        index++;
+    }
+    bool isReloaded = index < cachedModules;
+    if (isReloaded) {
+        const SCUnitCachedModule* cached = &modules[index];
+        if ((cached->device == status.st_dev) && (cached->inode == status.st_ino)
+                && (cached->modification.tv_sec == status.st_mtim.tv_sec)
+                && (cached->modification.tv_nsec == status.st_mtim.tv_nsec)) {
+            *error = SCUNIT_ERROR_NONE;
+            return cached->module;
+        }
+        scunit_module_unload(cached->module);
+        modules[index] = modules[--cachedModules];
+    }
+    if (cachedModules >= capacity) {
+        int64_t newCapacity = (capacity == 0) ? 1 : capacity * GROWTH_FACTOR;
+        SCUnitCachedModule* newModules = SCUNIT_REALLOC(
+            modules,
+            newCapacity * sizeof(SCUnitCachedModule)
+        );
+        if (newModules == nullptr) {
+            *error = SCUNIT_ERROR_OUT_OF_MEMORY;
+            return nullptr;
+        }
+        modules = newModules;
+        capacity = newCapacity;
+    }
+    SCUnitModule* module = scunit_module_load(path, error);
+    if (module == nullptr) {
+        return nullptr;
+    }
+    if (isReloaded && (scunit_module_getSuiteCount(module) == 0)) {
+        scunit_module_unload(module);
+        errno = 0;
+        *error = SCUNIT_ERROR_LOADING_MODULE_FAILED;
+        return nullptr;
+    }
+    modules[cachedModules++] = (SCUnitCachedModule) {
+        .module = module,
+        .device = status.st_dev,
+        .inode = status.st_ino,
+        .modification = status.st_mtim
+    };
+    return module;
+}
+
+/**
+ * @brief Sends the output captured so far to a client and clears the capture.
+ *
+ * @param[in] client Socket of the client.
+ * @return `true` if the output was sent, otherwise `false`.
+ */
+static bool sendOutput(int client) {
+    fflush(stdout);
+    fflush(stderr);
+    off_t size = lseek(captureFd, 0, SEEK_CUR);
+    lseek(captureFd, 0, SEEK_SET);
+    char chunk[CHUNK_SIZE];
+    bool sent = true;
+    while (sent && (size > 0)) {
+        ssize_t count = read(captureFd, chunk, (size < CHUNK_SIZE) ? size : CHUNK_SIZE);
+        if (count <= 0) {
+            break;
+        }
+        sent = sendMessage(client, MESSAGE_OUTPUT, chunk, count);
+        size -= count;
+    }
+    lseek(captureFd, 0, SEEK_SET);
+    return (ftruncate(captureFd, 0) == 0) && sent;
+}
+
+/**
+ * @brief Determines if at least one test of a given `SCUnitSuite` is selected by the current
+ * filter.
+ *
+ * @param[in] suite `SCUnitSuite` to examine.
+ * @return `true` if at least one test of the given `SCUnitSuite` is selected, otherwise `false`.
+ */
+static bool isSuiteSelected(const SCUnitSuite* suite) {
+    int64_t testCount = scunit_suite_getTestCount(suite);
+    const char* suiteName = scunit_suite_getName(suite);
+    for (int64_t i = 0; i < testCount; i++) {
+        if (scunit_isTestSelected(suiteName, scunit_suite_getTestName(suite, i))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Executes the selected tests of a module and sends the output and results to a client.
+ *
+ * @note The output of the suites is captured in a temporary file and sent after each suite.
+ * Suites are executed in-process, so any state the module keeps between jobs (e. g. expensive
+ * fixtures cached in static variables) is reused by subsequent jobs.
+ *
+ * @param[in] client A socket of the client.
+ * @param[in] path   A null-terminated string for the path of the module.
+ * @param[in] filter A null-terminated string for the filter selecting the tests.
+ */
+static void executeJob(int client, const char* path, const char* filter) {
+    SCUnitError error;
+    SCUnitModule* module = getModule(path, &error);
+    if (module == nullptr) {
+        const char* reason = (error == SCUNIT_ERROR_LOADING_MODULE_FAILED) ? dlerror() : nullptr;
+        if (reason == nullptr) {
+            reason = (errno != 0)
+                ? strerror(errno)
+                : "No suites were registered after reloading it";
+        }
+        sendError(client, "Loading the module %s failed (code %d): %s", path, error, reason);
+        return;
+    }
+    char* previousFilter = strdup(scunit_getFilter());
+    if ((previousFilter == nullptr) || (scunit_setFilter(filter) != SCUNIT_ERROR_NONE)) {
+        SCUNIT_FREE(previousFilter);
+        sendError(
+            client,
+            "Setting the filter %s failed (code %d)",
+            filter,
+            SCUNIT_ERROR_OUT_OF_MEMORY
+        );
+        return;
+    }
+    fflush(stdout);
+    fflush(stderr);
+    int savedStdout = dup(STDOUT_FILENO);
+    int savedStderr = dup(STDERR_FILENO);
+    dup2(captureFd, STDOUT_FILENO);
+    dup2(captureFd, STDERR_FILENO);
+    SCUnitSummary summary = { };
+    bool connected = true;
+    // The quarantine and flaky history files are loaded for every job, since other processes may
+    // have updated the history in the meantime.
+    error = scunit_flaky_load();
+    int64_t suiteCount = (error == SCUNIT_ERROR_NONE) ? scunit_module_getSuiteCount(module) : 0;
+    // Suites are executed in the same order as `scunit_executeSuites()` would (in reverse order of
+    // their registration).
+    for (int64_t i = suiteCount - 1; i >= 0; i--) {
+        const SCUnitSuite* suite = scunit_module_getSuite(module, i);
+        if (!isSuiteSelected(suite)) {
+            continue;
+        }
+        SCUnitSummary suiteSummary = { };
+        error = scunit_suite_execute(suite, &suiteSummary);
+        if (error != SCUNIT_ERROR_NONE) {
+            break;
+        }
+        summary.passedTests += suiteSummary.passedTests;
+        summary.skippedTests += suiteSummary.skippedTests;
+        summary.failedTests += suiteSummary.failedTests;
+        summary.flakyTests += suiteSummary.flakyTests;
+        summary.quarantinedTests += suiteSummary.quarantinedTests;
+        connected = sendOutput(client);
+        if (!connected) {
+            break;
+        }
+    }
+    if (error == SCUNIT_ERROR_NONE) {
+        error = scunit_flaky_save();
+    }
+    if (connected) {
+        connected = sendOutput(client);
+    }
+    dup2(savedStdout, STDOUT_FILENO);
+    dup2(savedStderr, STDERR_FILENO);
+    close(savedStdout);
+    close(savedStderr);
+    scunit_setFilter(previousFilter);
+    SCUNIT_FREE(previousFilter);
+    if (!connected) {
+        return;
+    }
+    if (error != SCUNIT_ERROR_NONE) {
+        sendError(client, "Executing the module %s failed (code %d)", path, error);
+        return;
+    }
+    int64_t result[5] = {
+        summary.passedTests,
+        summary.skippedTests,
+        summary.failedTests,
+        summary.flakyTests,
+        summary.quarantinedTests
+    };
+    sendMessage(client, MESSAGE_RESULT, result, sizeof(result));
+}
+
+/**
+ * @brief Creates a Unix domain socket bound to a given path.
+ *
+ * @note A stale socket left behind by a terminated worker is replaced, while a socket of a worker
+ * that is still running is left untouched.
+ *
+ * @param[in] path      A null-terminated string for the path of the socket.
+ * @param[in] listening Whether to listen on (`true`) or connect to (`false`) the path.
+ * @return The created socket or a negative value if creating it failed.
+ */
+static int openSocket(const char* path, bool listening) {
+    struct sockaddr_un address = { .sun_family = AF_UNIX };
+    if (strlen(path) >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(address.sun_path, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr*) &address, sizeof(address)) == 0) {
+        if (listening) {
+            close(fd);
+            errno = EADDRINUSE;
+            return -1;
+        }
+        return fd;
+    }
+    if (!listening) {
+        close(fd);
+        return -1;
+    }
+    if (errno == ECONNREFUSED) {
+        unlink(path);
+    }
+    // The previous `connect()` failed, which leaves the state of the socket unspecified, so a new
+    // one is created for listening.
+    close(fd);
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ((fd < 0) || (bind(fd, (struct sockaddr*) &address, sizeof(address)) < 0)
+            || (listen(fd, SOMAXCONN) < 0)) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Serves clients connecting to a given socket until one of them requests a shutdown.
+ *
+ * @note Clients are served one after another, since the tests of all jobs are executed in the
+ * same process. Multiple workers can be started on separate sockets to execute jobs in parallel.
+ *
+ * @param[in] path A null-terminated string for the path of the socket.
+ * @return `EXIT_SUCCESS` after a shutdown was requested, otherwise `EXIT_FAILURE`.
+ */
+static int serve(const char* path) {
+    // Both `stdout` and `stderr` are captured in the same file, so `stdout` must not be buffered to
+    // preserve the order of the output.
+    setvbuf(stdout, nullptr, _IONBF, 0);
+    FILE* capture = tmpfile();
+    if (capture == nullptr) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while creating the capture file (code %d).\n",
+            SCUNIT_ERROR_OPENING_STREAM_FAILED
+        );
+        return EXIT_FAILURE;
+    }
+    captureFd = fileno(capture);
+    int server = openSocket(path, true);
+    if (server < 0) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "Listening on the socket %s failed: %s\n",
+            path,
+            strerror(errno)
+        );
+        fclose(capture);
+        return EXIT_FAILURE;
+    }
+    scunit_printf("Listening on %s.\n", path);
+    fflush(stdout);
+    bool running = true;
+    while (running) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        SCUnitMessageHeader header;
+        char* payload;
+        while (running && receiveMessage(client, MAX_REQUEST_LENGTH, &header, &payload)) {
+            if (header.type == MESSAGE_SHUTDOWN) {
+                running = false;
+            }
+            else if (header.type == MESSAGE_JOB) {
+                // The payload is terminated by `receiveMessage()`, so the filter is either the
+                // second string or an empty one if it is missing.
+                size_t pathLength = strlen(payload);
+                const char* filter = (pathLength < header.length) ? payload + pathLength + 1 : "";
+                executeJob(client, payload, (*filter != '\0') ? filter : "*");
+            }
+            else {
+                sendError(client, "Unknown message type %" PRIu32, header.type);
+            }
+            SCUNIT_FREE(payload);
+        }
+        close(client);
+    }
+    close(server);
+    unlink(path);
+    for (int64_t i = cachedModules - 1; i >= 0; i--) {
+        scunit_module_unload(modules[i].module);
+    }
+    SCUNIT_FREE(modules);
+    fclose(capture);
+    return running ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * @brief Sends a job for every given module to a worker and prints the output and results.
+ *
+ * @param[in] path        A null-terminated string for the path of the socket of the worker.
+ * @param[in] modulePaths Paths of the modules to execute.
+ * @param[in] moduleCount Number of modules to execute.
+ * @param[in] filter      A null-terminated string for the filter selecting the tests.
+ * @param[in] shutdown    Whether to request the worker to shut down afterwards.
+ * @return `EXIT_FAILURE` if at least one test failed or a job could not be executed,
+ * otherwise `EXIT_SUCCESS`.
+ */
+static int connectTo(
+    const char* path,
+    char** modulePaths,
+    int moduleCount,
+    const char* filter,
+    bool shutdown
+) {
+    int worker = openSocket(path, false);
+    if (worker < 0) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "Connecting to the worker %s failed: %s\n",
+            path,
+            strerror(errno)
+        );
+        return EXIT_FAILURE;
+    }
+    int exitCode = EXIT_SUCCESS;
+    SCUnitSummary summary = { };
+    for (int i = 0; i < moduleCount; i++) {
+        // The worker may have been started in a different working directory, so modules are
+        // always identified by their absolute paths.
+        char modulePath[PATH_MAX];
+        if (realpath(modulePaths[i], modulePath) == nullptr) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "The module %s could not be found: %s\n",
+                modulePaths[i],
+                strerror(errno)
+            );
+            exitCode = EXIT_FAILURE;
+            continue;
+        }
+        size_t pathLength = strlen(modulePath);
+        size_t filterLength = strlen(filter);
+        char* request = SCUNIT_MALLOC(pathLength + 1 + filterLength + 1);
+        if (request == nullptr) {
+            scunit_fprintfc(
+                stderr,
+                SCUNIT_COLOR_DARK_RED,
+                SCUNIT_COLOR_DARK_DEFAULT,
+                "An unexpected error occurred while sending a job (code %d).\n",
+                SCUNIT_ERROR_OUT_OF_MEMORY
+            );
+            close(worker);
+            return EXIT_FAILURE;
+        }
+        memcpy(request, modulePath, pathLength + 1);
+        memcpy(request + pathLength + 1, filter, filterLength + 1);
+        bool sent = sendMessage(worker, MESSAGE_JOB, request, pathLength + 1 + filterLength + 1);
+        SCUNIT_FREE(request);
+        if (!sent) {
+            goto disconnected;
+        }
+        bool finished = false;
+        while (!finished) {
+            SCUnitMessageHeader header;
+            char* payload;
+            if (!receiveMessage(worker, UINT32_MAX - 1, &header, &payload)) {
+                goto disconnected;
+            }
+            if (header.type == MESSAGE_OUTPUT) {
+                fwrite(payload, 1, header.length, stdout);
+            }
+            else if ((header.type == MESSAGE_RESULT) && (header.length == 5 * sizeof(int64_t))) {
+                int64_t result[5];
+                memcpy(result, payload, sizeof(result));
+                summary.passedTests += result[0];
+                summary.skippedTests += result[1];
+                summary.failedTests += result[2];
+                summary.flakyTests += result[3];
+                summary.quarantinedTests += result[4];
+                finished = true;
+            }
+            else {
+                scunit_fprintfc(
+                    stderr,
+                    SCUNIT_COLOR_DARK_RED,
+                    SCUNIT_COLOR_DARK_DEFAULT,
+                    "%s.\n",
+                    (header.type == MESSAGE_ERROR) ? payload : "Received an unexpected message"
+                );
+                exitCode = EXIT_FAILURE;
+                finished = true;
+            }
+            SCUNIT_FREE(payload);
+        }
+    }
+    if (shutdown) {
+        sendMessage(worker, MESSAGE_SHUTDOWN, nullptr, 0);
+    }
+    close(worker);
+    int64_t totalTests = summary.passedTests + summary.skippedTests + summary.failedTests
+        + summary.flakyTests + summary.quarantinedTests;
+    scunit_printf("--- ");
+    scunit_printfc(SCUNIT_COLOR_DARK_CYAN, SCUNIT_COLOR_DARK_DEFAULT, "Summary");
+    scunit_printf(" ---\n\nTests: ");
+    printCount(summary.passedTests, totalTests, SCUNIT_COLOR_DARK_GREEN, "Passed");
+    scunit_printf(", ");
+    printCount(summary.skippedTests, totalTests, SCUNIT_COLOR_DARK_YELLOW, "Skipped");
+    scunit_printf(", ");
+    printCount(summary.failedTests, totalTests, SCUNIT_COLOR_DARK_RED, "Failed");
+    if (summary.flakyTests > 0) {
+        scunit_printf(", ");
+        printCount(summary.flakyTests, totalTests, SCUNIT_COLOR_DARK_MAGENTA, "Flaky");
+    }
+    if (summary.quarantinedTests > 0) {
+        scunit_printf(", ");
+        printCount(summary.quarantinedTests, totalTests, SCUNIT_COLOR_DARK_BLUE, "Quarantined");
+    }
+    scunit_printf(", %" PRId64 " Total\n", totalTests);
+    return (summary.failedTests > 0) ? EXIT_FAILURE : exitCode;
+disconnected:
+    fflush(stdout);
+    scunit_fprintfc(
+        stderr,
+        SCUNIT_COLOR_DARK_RED,
+        SCUNIT_COLOR_DARK_DEFAULT,
+        "The connection to the worker %s was lost (e. g. because a test crashed it).\n",
+        path
+    );
+    close(worker);
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char** argv) {
+    // Options not handled here are forwarded to `scunit_parseArguments()` in worker mode (e. g.
+    // '--order=random'). All other arguments name modules to execute in client mode.
+    char** options = SCUNIT_MALLOC(argc * sizeof(char*));
+    char** paths = SCUNIT_MALLOC(argc * sizeof(char*));
+    if ((options == nullptr) || (paths == nullptr)) {
+        scunit_fprintfc(
+            stderr,
+            SCUNIT_COLOR_DARK_RED,
+            SCUNIT_COLOR_DARK_DEFAULT,
+            "An unexpected error occurred while parsing the command line arguments (code %d).\n",
+            SCUNIT_ERROR_OUT_OF_MEMORY
+        );
+        return EXIT_FAILURE;
+    }
+    int optionCount = 0;
+    int pathCount = 0;
+    const char* listenPath = nullptr;
+    const char* connectPath = nullptr;
+    const char* filter = "*";
+    bool shutdown = false;
+    options[optionCount++] = argv[0];
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--listen=", strlen("--listen=")) == 0) {
+            listenPath = argv[i] + strlen("--listen=");
+        }
+        else if (strncmp(argv[i], "--connect=", strlen("--connect=")) == 0) {
+            connectPath = argv[i] + strlen("--connect=");
+        }
+        else if (strncmp(argv[i], "--filter=", strlen("--filter=")) == 0) {
+            // In worker mode, the filter is only a default, since every job sends its own one.
+            filter = argv[i] + strlen("--filter=");
+            options[optionCount++] = argv[i];
+        }
+        else if (strcmp(argv[i], "--shutdown") == 0) {
+            shutdown = true;
+        }
+        else if ((strcmp(argv[i], "-h") == 0) || (strcmp(argv[i], "--help") == 0)) {
+            scunit_printf(
+                "Usage: %s --listen=<socket> [OPTION]...\n"
+                "  or:  %s --connect=<socket> [--filter=<suite>[.<test>]] [--shutdown] "
+                "[MODULE]...\n"
+                "\n"
+                "Worker options:\n"
+                "  --listen=<socket>            Execute jobs sent to the given Unix domain socket, "
+                "keeping modules\n"
+                "                               loaded between jobs.\n"
+                "  --connect=<socket>           Send a job for every module to the worker "
+                "listening on the given\n"
+                "                               socket.\n"
+                "  --shutdown                   Request the worker to shut down after all jobs "
+                "are finished.\n"
+                "\n",
+                argv[0],
+                argv[0]
+            );
+            options[optionCount++] = argv[i];
+        }
+        else if ((argv[i][0] == '-') && (argv[i][1] != '\0')) {
+            options[optionCount++] = argv[i];
+        }
+        else {
+            paths[pathCount++] = argv[i];
+        }
+    }
+    scunit_parseArguments(optionCount, options);
+    int exitCode;
+    if ((listenPath != nullptr) && (connectPath == nullptr) && (pathCount == 0)) {
+        exitCode = serve(listenPath);
+    }
+    else if ((connectPath != nullptr) && (listenPath == nullptr)
+            && ((pathCount > 0) || shutdown)) {
+        exitCode = connectTo(connectPath, paths, pathCount, filter, shutdown);
+    }
+    else {
+        scunit_fprintf(
+            stderr,
+            "Usage: %s --listen=<socket> [OPTION]...\n"
+            "  or:  %s --connect=<socket> [--filter=<suite>[.<test>]] [--shutdown] [MODULE]...\n"
+            "Try option '-h' or '--help' for more information.\n",
+            argv[0],
+            argv[0]
+        );
+        exitCode = EXIT_FAILURE;
+    }
+    SCUNIT_FREE(paths);
+    SCUNIT_FREE(options);
+    return exitCode;
+}
\ No newline at end of file